@@ -68,6 +68,16 @@ print('[DllImportAttribute("openvr_api", EntryPoint = "VR_IsInterfaceVersionVali
 print('internal static extern bool IsInterfaceVersionValid([In, MarshalAs(UnmanagedType.LPStr)] string pchInterfaceVersion);')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_GetInitToken", CallingConvention = CallingConvention.Cdecl)]')
 print('internal static extern uint GetInitToken();')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_SetClientModuleResident", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern void SetClientModuleResident(bool bResident);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_GetLastInitTimings", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern bool GetLastInitTimings(ref VRInitTimings_t pTimings, uint unTimingsSize);')
+print('[UnmanagedFunctionPointer(CallingConvention.Cdecl)]')
+print('internal delegate void _VRAsyncInitCallback(EVRInitError eError, uint unToken, IntPtr pContext);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_InitInternalAsync", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern bool InitInternalAsync(EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo, _VRAsyncInitCallback pfnCallback, IntPtr pContext);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_PollAsyncInit", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern bool PollAsyncInit(ref EVRInitError peError, ref uint punToken);')
 print("}\n\n");
 
 api_shared.outputenums('vr', data)
@@ -187,6 +197,28 @@ print("""
 	{
 		return OpenVRInterop.GetInitToken();
 	}
+
+	public static void SetClientModuleResident(bool bResident)
+	{
+		OpenVRInterop.SetClientModuleResident(bResident);
+	}
+
+	// Completion is reported through PollAsyncInit. The native callback isn't exposed because
+	// the delegate would have to be kept alive until the loader thread calls it.
+	public static bool InitInternalAsync(EVRApplicationType eApplicationType, string pchStartupInfo)
+	{
+		return OpenVRInterop.InitInternalAsync(eApplicationType, pchStartupInfo, null, IntPtr.Zero);
+	}
+
+	public static bool PollAsyncInit(ref EVRInitError peError, ref uint punToken)
+	{
+		return OpenVRInterop.PollAsyncInit(ref peError, ref punToken);
+	}
+
+	public static bool GetLastInitTimings(ref VRInitTimings_t pTimings)
+	{
+		return OpenVRInterop.GetLastInitTimings(ref pTimings, (uint)Marshal.SizeOf(typeof(VRInitTimings_t)));
+	}
 """)
 
 ########
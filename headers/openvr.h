@@ -5480,6 +5480,59 @@ namespace vr
 	/** Returns a token that represents whether the VR interface handles need to be reloaded */
 	VR_INTERFACE uint32_t VR_CALLTYPE VR_GetInitToken();
 
+	/** Keeps vrclient loaded after VR_Shutdown and VR_IsHmdPresent so that a later VR_Init or VR_IsHmdPresent 
+	* can skip finding and loading the runtime again. The resident module is not reloaded if the runtime is 
+	* moved while it is resident. Passing false unloads the module if nothing is using it. This function may be
+	* called outside of VR_Init()/VR_Shutdown(). */
+	VR_INTERFACE void VR_CALLTYPE VR_SetClientModuleResident( bool bResident );
+
+#pragma pack( push, 8 )
+
+	/** Time spent in each phase of the most recent VR_Init call, in microseconds. The load phases are zero
+	* if vrclient was already resident (see VR_SetClientModuleResident). */
+	struct VRInitTimings_t
+	{
+		EVRInitError eError;
+		bool bClientModuleWasResident;
+		uint64_t ulPathRegistryMicroseconds;	// reading the path registry
+		uint64_t ulRuntimePathCheckMicroseconds; // checking the runtime directories exist
+		uint64_t ulModuleLoadMicroseconds;		// loading vrclient
+		uint64_t ulFactoryMicroseconds;			// finding and calling VRClientCoreFactory
+		uint64_t ulClientInitMicroseconds;		// initializing vrclient
+		uint64_t ulTotalMicroseconds;
+	};
+
+#pragma pack( pop )
+
+	/** Returns the timings of the most recent VR_Init call. Returns false if VR_Init has not been called or if
+	* unTimingsSize is not sizeof( VRInitTimings_t ). If the VR_INIT_TIMINGS_PATH environment variable is set
+	* the timings are also written to that file as JSON at the end of each VR_Init. This function may be called
+	* outside of VR_Init()/VR_Shutdown(). */
+	VR_INTERFACE bool VR_CALLTYPE VR_GetLastInitTimings( VRInitTimings_t *pTimings, uint32_t unTimingsSize );
+
+	/** Called on the loader thread when an init started with VR_InitInternalAsync completes. unToken is zero if
+	* the init failed. VR_InitInternal2 and VR_ShutdownInternal wait for the callback to return before they run,
+	* so the token stays valid for the whole call. The callback may call them itself. */
+	typedef void ( VR_CALLTYPE *VRAsyncInitCallback_t )( EVRInitError eError, uint32_t unToken, void *pContext );
+
+	/** Starts the equivalent of VR_InitInternal2 on a background thread and returns immediately. Completion is
+	* reported through pfnCallback (which may be NULL) and VR_PollAsyncInit. Returns false if an asynchronous init
+	* is already in flight, if VR_InitInternal2 or VR_ShutdownInternal is running, if called from pfnCallback,
+	* or if the thread could not be started.
+	*
+	* While the init is in flight, and no earlier init is still live, VR_GetGenericInterface fails with
+	* VRInitError_Init_NotInitialized and VR_IsInterfaceVersionValid returns false, both without blocking.
+	* VR_InitInternal2 and VR_ShutdownInternal wait for the init and its callback to finish before they run.
+	* Other functions block until the loader thread is done with
+	* the runtime. Interface accessors such as VRSystem() pick up the new init token on their own once the
+	* init succeeds. */
+	VR_INTERFACE bool VR_CALLTYPE VR_InitInternalAsync( EVRApplicationType eApplicationType, const char *pStartupInfo, VRAsyncInitCallback_t pfnCallback, void *pContext );
+
+	/** Returns true once the most recent VR_InitInternalAsync has finished and fills in its error and init token.
+	* Returns false while it is still in flight, if no asynchronous init has been started, or if VR_InitInternal2
+	* or VR_ShutdownInternal has been called since it finished. */
+	VR_INTERFACE bool VR_CALLTYPE VR_PollAsyncInit( EVRInitError *peError, uint32_t *punToken );
+
 	// These typedefs allow old enum names from SDK 0.9.11 to be used in applications.
 	// They will go away in the future.
 	typedef EVRInitError HmdError;
@@ -4585,6 +4585,16 @@ public class OpenVRInterop
 	internal static extern bool IsInterfaceVersionValid([In, MarshalAs(UnmanagedType.LPStr)] string pchInterfaceVersion);
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_GetInitToken", CallingConvention = CallingConvention.Cdecl)]
 	internal static extern uint GetInitToken();
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_SetClientModuleResident", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern void SetClientModuleResident(bool bResident);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_GetLastInitTimings", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern bool GetLastInitTimings(ref VRInitTimings_t pTimings, uint unTimingsSize);
+	[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+	internal delegate void _VRAsyncInitCallback(EVRInitError eError, uint unToken, IntPtr pContext);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_InitInternalAsync", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern bool InitInternalAsync(EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo, _VRAsyncInitCallback pfnCallback, IntPtr pContext);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_PollAsyncInit", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern bool PollAsyncInit(ref EVRInitError peError, ref uint punToken);
 }
 
 
@@ -7638,6 +7648,18 @@ public enum EBlockQueueCreationFlag
 	public ETrackedPropertyError eError;
 	public IntPtr pszPath; // const char *
 }
+[StructLayout(LayoutKind.Sequential)] public struct VRInitTimings_t
+{
+	public EVRInitError eError;
+	[MarshalAs(UnmanagedType.I1)]
+	public bool bClientModuleWasResident;
+	public ulong ulPathRegistryMicroseconds;
+	public ulong ulRuntimePathCheckMicroseconds;
+	public ulong ulModuleLoadMicroseconds;
+	public ulong ulFactoryMicroseconds;
+	public ulong ulClientInitMicroseconds;
+	public ulong ulTotalMicroseconds;
+}
 
 public class OpenVR
 {
@@ -7707,6 +7729,28 @@ public class OpenVR
 		return OpenVRInterop.GetInitToken();
 	}
 
+	public static void SetClientModuleResident(bool bResident)
+	{
+		OpenVRInterop.SetClientModuleResident(bResident);
+	}
+
+	// Completion is reported through PollAsyncInit. The native callback isn't exposed because
+	// the delegate would have to be kept alive until the loader thread calls it.
+	public static bool InitInternalAsync(EVRApplicationType eApplicationType, string pchStartupInfo)
+	{
+		return OpenVRInterop.InitInternalAsync(eApplicationType, pchStartupInfo, null, IntPtr.Zero);
+	}
+
+	public static bool PollAsyncInit(ref EVRInitError peError, ref uint punToken)
+	{
+		return OpenVRInterop.PollAsyncInit(ref peError, ref punToken);
+	}
+
+	public static bool GetLastInitTimings(ref VRInitTimings_t pTimings)
+	{
+		return OpenVRInterop.GetLastInitTimings(ref pTimings, (uint)Marshal.SizeOf(typeof(VRInitTimings_t)));
+	}
+
 	public const uint k_nDriverNone = 4294967295;
 	public const uint k_unMaxDriverDebugResponseSize = 32768;
 	public const uint k_unTrackedDeviceIndex_Hmd = 0;
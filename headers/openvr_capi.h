@@ -2718,6 +2718,18 @@ typedef struct PathRead_t
 	char * pszPath; // const char *
 } PathRead_t;
 
+typedef struct VRInitTimings_t
+{
+	enum EVRInitError eError;
+	bool bClientModuleWasResident;
+	uint64_t ulPathRegistryMicroseconds;
+	uint64_t ulRuntimePathCheckMicroseconds;
+	uint64_t ulModuleLoadMicroseconds;
+	uint64_t ulFactoryMicroseconds;
+	uint64_t ulClientInitMicroseconds;
+	uint64_t ulTotalMicroseconds;
+} VRInitTimings_t;
+
 
 typedef union
 {
@@ -3267,6 +3279,11 @@ S_API intptr_t VR_GetGenericInterface( const char *pchInterfaceVersion, EVRInitE
 S_API bool VR_IsRuntimeInstalled();
 S_API const char * VR_GetVRInitErrorAsSymbol( EVRInitError error );
 S_API const char * VR_GetVRInitErrorAsEnglishDescription( EVRInitError error );
+S_API void VR_SetClientModuleResident( bool bResident );
+S_API bool VR_GetLastInitTimings( VRInitTimings_t *pTimings, uint32_t unTimingsSize );
+typedef void (*VRAsyncInitCallback_t)( EVRInitError eError, uint32_t unToken, void *pContext );
+S_API bool VR_InitInternalAsync( EVRApplicationType eApplicationType, const char *pStartupInfo, VRAsyncInitCallback_t pfnCallback, void *pContext );
+S_API bool VR_PollAsyncInit( EVRInitError *peError, uint32_t *punToken );
 #endif
 
 #endif // __OPENVR_API_FLAT_H__
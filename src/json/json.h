@@ -1492,6 +1492,38 @@ private:
   bool collectComments_;
 };  // Reader
 
+/** \brief Receives the values of a document from CharReader::parseEvents()
+ * as they are read, without a Value tree being built.
+ *
+ * Every callback returns \c true to keep parsing or \c false to stop the
+ * parse right there, e.g. once the wanted keys have been seen. The default
+ * implementations ignore the event.
+ *
+ * Events arrive in document order. An object produces onObjectBegin(), then
+ * onKey() followed by the member's value for every member, then
+ * onObjectEnd(). Duplicate keys are reported as they appear. Numbers are
+ * reported with the type the DOM reader would give them: onInt() for
+ * integers that fit in a LargestInt, onUInt() for larger unsigned integers
+ * and onReal() for everything else.
+ */
+class JSON_API SaxHandler {
+public:
+  virtual ~SaxHandler() {}
+  virtual bool onObjectBegin() { return true; }
+  virtual bool onObjectEnd() { return true; }
+  virtual bool onArrayBegin() { return true; }
+  virtual bool onArrayEnd() { return true; }
+  /// \param key The decoded member name. Only valid during the call.
+  virtual bool onKey(const std::string& key) { (void)key; return true; }
+  /// \param value The decoded string. Only valid during the call.
+  virtual bool onString(const std::string& value) { (void)value; return true; }
+  virtual bool onInt(Value::LargestInt value) { (void)value; return true; }
+  virtual bool onUInt(Value::LargestUInt value) { (void)value; return true; }
+  virtual bool onReal(double value) { (void)value; return true; }
+  virtual bool onBool(bool value) { (void)value; return true; }
+  virtual bool onNull() { return true; }
+};  // SaxHandler
+
 /** Interface for reading JSON from a char array.
  */
 class JSON_API CharReader {
@@ -1518,6 +1550,48 @@ public:
       char const* beginDoc, char const* endDoc,
       Value* root, std::string* errs) = 0;
 
+  /** \brief Supplies a document to parseEvents() one chunk at a time.
+   */
+  class JSON_API ChunkSource {
+  public:
+    virtual ~ChunkSource() {}
+    /** \brief Copy the next bytes of the document into \c buffer.
+     * \return The number of bytes copied, at most \c size. 0 marks the end
+     * of the document.
+     */
+    virtual size_t read(char* buffer, size_t size) = 0;
+  };  // ChunkSource
+
+  /** \brief Read a <a HREF="http://www.json.org">JSON</a> document and
+   * report its values to \c handler instead of building a Value.
+   *
+   * Uses the same tokenizer and settings as parse(), but stops at the first
+   * error instead of trying to recover, and "collectComments" is ignored.
+   *
+   * \param beginDoc Pointer on the beginning of the UTF-8 encoded string of
+   *        the document to read.
+   * \param endDoc Pointer on the end of the UTF-8 encoded string of the
+   *        document to read. Must be >= beginDoc.
+   * \param handler Receives the values of the document.
+   * \param errs [out] Formatted error messages (if not NULL)
+   * \return \c false if the document has an error before the point where
+   *         parsing ended, \c true otherwise. A handler stopping the parse
+   *         early is not an error.
+   */
+  virtual bool parseEvents(
+      char const* beginDoc, char const* endDoc,
+      SaxHandler& handler, std::string* errs);
+
+  /** \brief Same as above, but pulls the document from \c source.
+   *
+   * Only the part of the document that the tokenizer still needs is kept
+   * in memory, so large documents can be read without loading them
+   * whole.
+   */
+  virtual bool parseEvents(
+      ChunkSource& source,
+      SaxHandler& handler, std::string* errs);
+
   class JSON_API Factory {
   public:
     virtual ~Factory() {}
@@ -1619,6 +1693,14 @@ bool JSON_API parseFromStream(
     std::istream&,
     Value* root, std::string* errs);
 
+/** Read the stream in chunks and report its values to 'handler'.
+  * \sa CharReader::parseEvents()
+  */
+bool JSON_API parseEventsFromStream(
+    CharReader::Factory const&,
+    std::istream&,
+    SaxHandler& handler, std::string* errs);
+
 /** \brief Read from 'sin' into 'root'.
 
  Always keep comments from the input JSON.
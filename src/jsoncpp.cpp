@@ -1132,6 +1132,10 @@ public:
              const char* endDoc,
              Value& root,
              bool collectComments = true);
+  bool parseEvents(const char* beginDoc,
+                   const char* endDoc,
+                   SaxHandler& handler);
+  bool parseEvents(CharReader::ChunkSource& source, SaxHandler& handler);
   std::string getFormattedErrorMessages() const;
   std::vector<StructuredError> getStructuredErrors() const;
   bool pushError(const Value& value, const std::string& message);
@@ -1218,6 +1222,17 @@ private:
   void addComment(Location begin, Location end, CommentPlacement placement);
   void skipCommentTokens(Token& token);
 
+  // Event (SAX) parsing. These mirror readValue(), readObject() and
+  // readArray(), but report to handler_ and stop at the first error.
+  bool readEvents();
+  bool readValueEvents(Token& token);
+  bool readObjectEvents();
+  bool readArrayEvents();
+  bool decodeNumberEvents(Token& token);
+  void readTokenEvents(Token& token, Token* keepToken = 0);
+  void skipCommentTokensEvents(Token& token);
+  bool fillBuffer(Location keep);
+
   typedef std::stack<Value*> Nodes;
   Nodes nodes_;
   Errors errors_;
@@ -1230,6 +1245,16 @@ private:
   std::string commentsBefore_;
   int stackDepth_;
 
+  SaxHandler* handler_;
+  CharReader::ChunkSource* source_;
+  std::string decoded_;
+  // Lines, and columns on the first buffered line, that fillBuffer() has
+  // dropped from the front of document_, for error locations. If the last
+  // dropped char was a '\r', a '\n' at the front is part of the same break.
+  int discardedLines_;
+  int discardedColumns_;
+  bool discardedCarriageReturn_;
+
   OurFeatures const features_;
   bool collectComments_;
 };  // OurReader
@@ -1240,6 +1265,8 @@ OurReader::OurReader(OurFeatures const& features)
     : errors_(), document_(), begin_(), end_(), current_(), lastValueEnd_(),
       lastValue_(), commentsBefore_(),
       stackDepth_(0),
+      handler_(), source_(), decoded_(), discardedLines_(0),
+      discardedColumns_(0), discardedCarriageReturn_(false),
       features_(features), collectComments_() {
 }
 
@@ -1259,6 +1286,9 @@ bool OurReader::parse(const char* beginDoc,
   lastValue_ = 0;
   commentsBefore_ = "";
   errors_.clear();
+  discardedLines_ = 0;
+  discardedColumns_ = 0;
+  discardedCarriageReturn_ = false;
   while (!nodes_.empty())
     nodes_.pop();
   nodes_.push(&root);
@@ -1995,12 +2025,14 @@ void OurReader::getLocationLineAndColumn(Location location,
                                       int& line,
                                       int& column) const {
   Location current = begin_;
+  if (discardedCarriageReturn_ && current < location && *current == '\n')
+    ++current;
   Location lastLineStart = current;
-  line = 0;
+  line = discardedLines_;
   while (current < location && current != end_) {
     Char c = *current++;
     if (c == '\r') {
-      if (*current == '\n')
+      if (current != end_ && *current == '\n')
         ++current;
       lastLineStart = current;
       ++line;
@@ -2011,6 +2043,8 @@ void OurReader::getLocationLineAndColumn(Location location,
   }
   // column & line start at 1
   column = int(location - lastLineStart) + 1;
+  if (lastLineStart == begin_)
+    column += discardedColumns_;
   ++line;
 }
 
@@ -2093,6 +2127,294 @@ bool OurReader::good() const {
 }
 
 
+bool OurReader::parseEvents(const char* beginDoc,
+                            const char* endDoc,
+                            SaxHandler& handler) {
+  begin_ = beginDoc;
+  end_ = endDoc;
+  current_ = begin_;
+  handler_ = &handler;
+  source_ = 0;
+  return readEvents();
+}
+
+bool OurReader::parseEvents(CharReader::ChunkSource& source,
+                            SaxHandler& handler) {
+  document_.clear();
+  begin_ = document_.data();
+  end_ = begin_;
+  current_ = begin_;
+  handler_ = &handler;
+  source_ = &source;
+  return readEvents();
+}
+
+bool OurReader::readEvents() {
+  collectComments_ = false;
+  lastValueEnd_ = 0;
+  lastValue_ = 0;
+  commentsBefore_ = "";
+  errors_.clear();
+  discardedLines_ = 0;
+  discardedColumns_ = 0;
+  discardedCarriageReturn_ = false;
+  stackDepth_ = 0;
+
+  Token token;
+  skipCommentTokensEvents(token);
+  if (features_.strictRoot_ && token.type_ != tokenObjectBegin &&
+      token.type_ != tokenArrayBegin) {
+    // Same location as parse() reports.
+    token.type_ = tokenError;
+    token.start_ = begin_;
+    token.end_ = end_;
+    addError(
+        "A valid JSON document must be either an array or an object value.",
+        token);
+    return false;
+  }
+  // A handler stopping early leaves errors_ empty.
+  if (readValueEvents(token) && features_.failIfExtra_) {
+    skipCommentTokensEvents(token);
+    if (token.type_ != tokenError && token.type_ != tokenEndOfStream)
+      addError("Extra non-whitespace after JSON value.", token);
+  }
+  return good();
+}
+
+bool OurReader::readValueEvents(Token& token) {
+  if (stackDepth_ >= features_.stackLimit_) throwRuntimeError("Exceeded stackLimit in readValue().");
+  ++stackDepth_;
+  bool successful = true;
+
+  switch (token.type_) {
+  case tokenObjectBegin:
+    successful = readObjectEvents();
+    break;
+  case tokenArrayBegin:
+    successful = readArrayEvents();
+    break;
+  case tokenNumber:
+    successful = decodeNumberEvents(token);
+    break;
+  case tokenString:
+    decoded_.clear();
+    successful = decodeString(token, decoded_) && handler_->onString(decoded_);
+    break;
+  case tokenTrue:
+    successful = handler_->onBool(true);
+    break;
+  case tokenFalse:
+    successful = handler_->onBool(false);
+    break;
+  case tokenNull:
+    successful = handler_->onNull();
+    break;
+  case tokenNaN:
+    successful = handler_->onReal(std::numeric_limits<double>::quiet_NaN());
+    break;
+  case tokenPosInf:
+    successful = handler_->onReal(std::numeric_limits<double>::infinity());
+    break;
+  case tokenNegInf:
+    successful = handler_->onReal(-std::numeric_limits<double>::infinity());
+    break;
+  case tokenArraySeparator:
+  case tokenObjectEnd:
+  case tokenArrayEnd:
+    if (features_.allowDroppedNullPlaceholders_) {
+      // "Un-read" the current token and report a null.
+      current_--;
+      successful = handler_->onNull();
+      break;
+    } // else, fall through ...
+  default:
+    return addError("Syntax error: value, object or array expected.", token);
+  }
+
+  --stackDepth_;
+  return successful;
+}
+
+bool OurReader::readObjectEvents() {
+  if (!handler_->onObjectBegin())
+    return false;
+  Token tokenName;
+  std::string name;
+  std::set<std::string> names;
+  for (;;) {
+    readTokenEvents(tokenName);
+    while (tokenName.type_ == tokenComment)
+      readTokenEvents(tokenName);
+    if (tokenName.type_ == tokenObjectEnd && name.empty()) // empty object
+      return handler_->onObjectEnd();
+    name = "";
+    if (tokenName.type_ == tokenString) {
+      if (!decodeString(tokenName, name))
+        return false;
+    } else if (tokenName.type_ == tokenNumber && features_.allowNumericKeys_) {
+      Value numberName;
+      if (!decodeNumber(tokenName, numberName))
+        return false;
+      name = numberName.asString();
+    } else {
+      break;
+    }
+
+    // The name stays buffered in case it turns out to be a duplicate.
+    Token colon;
+    readTokenEvents(colon, &tokenName);
+    if (colon.type_ != tokenMemberSeparator)
+      return addError("Missing ':' after object member name", colon);
+    if (name.length() >= (1U<<30)) throwRuntimeError("keylength >= 2^30");
+    if (features_.rejectDupKeys_ && !names.insert(name).second) {
+      std::string msg = "Duplicate key: '" + name + "'";
+      return addError(msg, tokenName);
+    }
+    if (!handler_->onKey(name))
+      return false;
+    Token token;
+    skipCommentTokensEvents(token);
+    if (!readValueEvents(token))
+      return false;
+
+    Token comma;
+    readTokenEvents(comma);
+    while (comma.type_ == tokenComment)
+      readTokenEvents(comma);
+    if (comma.type_ == tokenObjectEnd)
+      return handler_->onObjectEnd();
+    if (comma.type_ != tokenArraySeparator)
+      return addError("Missing ',' or '}' in object declaration", comma);
+  }
+  return addError("Missing '}' or object member name", tokenName);
+}
+
+bool OurReader::readArrayEvents() {
+  if (!handler_->onArrayBegin())
+    return false;
+  skipSpaces();
+  while (current_ == end_ && fillBuffer(current_))
+    skipSpaces();
+  if (current_ != end_ && *current_ == ']') // empty array
+  {
+    Token endArray;
+    readTokenEvents(endArray);
+    return handler_->onArrayEnd();
+  }
+  for (;;) {
+    Token token;
+    skipCommentTokensEvents(token);
+    if (!readValueEvents(token))
+      return false;
+
+    // Accept Comment after last item in the array.
+    readTokenEvents(token);
+    while (token.type_ == tokenComment)
+      readTokenEvents(token);
+    if (token.type_ == tokenArrayEnd)
+      return handler_->onArrayEnd();
+    if (token.type_ != tokenArraySeparator)
+      return addError("Missing ',' or ']' in array declaration", token);
+  }
+}
+
+bool OurReader::decodeNumberEvents(Token& token) {
+  Value decoded;
+  if (!decodeNumber(token, decoded))
+    return false;
+  switch (decoded.type()) {
+  case intValue:
+    return handler_->onInt(decoded.asLargestInt());
+  case uintValue:
+    return handler_->onUInt(decoded.asLargestUInt());
+  default:
+    return handler_->onReal(decoded.asDouble());
+  }
+}
+
+// If keepToken is given, it stays buffered (and is moved along with the
+// buffer) so that an error can still be reported at it.
+void OurReader::readTokenEvents(Token& token, Token* keepToken) {
+  // Longer than any literal ("-Infinity"), so a token cut short by the end
+  // of the buffer always ends within this distance of it.
+  const ptrdiff_t lookahead = 16;
+  for (;;) {
+    readToken(token);
+    if (!source_ || end_ - token.end_ >= lookahead)
+      return;
+    // The token may continue in the next chunk; read it again with more
+    // of the document buffered.
+    current_ = token.start_;
+    bool more;
+    if (keepToken) {
+      ptrdiff_t keepStart = keepToken->start_ - current_;
+      ptrdiff_t keepEnd = keepToken->end_ - current_;
+      more = fillBuffer(keepToken->start_);
+      keepToken->start_ = current_ + keepStart;
+      keepToken->end_ = current_ + keepEnd;
+    } else {
+      more = fillBuffer(current_);
+    }
+    if (!more) {
+      readToken(token);
+      return;
+    }
+  }
+}
+
+void OurReader::skipCommentTokensEvents(Token& token) {
+  if (features_.allowComments_) {
+    do {
+      readTokenEvents(token);
+    } while (token.type_ == tokenComment);
+  } else {
+    readTokenEvents(token);
+  }
+}
+
+// Drops the buffered document before 'keep' and appends the next chunk from
+// source_. Returns false at the end of the document.
+bool OurReader::fillBuffer(Location keep) {
+  if (!source_)
+    return false;
+  const size_t chunkSize = 64 * 1024;
+
+  // Count line breaks the way getLocationLineAndColumn() does: "\r\n", a
+  // lone '\r' and a lone '\n' are one break each.
+  if (keep != begin_) {
+    Location current = begin_;
+    if (discardedCarriageReturn_ && *current == '\n')
+      ++current;
+    Location lineStart = current;
+    while (current < keep) {
+      Char c = *current++;
+      if (c == '\r' || c == '\n') {
+        if (c == '\r' && current < keep && *current == '\n')
+          ++current;
+        lineStart = current;
+        ++discardedLines_;
+        discardedColumns_ = 0;
+      }
+    }
+    discardedColumns_ += int(keep - lineStart);
+    discardedCarriageReturn_ = keep[-1] == '\r';
+  }
+
+  size_t offset = current_ - keep;
+  document_.erase(0, keep - begin_);
+  size_t size = document_.size();
+  document_.resize(size + chunkSize);
+  size_t read = source_->read(&document_[size], chunkSize);
+  document_.resize(size + read);
+  begin_ = document_.data();
+  end_ = begin_ + document_.size();
+  current_ = begin_ + offset;
+  if (!read)
+    source_ = 0;
+  return read != 0;
+}
+
 class OurCharReader : public CharReader {
   bool const collectComments_;
   OurReader reader_;
@@ -2112,8 +2434,39 @@ public:
     }
     return ok;
   }
+  bool parseEvents(
+      char const* beginDoc, char const* endDoc,
+      SaxHandler& handler, std::string* errs) {
+    bool ok = reader_.parseEvents(beginDoc, endDoc, handler);
+    if (errs) {
+      *errs = reader_.getFormattedErrorMessages();
+    }
+    return ok;
+  }
+  bool parseEvents(
+      ChunkSource& source,
+      SaxHandler& handler, std::string* errs) {
+    bool ok = reader_.parseEvents(source, handler);
+    if (errs) {
+      *errs = reader_.getFormattedErrorMessages();
+    }
+    return ok;
+  }
 };
 
+bool CharReader::parseEvents(
+    char const*, char const*, SaxHandler&, std::string* errs) {
+  if (errs)
+    *errs = "* Event parsing is not supported by this CharReader.\n";
+  return false;
+}
+
+bool CharReader::parseEvents(ChunkSource&, SaxHandler&, std::string* errs) {
+  if (errs)
+    *errs = "* Event parsing is not supported by this CharReader.\n";
+  return false;
+}
+
 CharReaderBuilder::CharReaderBuilder()
 {
   setDefaults(&settings_);
@@ -2219,6 +2572,30 @@ bool parseFromStream(
   return reader->parse(begin, end, root, errs);
 }
 
+namespace {
+class IStreamChunkSource : public CharReader::ChunkSource {
+public:
+  explicit IStreamChunkSource(std::istream& sin) : sin_(sin) {}
+  size_t read(char* buffer, size_t size) {
+    sin_.read(buffer, std::streamsize(size));
+    return size_t(sin_.gcount());
+  }
+private:
+  IStreamChunkSource(IStreamChunkSource const&);  // no impl
+  void operator=(IStreamChunkSource const&);  // no impl
+  std::istream& sin_;
+};
+} // namespace
+
+bool parseEventsFromStream(
+    CharReader::Factory const& fact, std::istream& sin,
+    SaxHandler& handler, std::string* errs)
+{
+  IStreamChunkSource source(sin);
+  CharReaderPtr const reader(fact.newCharReader());
+  return reader->parseEvents(source, handler, errs);
+}
+
 std::istream& operator>>(std::istream& sin, Value& root) {
   CharReaderBuilder b;
   std::string errs;
@@ -9,6 +9,13 @@
 #include <vrcore/strtools_public.h>
 #include <vrcore/vrpathregistry_public.h>
 #include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
 
 using vr::EVRInitError;
 using vr::IVRSystem;
@@ -36,13 +43,89 @@ namespace vr
 {
 
 static void *g_pVRModule = NULL;
+static IVRClientCore *g_pClientCore = NULL;
 static IVRClientCore *g_pHmdSystem = NULL;
 static std::recursive_mutex g_mutexSystem;
 
+// Number of callers currently using g_pClientCore. The module is unloaded when this drops
+// to zero unless it has been made resident with VR_SetClientModuleResident.
+static uint32_t g_unClientCoreRefCount = 0;
+static bool g_bClientModuleResident = false;
+
+// State for VR_InitInternalAsync. g_bAsyncInitInFlight and g_bHmdSystemLive are read without the
+// lock so interface lookups can fail fast instead of waiting on g_mutexSystem behind the loader
+// thread. They only do so when there is no earlier init still live to answer them.
+static std::mutex g_mutexAsyncInit;
+static std::condition_variable g_condAsyncInitDone;
+static std::atomic<bool> g_bAsyncInitInFlight( false );
+static std::atomic<bool> g_bHmdSystemLive( false );	// g_pHmdSystem has finished an init, written under g_mutexSystem
+static bool g_bAsyncInitComplete = false;
+static EVRInitError g_eAsyncInitError = VRInitError_None;
+static uint32_t g_unAsyncInitToken = 0;
+static uint32_t g_unSyncOperationsInProgress = 0;	// VR_InitInternalAsync refuses to start while nonzero
+
+// The loader thread is joined before a synchronous init or shutdown runs, so none of this library's
+// code is still running on it, callback included, once they return. g_mutexAsyncInitThread
+// serializes the joins. The loader thread itself never joins, since it may call back into us.
+// An application that exits without shutting down leaves the last loader thread unjoined, which
+// is left to the process exit rather than terminating it.
+struct VRAsyncInitThread_t
+{
+	std::thread thread;
+
+	~VRAsyncInitThread_t()
+	{
+		if ( thread.joinable() )
+			thread.detach();
+	}
+};
+
+static std::mutex g_mutexAsyncInitThread;
+static VRAsyncInitThread_t g_asyncInitThread;
+static thread_local bool t_bIsAsyncInitThread = false;
+
 
 typedef void* (*VRClientCoreFactoryFn)(const char *pInterfaceName, int *pReturnCode);
 
-static uint32_t g_nVRToken = 0;
+static std::atomic<uint32_t> g_nVRToken( 0 );
+
+// Interfaces the client core has already handed out for the current init. Readers search the
+// published cache without taking g_mutexSystem. A miss goes to the client core under the lock and
+// appends the result to the cache in place, so a cache only gets replaced when it is full or when
+// its token no longer matches g_nVRToken. A cache only answers lookups while its token matches.
+struct VRInterfaceCacheEntry_t
+{
+	std::string sInterfaceVersion;
+	std::atomic< void * > pInterface;
+	std::atomic< bool > bVersionValid;
+};
+
+struct VRInterfaceCache_t
+{
+	uint32_t unToken;
+	uint32_t unCapacity;
+	std::atomic< uint32_t > unCount;	// entries below this are published and their names don't change
+	std::unique_ptr< VRInterfaceCacheEntry_t[] > rgEntries;
+};
+
+static std::atomic< const VRInterfaceCache_t * > g_pInterfaceCache( nullptr );
+
+// Caches that have been replaced. A reader that loaded one may still be walking it, so each is
+// only freed once no reader's hazard slot points at it.
+static std::vector< std::unique_ptr< VRInterfaceCache_t > > g_vecRetiredInterfaceCaches;
+
+// One per thread that has looked up an interface, holding the cache that thread is walking.
+// Slots are never freed; a thread that exits hands its slot to the next new thread. Each slot is
+// padded out to its own cache lines so readers on different threads never write to a shared one.
+struct VRInterfaceCacheHazard_t
+{
+	std::atomic< const VRInterfaceCache_t * > pCache;
+	std::atomic< bool > bInUse;
+	VRInterfaceCacheHazard_t *pNext;
+	char rgchPadding[ 128 ];
+};
+
+static std::atomic< VRInterfaceCacheHazard_t * > g_pInterfaceCacheHazards( nullptr );
 
 uint32_t VR_GetInitToken()
 {
@@ -52,32 +135,509 @@ uint32_t VR_GetInitToken()
 EVRInitError VR_LoadHmdSystemInternal();
 void CleanupInternalInterfaces();
 
+static const char *k_pchInitTimingsPathVar = "VR_INIT_TIMINGS_PATH";
 
-uint32_t VR_InitInternal2( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
+// timings for the init in progress, filled in by VR_LoadHmdSystemInternal
+static VRInitTimings_t g_currentInitTimings;
+static VRInitTimings_t g_lastInitTimings;
+static bool g_bHaveLastInitTimings = false;
+
+typedef std::chrono::steady_clock VRInitClock_t;
+
+static uint64_t VR_MicrosecondsSince( VRInitClock_t::time_point start )
+{
+	return (uint64_t)std::chrono::duration_cast< std::chrono::microseconds >( VRInitClock_t::now() - start ).count();
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Writes the timings of the last init to the file named by 
+//			VR_INIT_TIMINGS_PATH, if it is set.
+// -------------------------------------------------------------------------------
+static void VR_WriteInitTimings( const VRInitTimings_t & timings )
+{
+	std::string sTimingsPath = GetEnvironmentVariable( k_pchInitTimingsPathVar );
+	if ( sTimingsPath.empty() )
+		return;
+
+	std::string sTimings = Format(
+		"{\n"
+		"\t\"error\": \"%s\",\n"
+		"\t\"client_module_was_resident\": %s,\n"
+		"\t\"path_registry_us\": %llu,\n"
+		"\t\"runtime_path_check_us\": %llu,\n"
+		"\t\"module_load_us\": %llu,\n"
+		"\t\"factory_us\": %llu,\n"
+		"\t\"client_init_us\": %llu,\n"
+		"\t\"total_us\": %llu\n"
+		"}\n",
+		GetIDForVRInitError( timings.eError ),
+		timings.bClientModuleWasResident ? "true" : "false",
+		(unsigned long long)timings.ulPathRegistryMicroseconds,
+		(unsigned long long)timings.ulRuntimePathCheckMicroseconds,
+		(unsigned long long)timings.ulModuleLoadMicroseconds,
+		(unsigned long long)timings.ulFactoryMicroseconds,
+		(unsigned long long)timings.ulClientInitMicroseconds,
+		(unsigned long long)timings.ulTotalMicroseconds );
+
+	Path_WriteStringToTextFile( sTimingsPath, sTimings.c_str() );
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Claims a hazard slot for the calling thread the first time it is
+//			called on that thread, and gives it back when the thread exits.
+// -------------------------------------------------------------------------------
+struct VRInterfaceCacheHazardOwner_t
+{
+	VRInterfaceCacheHazard_t *pHazard = nullptr;
+
+	~VRInterfaceCacheHazardOwner_t()
+	{
+		if ( pHazard )
+		{
+			pHazard->pCache.store( nullptr, std::memory_order_release );
+			pHazard->bInUse.store( false, std::memory_order_release );
+		}
+	}
+};
+
+static VRInterfaceCacheHazard_t *VR_GetInterfaceCacheHazard()
+{
+	static thread_local VRInterfaceCacheHazardOwner_t t_hazardOwner;
+	if ( t_hazardOwner.pHazard )
+		return t_hazardOwner.pHazard;
+
+	for ( VRInterfaceCacheHazard_t *pHazard = g_pInterfaceCacheHazards.load( std::memory_order_acquire ); pHazard; pHazard = pHazard->pNext )
+	{
+		bool bInUse = false;
+		if ( !pHazard->bInUse.load( std::memory_order_relaxed ) && pHazard->bInUse.compare_exchange_strong( bInUse, true ) )
+		{
+			t_hazardOwner.pHazard = pHazard;
+			return pHazard;
+		}
+	}
+
+	VRInterfaceCacheHazard_t *pHazard = new VRInterfaceCacheHazard_t;
+	pHazard->pCache.store( nullptr, std::memory_order_relaxed );
+	pHazard->bInUse.store( true, std::memory_order_relaxed );
+	pHazard->pNext = g_pInterfaceCacheHazards.load( std::memory_order_relaxed );
+	while ( !g_pInterfaceCacheHazards.compare_exchange_weak( pHazard->pNext, pHazard ) )
+	{
+	}
+	t_hazardOwner.pHazard = pHazard;
+	return pHazard;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Looks up an interface version in the cache for the current init. Returns
+//			false if it hasn't been cached. Safe to call without g_mutexSystem.
+// -------------------------------------------------------------------------------
+static bool VR_FindCachedInterface( const char *pchInterfaceVersion, void **ppInterface, bool *pbVersionValid )
+{
+	if ( !pchInterfaceVersion )
+		return false;
+
+	// Publish the cache in our hazard slot, then check it is still the current one. A cache
+	// replaced after that check is retired with our slot already pointing at it, so it isn't
+	// freed under us. Only this thread writes the slot, so no cache line is shared with other
+	// readers.
+	VRInterfaceCacheHazard_t *pHazard = VR_GetInterfaceCacheHazard();
+	const VRInterfaceCache_t *pCache = g_pInterfaceCache.load();
+	for ( ;; )
+	{
+		pHazard->pCache.store( pCache );
+		const VRInterfaceCache_t *pCurrentCache = g_pInterfaceCache.load();
+		if ( pCurrentCache == pCache )
+			break;
+		pCache = pCurrentCache;
+	}
+
+	bool bFound = false;
+	const uint32_t unToken = g_nVRToken.load( std::memory_order_acquire );
+	if ( pCache && pCache->unToken == unToken )
+	{
+		const uint32_t unCount = pCache->unCount.load( std::memory_order_acquire );
+		for ( uint32_t i = 0; i < unCount; ++i )
+		{
+			const VRInterfaceCacheEntry_t &entry = pCache->rgEntries[ i ];
+			if ( entry.sInterfaceVersion == pchInterfaceVersion )
+			{
+				*ppInterface = entry.pInterface.load( std::memory_order_acquire );
+				*pbVersionValid = entry.bVersionValid.load( std::memory_order_acquire );
+				bFound = true;
+				break;
+			}
+		}
+
+		// a shutdown that started while we were searching may already be cleaning up the client core
+		if ( bFound && g_nVRToken.load( std::memory_order_acquire ) != unToken )
+			bFound = false;
+	}
+
+	pHazard->pCache.store( nullptr, std::memory_order_release );
+	return bFound;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Frees the retired caches that no reader's hazard slot points at.
+//			Must be called with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static void VR_FreeRetiredInterfaceCaches()
+{
+	if ( g_vecRetiredInterfaceCaches.empty() )
+		return;
+
+	// A reader that publishes a retired cache after we read its slot will find that the
+	// cache was replaced and won't walk it.
+	std::vector< const VRInterfaceCache_t * > vecInUse;
+	for ( VRInterfaceCacheHazard_t *pHazard = g_pInterfaceCacheHazards.load(); pHazard; pHazard = pHazard->pNext )
+	{
+		const VRInterfaceCache_t *pCache = pHazard->pCache.load();
+		if ( pCache )
+			vecInUse.push_back( pCache );
+	}
+
+	for ( size_t i = 0; i < g_vecRetiredInterfaceCaches.size(); )
+	{
+		if ( std::find( vecInUse.begin(), vecInUse.end(), g_vecRetiredInterfaceCaches[ i ].get() ) == vecInUse.end() )
+		{
+			g_vecRetiredInterfaceCaches[ i ] = std::move( g_vecRetiredInterfaceCaches.back() );
+			g_vecRetiredInterfaceCaches.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Makes pCache the cache that readers see and retires the one it replaces.
+//			Must be called with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static void VR_PublishInterfaceCache( VRInterfaceCache_t *pCache )
+{
+	VRInterfaceCache_t *pOldCache = const_cast< VRInterfaceCache_t * >( g_pInterfaceCache.exchange( pCache ) );
+	if ( pOldCache )
+	{
+		g_vecRetiredInterfaceCaches.push_back( std::unique_ptr< VRInterfaceCache_t >( pOldCache ) );
+	}
+
+	VR_FreeRetiredInterfaceCaches();
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Allocates an empty cache for the specified token.
+// -------------------------------------------------------------------------------
+static VRInterfaceCache_t *VR_AllocInterfaceCache( uint32_t unToken, uint32_t unCapacity )
+{
+	VRInterfaceCache_t *pCache = new VRInterfaceCache_t;
+	pCache->unToken = unToken;
+	pCache->unCapacity = unCapacity;
+	pCache->unCount.store( 0, std::memory_order_relaxed );
+	pCache->rgEntries.reset( new VRInterfaceCacheEntry_t[ unCapacity ] );
+	return pCache;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Adds the specified result to the interface cache for the current init.
+//			Must be called with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static void VR_CacheInterface( const char *pchInterfaceVersion, void *pInterface, bool bVersionValid )
+{
+	const uint32_t unToken = g_nVRToken.load( std::memory_order_relaxed );
+	VRInterfaceCache_t *pCache = const_cast< VRInterfaceCache_t * >( g_pInterfaceCache.load( std::memory_order_relaxed ) );
+	if ( !pCache || pCache->unToken != unToken )
+	{
+		pCache = VR_AllocInterfaceCache( unToken, 16 );
+		VR_PublishInterfaceCache( pCache );
+	}
+
+	const uint32_t unCount = pCache->unCount.load( std::memory_order_relaxed );
+	for ( uint32_t i = 0; i < unCount; ++i )
+	{
+		VRInterfaceCacheEntry_t &entry = pCache->rgEntries[ i ];
+		if ( entry.sInterfaceVersion == pchInterfaceVersion )
+		{
+			if ( pInterface )
+				entry.pInterface.store( pInterface, std::memory_order_release );
+			if ( bVersionValid )
+				entry.bVersionValid.store( true, std::memory_order_release );
+			return;
+		}
+	}
+
+	// out of room; readers keep using the full cache until the bigger copy is published
+	if ( unCount == pCache->unCapacity )
+	{
+		VRInterfaceCache_t *pBiggerCache = VR_AllocInterfaceCache( unToken, pCache->unCapacity * 2 );
+		for ( uint32_t i = 0; i < unCount; ++i )
+		{
+			VRInterfaceCacheEntry_t &entry = pBiggerCache->rgEntries[ i ];
+			entry.sInterfaceVersion = pCache->rgEntries[ i ].sInterfaceVersion;
+			entry.pInterface.store( pCache->rgEntries[ i ].pInterface.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+			entry.bVersionValid.store( pCache->rgEntries[ i ].bVersionValid.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+		}
+		pBiggerCache->unCount.store( unCount, std::memory_order_relaxed );
+		VR_PublishInterfaceCache( pBiggerCache );
+		pCache = pBiggerCache;
+	}
+
+	// readers don't look at this entry until the count below includes it
+	VRInterfaceCacheEntry_t &entry = pCache->rgEntries[ unCount ];
+	entry.sInterfaceVersion = pchInterfaceVersion;
+	entry.pInterface.store( pInterface, std::memory_order_relaxed );
+	entry.bVersionValid.store( bVersionValid, std::memory_order_relaxed );
+	pCache->unCount.store( unCount + 1, std::memory_order_release );
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Unloads vrclient. Must be called with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static void VR_UnloadClientModule()
+{
+	g_pClientCore = NULL;
+
+	if ( g_pVRModule )
+	{
+		SharedLib_Unload( g_pVRModule );
+		g_pVRModule = NULL;
+	}
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Loads vrclient if it isn't already loaded and takes a reference on it.
+//			Must be called with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static EVRInitError VR_AcquireClientCore()
+{
+	if ( !g_pClientCore )
+	{
+		EVRInitError err = VR_LoadHmdSystemInternal();
+		if ( err != VRInitError_None )
+			return err;
+	}
+
+	++g_unClientCoreRefCount;
+	return VRInitError_None;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Releases a reference taken with VR_AcquireClientCore. Must be called 
+//			with g_mutexSystem held.
+// -------------------------------------------------------------------------------
+static void VR_ReleaseClientCore()
+{
+	if ( g_unClientCoreRefCount > 0 )
+		--g_unClientCoreRefCount;
+
+	if ( g_unClientCoreRefCount == 0 && !g_bClientModuleResident )
+	{
+		VR_UnloadClientModule();
+	}
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Joins the loader thread of the last VR_InitInternalAsync, if there is
+//			one and we aren't on it.
+// -------------------------------------------------------------------------------
+static void VR_JoinAsyncInitThread()
+{
+	if ( t_bIsAsyncInitThread )
+		return;
+
+	std::lock_guard<std::mutex> lock( g_mutexAsyncInitThread );
+	if ( g_asyncInitThread.thread.joinable() )
+		g_asyncInitThread.thread.join();
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Brackets a synchronous init or shutdown. Construction blocks until any
+//			init started with VR_InitInternalAsync has finished and its loader
+//			thread has exited, then forgets its result, which the operation
+//			makes stale. Until destruction VR_InitInternalAsync refuses to
+//			start, so no async init can begin between the wait and the
+//			operation, or run alongside it.
+// -------------------------------------------------------------------------------
+class CVRSynchronousOperation
+{
+public:
+	CVRSynchronousOperation()
+	{
+		{
+			std::unique_lock<std::mutex> lock( g_mutexAsyncInit );
+			g_condAsyncInitDone.wait( lock, [] { return !g_bAsyncInitInFlight.load(); } );
+			g_bAsyncInitComplete = false;
+			++g_unSyncOperationsInProgress;
+		}
+
+		VR_JoinAsyncInitThread();
+	}
+
+	~CVRSynchronousOperation()
+	{
+		std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+		--g_unSyncOperationsInProgress;
+	}
+};
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Shared implementation of VR_InitInternal2 and VR_InitInternalAsync
+// -------------------------------------------------------------------------------
+static uint32_t VR_InitInternalShared( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
 {
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
-	EVRInitError err = VR_LoadHmdSystemInternal();
+	VRInitClock_t::time_point initStart = VRInitClock_t::now();
+	memset( &g_currentInitTimings, 0, sizeof( g_currentInitTimings ) );
+	g_currentInitTimings.bClientModuleWasResident = g_pClientCore != NULL;
+
+	EVRInitError err = VRInitError_None;
+	if ( !g_pHmdSystem )
+	{
+		err = VR_AcquireClientCore();
+		if ( err == vr::VRInitError_None )
+		{
+			g_pHmdSystem = g_pClientCore;
+		}
+	}
+
 	if ( err == vr::VRInitError_None )
 	{
+		VRInitClock_t::time_point clientInitStart = VRInitClock_t::now();
 		err = g_pHmdSystem->Init( eApplicationType, pStartupInfo );
+		g_currentInitTimings.ulClientInitMicroseconds = VR_MicrosecondsSince( clientInitStart );
 	}
 
+	g_currentInitTimings.eError = err;
+	g_currentInitTimings.ulTotalMicroseconds = VR_MicrosecondsSince( initStart );
+	g_lastInitTimings = g_currentInitTimings;
+	g_bHaveLastInitTimings = true;
+	VR_WriteInitTimings( g_lastInitTimings );
+
 	if ( peError )
 		*peError = err;
 
 	if ( err != VRInitError_None )
 	{
-		SharedLib_Unload( g_pVRModule );
-		g_pHmdSystem = NULL;
-		g_pVRModule = NULL;
+		if ( g_pHmdSystem )
+		{
+			g_pHmdSystem = NULL;
+			g_bHmdSystemLive = false;
+			VR_ReleaseClientCore();
+		}
 
 		return 0;
 	}
 
+	g_bHmdSystemLive = true;
 	return ++g_nVRToken;
 }
 
+
+uint32_t VR_InitInternal2( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
+{
+	CVRSynchronousOperation syncOperation;
+
+	return VR_InitInternalShared( peError, eApplicationType, pStartupInfo );
+}
+
+
+bool VR_InitInternalAsync( EVRApplicationType eApplicationType, const char *pStartupInfo, VRAsyncInitCallback_t pfnCallback, void *pContext )
+{
+	// the loader thread can't join itself to make room for another
+	if ( t_bIsAsyncInitThread )
+		return false;
+
+	// Holding g_mutexAsyncInitThread keeps any other async init from starting until we're done
+	std::lock_guard<std::mutex> threadLock( g_mutexAsyncInitThread );
+	{
+		std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+		if ( g_bAsyncInitInFlight || g_unSyncOperationsInProgress != 0 )
+			return false;
+	}
+
+	// The previous loader thread may still be running its callback. It is joined before this
+	// init is marked in flight, since the callback may wait for that with a sync init or shutdown.
+	if ( g_asyncInitThread.thread.joinable() )
+		g_asyncInitThread.thread.join();
+
+	{
+		std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+		if ( g_unSyncOperationsInProgress != 0 )
+			return false;
+
+		g_bAsyncInitInFlight = true;
+		g_bAsyncInitComplete = false;
+	}
+
+	// the caller's startup info doesn't have to outlive this call
+	bool bHasStartupInfo = pStartupInfo != nullptr;
+	std::string sStartupInfo = bHasStartupInfo ? pStartupInfo : "";
+
+	try
+	{
+		g_asyncInitThread.thread = std::thread( [=]()
+		{
+			t_bIsAsyncInitThread = true;
+
+			EVRInitError eError = VRInitError_None;
+			uint32_t unToken = VR_InitInternalShared( &eError, eApplicationType, bHasStartupInfo ? sStartupInfo.c_str() : nullptr );
+
+			{
+				std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+				g_eAsyncInitError = eError;
+				g_unAsyncInitToken = unToken;
+				g_bAsyncInitComplete = true;
+				g_bAsyncInitInFlight = false;
+			}
+			g_condAsyncInitDone.notify_all();
+
+			// a shutdown or sync init that saw the init finish still joins this thread before it runs,
+			// so the token is live for the whole callback
+			if ( pfnCallback )
+			{
+				pfnCallback( eError, unToken, pContext );
+			}
+		} );
+	}
+	catch ( ... )
+	{
+		std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+		g_bAsyncInitInFlight = false;
+		return false;
+	}
+
+	return true;
+}
+
+
+bool VR_PollAsyncInit( EVRInitError *peError, uint32_t *punToken )
+{
+	std::lock_guard<std::mutex> lock( g_mutexAsyncInit );
+
+	if ( !g_bAsyncInitComplete )
+		return false;
+
+	if ( peError )
+		*peError = g_eAsyncInitError;
+	if ( punToken )
+		*punToken = g_unAsyncInitToken;
+	return true;
+}
+
 VR_INTERFACE uint32_t VR_CALLTYPE VR_InitInternal( EVRInitError *peError, EVRApplicationType eApplicationType );
 
 uint32_t VR_InitInternal( EVRInitError *peError, vr::EVRApplicationType eApplicationType )
@@ -87,8 +647,14 @@ uint32_t VR_InitInternal( EVRInitError *peError, vr::EVRApplicationType eApplica
 
 void VR_ShutdownInternal()
 {
+	CVRSynchronousOperation syncOperation;
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
+	// Stop the interface cache answering lookups before the client core is cleaned up or
+	// unloaded. Readers check the token again after reading from the cache.
+	g_nVRToken.fetch_add( 1, std::memory_order_acq_rel );
+
 #if !defined( VR_API_PUBLIC )
 	CleanupInternalInterfaces();
 #endif
@@ -97,27 +663,53 @@ void VR_ShutdownInternal()
 	{
 		g_pHmdSystem->Cleanup();
 		g_pHmdSystem = NULL;
+		g_bHmdSystemLive = false;
+		VR_ReleaseClientCore();
 	}
 
-	if ( g_pVRModule )
+	VR_PublishInterfaceCache( nullptr );
+}
+
+
+void VR_SetClientModuleResident( bool bResident )
+{
+	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
+
+	g_bClientModuleResident = bResident;
+
+	// drop a module that was only being kept around for a warm re-init
+	if ( !bResident && g_unClientCoreRefCount == 0 )
 	{
-		SharedLib_Unload( g_pVRModule );
-		g_pVRModule = NULL;
+		VR_UnloadClientModule();
 	}
+}
+
 
-	++g_nVRToken;
+bool VR_GetLastInitTimings( VRInitTimings_t *pTimings, uint32_t unTimingsSize )
+{
+	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
+
+	if ( !pTimings || unTimingsSize != sizeof( VRInitTimings_t ) || !g_bHaveLastInitTimings )
+		return false;
+
+	*pTimings = g_lastInitTimings;
+	return true;
 }
 
 EVRInitError VR_LoadHmdSystemInternal()
 {
 	std::string sRuntimePath, sConfigPath, sLogPath;
 
+	VRInitClock_t::time_point phaseStart = VRInitClock_t::now();
 	bool bReadPathRegistry = CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, NULL, NULL );
+	g_currentInitTimings.ulPathRegistryMicroseconds = VR_MicrosecondsSince( phaseStart );
 	if( !bReadPathRegistry )
 	{
 		return vr::VRInitError_Init_PathRegistryNotFound;
 	}
 
+	phaseStart = VRInitClock_t::now();
+
 	// figure out where we're going to look for vrclient.dll
 	// see if the specified path actually exists.
 	if( !Path_IsDirectory( sRuntimePath ) )
@@ -142,15 +734,19 @@ EVRInitError VR_LoadHmdSystemInternal()
 #else
 	std::string sDLLPath = Path_Join( sTestPath, "vrclient" DYNAMIC_LIB_EXT );
 #endif
+	g_currentInitTimings.ulRuntimePathCheckMicroseconds = VR_MicrosecondsSince( phaseStart );
 
 	// only look in the override
+	phaseStart = VRInitClock_t::now();
 	void *pMod = SharedLib_Load( sDLLPath.c_str() );
+	g_currentInitTimings.ulModuleLoadMicroseconds = VR_MicrosecondsSince( phaseStart );
 	// nothing more to do if we can't load the DLL
 	if( !pMod )
 	{
 		return vr::VRInitError_Init_VRClientDLLNotFound;
 	}
 
+	phaseStart = VRInitClock_t::now();
 	VRClientCoreFactoryFn fnFactory = ( VRClientCoreFactoryFn )( SharedLib_GetFunction( pMod, "VRClientCoreFactory" ) );
 	if( !fnFactory )
 	{
@@ -159,8 +755,9 @@ EVRInitError VR_LoadHmdSystemInternal()
 	}
 
 	int nReturnCode = 0;
-	g_pHmdSystem = static_cast< IVRClientCore * > ( fnFactory( vr::IVRClientCore_Version, &nReturnCode ) );
-	if( !g_pHmdSystem )
+	g_pClientCore = static_cast< IVRClientCore * > ( fnFactory( vr::IVRClientCore_Version, &nReturnCode ) );
+	g_currentInitTimings.ulFactoryMicroseconds = VR_MicrosecondsSince( phaseStart );
+	if( !g_pClientCore )
 	{
 		SharedLib_Unload( pMod );
 		return vr::VRInitError_Init_InterfaceNotFound;
@@ -173,6 +770,22 @@ EVRInitError VR_LoadHmdSystemInternal()
 
 void *VR_GetGenericInterface(const char *pchInterfaceVersion, EVRInitError *peError)
 {
+	if ( g_bAsyncInitInFlight && !g_bHmdSystemLive )
+	{
+		if ( peError )
+			*peError = vr::VRInitError_Init_NotInitialized;
+		return NULL;
+	}
+
+	void *pCachedInterface = NULL;
+	bool bCachedVersionValid = false;
+	if ( VR_FindCachedInterface( pchInterfaceVersion, &pCachedInterface, &bCachedVersionValid ) && pCachedInterface )
+	{
+		if ( peError )
+			*peError = VRInitError_None;
+		return pCachedInterface;
+	}
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
 	if (!g_pHmdSystem)
@@ -182,11 +795,32 @@ void *VR_GetGenericInterface(const char *pchInterfaceVersion, EVRInitError *peEr
 		return NULL;
 	}
 
-	return g_pHmdSystem->GetGenericInterface(pchInterfaceVersion, peError);
+	EVRInitError err = VRInitError_None;
+	void *pInterface = g_pHmdSystem->GetGenericInterface( pchInterfaceVersion, &err );
+	if ( pInterface && err == VRInitError_None && pchInterfaceVersion )
+	{
+		VR_CacheInterface( pchInterfaceVersion, pInterface, false );
+	}
+
+	if ( peError )
+		*peError = err;
+	return pInterface;
 }
 
 bool VR_IsInterfaceVersionValid(const char *pchInterfaceVersion)
 {
+	if ( g_bAsyncInitInFlight && !g_bHmdSystemLive )
+	{
+		return false;
+	}
+
+	void *pCachedInterface = NULL;
+	bool bCachedVersionValid = false;
+	if ( VR_FindCachedInterface( pchInterfaceVersion, &pCachedInterface, &bCachedVersionValid ) && bCachedVersionValid )
+	{
+		return true;
+	}
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
 	if (!g_pHmdSystem)
@@ -194,7 +828,13 @@ bool VR_IsInterfaceVersionValid(const char *pchInterfaceVersion)
 		return false;
 	}
 
-	return g_pHmdSystem->IsInterfaceVersionValid(pchInterfaceVersion) == VRInitError_None;
+	bool bValid = g_pHmdSystem->IsInterfaceVersionValid(pchInterfaceVersion) == VRInitError_None;
+	if ( bValid && pchInterfaceVersion )
+	{
+		VR_CacheInterface( pchInterfaceVersion, NULL, true );
+	}
+
+	return bValid;
 }
 
 bool VR_IsHmdPresent()
@@ -209,15 +849,13 @@ bool VR_IsHmdPresent()
 	else
 	{
 		// otherwise we need to do a bit more work
-		EVRInitError err = VR_LoadHmdSystemInternal();
+		EVRInitError err = VR_AcquireClientCore();
 		if( err != VRInitError_None )
 			return false;
 
-		bool bHasHmd = g_pHmdSystem->BIsHmdPresent();
+		bool bHasHmd = g_pClientCore->BIsHmdPresent();
 
-		g_pHmdSystem = NULL;
-		SharedLib_Unload( g_pVRModule );
-		g_pVRModule = NULL;
+		VR_ReleaseClientCore();
 
 		return bHasHmd;
 	}
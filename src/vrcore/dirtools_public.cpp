@@ -13,6 +13,21 @@
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined( LINUX )
+#include <sys/syscall.h>
 #endif
 
 #if defined( OSX )
@@ -21,11 +36,162 @@
 
 #define HMD_INVALID_HANDLE_VALUE ( ( HMDHANDLE )( LONG_PTR )-1 )
 
+#if !defined( _WIN32 )
+//-----------------------------------------------------------------------------
+// Directories that BCreateDirectoryRecursive recently found or made, most
+// recently used first. When more than one level of a path is missing, starting
+// from one of these saves searching up the path for where the existing part
+// ends. Entries can go stale if the directory is removed, so they are always
+// proven by making a child before being trusted.
+//-----------------------------------------------------------------------------
+static const size_t k_unConfirmedDirectoryCount = 8;
+static std::mutex s_mutexConfirmedDirectories;
+static std::string s_rsConfirmedDirectories[ k_unConfirmedDirectoryCount ];
+
+// returns the longest cached directory that is an ancestor of sPath, or an empty string
+static std::string FindConfirmedAncestor( const std::string & sPath )
+{
+	std::lock_guard< std::mutex > lock( s_mutexConfirmedDirectories );
+
+	const std::string *psBest = NULL;
+	for ( size_t i = 0; i < k_unConfirmedDirectoryCount; i++ )
+	{
+		const std::string & sDirectory = s_rsConfirmedDirectories[ i ];
+		if ( sDirectory.empty() || sDirectory.length() >= sPath.length() || ( psBest && psBest->length() >= sDirectory.length() ) )
+			continue;
+		if ( sPath[ sDirectory.length() ] == '/' && sPath.compare( 0, sDirectory.length(), sDirectory ) == 0 )
+			psBest = &sDirectory;
+	}
+	return psBest ? *psBest : std::string();
+}
+
+// Moves a confirmed directory to the front, pushing out the least recently used one if it
+// wasn't there already. Directories that turned out not to exist are dropped.
+static void SetDirectoryConfirmed( const std::string & sDirectory, bool bConfirmed )
+{
+	std::lock_guard< std::mutex > lock( s_mutexConfirmedDirectories );
+
+	size_t unFound = k_unConfirmedDirectoryCount - 1;
+	for ( size_t i = 0; i < k_unConfirmedDirectoryCount; i++ )
+	{
+		if ( s_rsConfirmedDirectories[ i ] == sDirectory )
+		{
+			unFound = i;
+			break;
+		}
+	}
+
+	if ( bConfirmed )
+	{
+		std::rotate( s_rsConfirmedDirectories, s_rsConfirmedDirectories + unFound, s_rsConfirmedDirectories + unFound + 1 );
+		s_rsConfirmedDirectories[ 0 ] = sDirectory;
+	}
+	else if ( s_rsConfirmedDirectories[ unFound ] == sDirectory )
+	{
+		s_rsConfirmedDirectories[ unFound ].clear();
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Creates a directory and any missing parents in as few syscalls as
+// we can manage. Usually the directory or its parent already exists, so the
+// full path is tried first and that's the only call. Otherwise we find the
+// deepest directory that exists by trying to make each parent in turn, and
+// then make the rest of the path from there down.
+//-----------------------------------------------------------------------------
+static bool BCreateDirectoryRecursivePosix( const char *pchPath )
+{
+	const mode_t k_unMode = S_IRWXU | S_IRWXG | S_IRWXO;
+
+	std::string sPath( pchPath );
+	while ( sPath.length() > 1 && sPath.back() == '/' )
+		sPath.pop_back();
+	if ( sPath.empty() )
+		return false;
+
+	if ( mkdir( sPath.c_str(), k_unMode ) == 0 || errno == EEXIST )
+		return true;
+	if ( errno != ENOENT )
+		return false;
+
+	// unCreated is the length of the prefix of sPath that is known to exist
+	size_t unCreated = 0;
+
+	// Start below a directory we've seen recently if there is one. Making its
+	// child proves it still exists.
+	std::string sAncestor = FindConfirmedAncestor( sPath );
+	if ( !sAncestor.empty() )
+	{
+		size_t unChildEnd = sPath.find( '/', sAncestor.length() + 1 );
+		if ( mkdir( sPath.substr( 0, unChildEnd ).c_str(), k_unMode ) == 0 || errno == EEXIST )
+		{
+			unCreated = unChildEnd;
+			SetDirectoryConfirmed( sAncestor, true );
+		}
+		else if ( errno == ENOENT )
+			SetDirectoryConfirmed( sAncestor, false );
+		else
+			return false;
+	}
+
+	if ( !unCreated )
+	{
+		// Walk up making each parent until one works. Its parent must have existed.
+		size_t unEnd = sPath.length();
+		for ( ;; )
+		{
+			size_t unSlash = sPath.rfind( '/', unEnd - 1 );
+			if ( unSlash == std::string::npos || unSlash == 0 )
+			{
+				// nothing on the path exists below the root or the current directory
+				break;
+			}
+
+			if ( mkdir( sPath.substr( 0, unSlash ).c_str(), k_unMode ) == 0 || errno == EEXIST )
+			{
+				unCreated = unSlash;
+				SetDirectoryConfirmed( sPath.substr( 0, unSlash ), true );
+				break;
+			}
+			if ( errno != ENOENT )
+				return false;
+
+			unEnd = unSlash;
+		}
+	}
+
+	// make everything below that, one level at a time
+	for ( size_t unSlash = sPath.find( '/', unCreated + 1 ); ; unSlash = sPath.find( '/', unSlash + 1 ) )
+	{
+		// nothing to make for the empty component in a//b
+		if ( unSlash != std::string::npos && sPath[ unSlash - 1 ] == '/' )
+			continue;
+
+		std::string sPrefix = sPath.substr( 0, unSlash );
+		if ( mkdir( sPrefix.c_str(), k_unMode ) != 0 && errno != EEXIST )
+			return false;
+
+		if ( unSlash == std::string::npos )
+			break;
+	}
+
+	// what gets made next is likely to be inside this directory
+	SetDirectoryConfirmed( sPath, true );
+
+	return true;
+}
+#endif
+
+
 //-----------------------------------------------------------------------------
 // Purpose: utility function to create dirs & subdirs
 //-----------------------------------------------------------------------------
 bool BCreateDirectoryRecursive( const char *pchPath )
 {
+#if !defined( _WIN32 )
+	return BCreateDirectoryRecursivePosix( pchPath );
+#else
 	// Does it already exist?
 	if ( Path_IsDirectory( pchPath ) )
 		return true;
@@ -72,6 +238,7 @@ bool BCreateDirectoryRecursive( const char *pchPath )
 	bool bRetVal = BCreateDirectory( path );
 	free( path );
 	return bRetVal;
+#endif
 }
 
 
@@ -100,14 +267,584 @@ bool BCreateDirectory( const char *pchPath )
 #endif
 }
 
-#if !defined( VRCORE_NO_PLATFORM )
+//-----------------------------------------------------------------------------
+// Purpose: ASCII lower case, without going through the locale
+//-----------------------------------------------------------------------------
+static inline char FoldFilenameChar( char c )
+{
+	return ( c >= 'A' && c <= 'Z' ) ? ( char )( c - 'A' + 'a' ) : c;
+}
+
+
+static bool BFoldedEquals( const char *pchFolded, const char *pchName, size_t unLength )
+{
+	for ( size_t i = 0; i < unLength; i++ )
+	{
+		if ( pchFolded[ i ] != FoldFilenameChar( pchName[ i ] ) )
+			return false;
+	}
+	return true;
+}
+
+
+// like BFoldedEquals, but ? in the pattern matches any character
+static bool BFoldedEqualsWithWildcards( const char *pchFolded, const char *pchName, size_t unLength )
+{
+	for ( size_t i = 0; i < unLength; i++ )
+	{
+		if ( pchFolded[ i ] != '?' && pchFolded[ i ] != FoldFilenameChar( pchName[ i ] ) )
+			return false;
+	}
+	return true;
+}
+
+
+CFilenamePattern::CFilenamePattern()
+	: m_eMatchType( k_EMatchType_All )
+	, m_unHeadLength( 0 )
+	, m_unTailLength( 0 )
+{
+}
 
+
+CFilenamePattern::CFilenamePattern( const char *pchPattern )
+{
+	Compile( pchPattern );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Works out which kind of match the pattern needs
+//-----------------------------------------------------------------------------
+void CFilenamePattern::Compile( const char *pchPattern )
+{
+	m_sPattern.clear();
+	m_unHeadLength = 0;
+	m_unTailLength = 0;
+
+	if ( !pchPattern )
+	{
+		m_eMatchType = k_EMatchType_All;
+		return;
+	}
+
+	size_t unStars = 0, unQuestionMarks = 0;
+	for ( const char *pch = pchPattern; *pch; pch++ )
+	{
+		if ( *pch == '*' )
+		{
+			// ** is the same as *
+			if ( !m_sPattern.empty() && m_sPattern.back() == '*' )
+				continue;
+			unStars++;
+		}
+		else if ( *pch == '?' )
+		{
+			unQuestionMarks++;
+		}
+		m_sPattern.push_back( FoldFilenameChar( *pch ) );
+	}
+
+	// only "*.*" as written gets the Windows meaning, "*.**" still needs a dot
+	if ( m_sPattern == "*" || !strcmp( pchPattern, "*.*" ) )
+	{
+		m_eMatchType = k_EMatchType_All;
+		m_sPattern.clear();
+	}
+	else if ( unQuestionMarks > 0 || unStars > 1 )
+	{
+		m_eMatchType = k_EMatchType_General;
+	}
+	else if ( unStars == 0 )
+	{
+		m_eMatchType = k_EMatchType_Literal;
+	}
+	else if ( m_sPattern.back() == '*' )
+	{
+		m_eMatchType = k_EMatchType_Prefix;
+		m_sPattern.pop_back();
+	}
+	else if ( m_sPattern[ 0 ] == '*' )
+	{
+		m_eMatchType = k_EMatchType_Suffix;
+		m_sPattern.erase( 0, 1 );
+	}
+	else
+	{
+		m_eMatchType = k_EMatchType_General;
+	}
+
+	if ( m_eMatchType == k_EMatchType_General )
+	{
+		size_t unFirstStar = m_sPattern.find( '*' );
+		if ( unFirstStar == std::string::npos )
+		{
+			m_unHeadLength = m_sPattern.length();
+		}
+		else
+		{
+			m_unHeadLength = unFirstStar;
+			m_unTailLength = m_sPattern.length() - m_sPattern.rfind( '*' ) - 1;
+		}
+	}
+}
+
+
+bool CFilenamePattern::BMatches( const char *pchName ) const
+{
+	switch ( m_eMatchType )
+	{
+	case k_EMatchType_All:
+		return true;
+
+	// these stop at the first difference, and the terminator never matches the pattern,
+	// so they don't need the length first
+	case k_EMatchType_Literal:
+		return BFoldedEquals( m_sPattern.c_str(), pchName, m_sPattern.length() ) && pchName[ m_sPattern.length() ] == 0;
+
+	case k_EMatchType_Prefix:
+		return BFoldedEquals( m_sPattern.c_str(), pchName, m_sPattern.length() );
+
+	default:
+		return BMatches( pchName, strlen( pchName ) );
+	}
+}
+
+
+bool CFilenamePattern::BMatches( const char *pchName, size_t unNameLength ) const
+{
+	switch ( m_eMatchType )
+	{
+	case k_EMatchType_All:
+		return true;
+
+	case k_EMatchType_Literal:
+		return unNameLength == m_sPattern.length() && BFoldedEquals( m_sPattern.c_str(), pchName, unNameLength );
+
+	case k_EMatchType_Prefix:
+		return unNameLength >= m_sPattern.length() && BFoldedEquals( m_sPattern.c_str(), pchName, m_sPattern.length() );
+
+	case k_EMatchType_Suffix:
+		return unNameLength >= m_sPattern.length()
+			&& BFoldedEquals( m_sPattern.c_str(), pchName + unNameLength - m_sPattern.length(), m_sPattern.length() );
+
+	case k_EMatchType_General:
+	default:
+		return BMatchesGeneral( pchName, unNameLength );
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Full wildcard match. The text before the first * and after the
+// last one can only match one way, so those are checked directly. In between,
+// only the most recent * ever needs to be retried, because anything an earlier
+// * could absorb the later one can too, so this never recurses.
+//-----------------------------------------------------------------------------
+bool CFilenamePattern::BMatchesGeneral( const char *pchName, size_t unNameLength ) const
+{
+	if ( m_unHeadLength == m_sPattern.length() )
+	{
+		// no * at all
+		return unNameLength == m_unHeadLength && BFoldedEqualsWithWildcards( m_sPattern.c_str(), pchName, unNameLength );
+	}
+
+	if ( unNameLength < m_unHeadLength + m_unTailLength
+		|| !BFoldedEqualsWithWildcards( m_sPattern.c_str(), pchName, m_unHeadLength )
+		|| !BFoldedEqualsWithWildcards( m_sPattern.c_str() + m_sPattern.length() - m_unTailLength,
+			pchName + unNameLength - m_unTailLength, m_unTailLength ) )
+	{
+		return false;
+	}
+
+	// what's left of the pattern starts and ends with *
+	const char *pchPattern = m_sPattern.c_str() + m_unHeadLength;
+	size_t unPatternLength = m_sPattern.length() - m_unHeadLength - m_unTailLength;
+	pchName += m_unHeadLength;
+	unNameLength -= m_unHeadLength + m_unTailLength;
+
+	size_t unPattern = 0, unName = 0;
+	size_t unStarPattern = std::string::npos, unStarName = 0;
+	while ( unName < unNameLength )
+	{
+		if ( unPattern < unPatternLength && pchPattern[ unPattern ] == '*' )
+		{
+			// try matching nothing first, and come back here if that fails
+			unStarPattern = unPattern++;
+			unStarName = unName;
+		}
+		else if ( unPattern < unPatternLength
+			&& ( pchPattern[ unPattern ] == '?' || pchPattern[ unPattern ] == FoldFilenameChar( pchName[ unName ] ) ) )
+		{
+			unPattern++;
+			unName++;
+		}
+		else if ( unStarPattern != std::string::npos )
+		{
+			// let the last * swallow one more character
+			unPattern = unStarPattern + 1;
+			unName = ++unStarName;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while ( unPattern < unPatternLength && pchPattern[ unPattern ] == '*' )
+		unPattern++;
+
+	return unPattern == unPatternLength;
+}
+
+
+#if !defined( _WIN32 )
+
+//-----------------------------------------------------------------------------
+// Purpose: An open directory in a tree walk. It stays open until the last of
+// its subdirectories has been opened.
+//-----------------------------------------------------------------------------
+struct DirectoryTreeNode_t
+{
+	DirectoryTreeNode_t() : pDir( NULL ) {}
+	~DirectoryTreeNode_t()
+	{
+		if ( pDir )
+			closedir( pDir );
+	}
+
+	DIR *pDir;
+	std::string sRelativePath;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: A directory waiting to be read. The root has no parent and its
+// name is the path that was passed in.
+//-----------------------------------------------------------------------------
+struct DirectoryTreeWork_t
+{
+	std::shared_ptr< DirectoryTreeNode_t > pParent;
+	std::string sName;
+	uint32_t unDepth;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs one BWalkDirectoryTree. Each thread keeps its own queue of
+// directories to read and works depth first from the back of it. Threads that
+// run out of work steal from the front of the other queues, which is where
+// the biggest untouched subtrees are.
+//-----------------------------------------------------------------------------
+class CDirectoryTreeWalker
+{
+public:
+	CDirectoryTreeWalker( const char *pchPattern, uint32_t unMaxDepth, uint32_t unThreadCount, const DirectoryTreeVisitor_t & visitor );
+
+	bool BWalk( const char *pchPath );
+
+private:
+	struct WorkQueue_t
+	{
+		std::mutex mutex;
+		std::deque< DirectoryTreeWork_t > deque;
+	};
+
+	void WorkerThread( uint32_t unWorker );
+	void PushWork( uint32_t unWorker, DirectoryTreeWork_t && work );
+	bool BPopWork( uint32_t unWorker, DirectoryTreeWork_t *pWork );
+	void ReadDirectory( uint32_t unWorker, const DirectoryTreeWork_t & work );
+
+	CFilenamePattern m_pattern;
+	uint32_t m_unMaxDepth;
+	const DirectoryTreeVisitor_t & m_visitor;
+
+	std::vector< std::unique_ptr< WorkQueue_t > > m_vecQueues;
+
+	// directories that have been queued but not finished
+	std::atomic< uint32_t > m_unPendingDirectories;
+	std::atomic< bool > m_bStopped;
+	std::atomic< bool > m_bFailed;
+
+	// idle threads wait here for more work
+	std::mutex m_mutexIdle;
+	std::condition_variable m_condIdle;
+};
+
+
+CDirectoryTreeWalker::CDirectoryTreeWalker( const char *pchPattern, uint32_t unMaxDepth, uint32_t unThreadCount, const DirectoryTreeVisitor_t & visitor )
+	: m_pattern( pchPattern )
+	, m_unMaxDepth( unMaxDepth )
+	, m_visitor( visitor )
+	, m_unPendingDirectories( 0 )
+	, m_bStopped( false )
+	, m_bFailed( false )
+{
+	if ( unThreadCount == 0 )
+		unThreadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+	for ( uint32_t i = 0; i < unThreadCount; i++ )
+	{
+		m_vecQueues.push_back( std::unique_ptr< WorkQueue_t >( new WorkQueue_t ) );
+	}
+}
+
+
+bool CDirectoryTreeWalker::BWalk( const char *pchPath )
+{
+	DirectoryTreeWork_t root;
+	root.sName = pchPath;
+	root.unDepth = 0;
+	PushWork( 0, std::move( root ) );
+
+	// the calling thread is worker 0
+	std::vector< std::thread > vecThreads;
+	for ( uint32_t i = 1; i < m_vecQueues.size(); i++ )
+	{
+		vecThreads.push_back( std::thread( &CDirectoryTreeWalker::WorkerThread, this, i ) );
+	}
+	WorkerThread( 0 );
+
+	for ( size_t i = 0; i < vecThreads.size(); i++ )
+	{
+		vecThreads[ i ].join();
+	}
+
+	return !m_bFailed;
+}
+
+
+void CDirectoryTreeWalker::WorkerThread( uint32_t unWorker )
+{
+	DirectoryTreeWork_t work;
+	for ( ;; )
+	{
+		if ( !BPopWork( unWorker, &work ) )
+		{
+			if ( m_unPendingDirectories == 0 )
+				return;
+
+			// Someone else is still reading and may queue more. Pushes and the last finish
+			// notify under m_mutexIdle, so checking again under it can't miss one.
+			std::unique_lock< std::mutex > lock( m_mutexIdle );
+			for ( ;; )
+			{
+				if ( m_unPendingDirectories == 0 )
+					return;
+				if ( BPopWork( unWorker, &work ) )
+					break;
+				m_condIdle.wait( lock );
+			}
+		}
+
+		if ( !m_bStopped )
+		{
+			ReadDirectory( unWorker, work );
+		}
+
+		// let go of the parent directory as soon as we're done with it
+		work = DirectoryTreeWork_t();
+
+		if ( --m_unPendingDirectories == 0 )
+		{
+			std::lock_guard< std::mutex > lock( m_mutexIdle );
+			m_condIdle.notify_all();
+		}
+	}
+}
+
+
+void CDirectoryTreeWalker::PushWork( uint32_t unWorker, DirectoryTreeWork_t && work )
+{
+	++m_unPendingDirectories;
+	{
+		WorkQueue_t & queue = *m_vecQueues[ unWorker ];
+		std::lock_guard< std::mutex > lock( queue.mutex );
+		queue.deque.push_back( std::move( work ) );
+	}
+
+	std::lock_guard< std::mutex > lock( m_mutexIdle );
+	m_condIdle.notify_one();
+}
+
+
+bool CDirectoryTreeWalker::BPopWork( uint32_t unWorker, DirectoryTreeWork_t *pWork )
+{
+	{
+		WorkQueue_t & queue = *m_vecQueues[ unWorker ];
+		std::lock_guard< std::mutex > lock( queue.mutex );
+		if ( !queue.deque.empty() )
+		{
+			*pWork = std::move( queue.deque.back() );
+			queue.deque.pop_back();
+			return true;
+		}
+	}
+
+	for ( size_t i = 1; i < m_vecQueues.size(); i++ )
+	{
+		WorkQueue_t & queue = *m_vecQueues[ ( unWorker + i ) % m_vecQueues.size() ];
+		std::lock_guard< std::mutex > lock( queue.mutex );
+		if ( !queue.deque.empty() )
+		{
+			*pWork = std::move( queue.deque.front() );
+			queue.deque.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void CDirectoryTreeWalker::ReadDirectory( uint32_t unWorker, const DirectoryTreeWork_t & work )
+{
+	// the root and every subdirectory are opened without following a symlink, and
+	// subdirectories are opened relative to their parent
+	int nFd;
+	if ( work.pParent )
+		nFd = openat( dirfd( work.pParent->pDir ), work.sName.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW );
+	else
+		nFd = open( work.sName.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW );
+	if ( nFd < 0 )
+	{
+		m_bFailed = true;
+		return;
+	}
+
+	std::shared_ptr< DirectoryTreeNode_t > pNode = std::make_shared< DirectoryTreeNode_t >();
+	pNode->pDir = fdopendir( nFd );
+	if ( !pNode->pDir )
+	{
+		close( nFd );
+		m_bFailed = true;
+		return;
+	}
+
+	if ( work.pParent )
+	{
+		pNode->sRelativePath = work.pParent->sRelativePath.empty() ? work.sName : work.pParent->sRelativePath + "/" + work.sName;
+	}
+
+	// Read the whole directory before the visitor sees any of it. POSIX doesn't say what
+	// readdir returns once entries are unlinked or renamed behind it, and visitors do both.
+	// The names are packed end to end, each with its terminator.
+	std::string sNames;
+	std::vector< std::pair< size_t, bool > > vecEntries;
+	for ( ;; )
+	{
+		errno = 0;
+		struct dirent *pEnt = readdir( pNode->pDir );
+		if ( !pEnt )
+		{
+			if ( errno != 0 )
+				m_bFailed = true;
+			break;
+		}
+
+		const char *pchName = pEnt->d_name;
+		if ( pchName[ 0 ] == '.' && ( pchName[ 1 ] == 0 || ( pchName[ 1 ] == '.' && pchName[ 2 ] == 0 ) ) )
+			continue;
+
+		bool bIsDirectory;
+		if ( pEnt->d_type != DT_UNKNOWN )
+		{
+			bIsDirectory = pEnt->d_type == DT_DIR;
+		}
+		else
+		{
+			struct stat statBuf;
+			bIsDirectory = fstatat( nFd, pchName, &statBuf, AT_SYMLINK_NOFOLLOW ) == 0 && S_ISDIR( statBuf.st_mode );
+		}
+
+		vecEntries.push_back( std::make_pair( sNames.length(), bIsDirectory ) );
+		sNames.append( pchName, strlen( pchName ) + 1 );
+	}
+
+	DirectoryTreeEntry_t entry;
+	entry.nDirectoryFd = nFd;
+	entry.pchDirectoryPath = pNode->sRelativePath.c_str();
+	entry.unDepth = work.unDepth;
+
+	for ( size_t i = 0; i < vecEntries.size(); i++ )
+	{
+		const char *pchName = sNames.c_str() + vecEntries[ i ].first;
+		bool bIsDirectory = vecEntries[ i ].second;
+
+		EDirectoryTreeWalkResult eResult = k_EDirectoryTreeWalk_Continue;
+		if ( m_pattern.BMatches( pchName ) )
+		{
+			entry.pchName = pchName;
+			entry.bIsDirectory = bIsDirectory;
+			eResult = m_visitor( entry );
+		}
+
+		if ( eResult == k_EDirectoryTreeWalk_Stop || m_bStopped )
+		{
+			m_bStopped = true;
+			break;
+		}
+
+		if ( bIsDirectory && eResult != k_EDirectoryTreeWalk_SkipChildren && work.unDepth < m_unMaxDepth )
+		{
+			DirectoryTreeWork_t child;
+			child.pParent = pNode;
+			child.sName = pchName;
+			child.unDepth = work.unDepth + 1;
+			PushWork( unWorker, std::move( child ) );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Walks a directory tree in parallel, calling the visitor for each entry
+//-----------------------------------------------------------------------------
+bool BWalkDirectoryTree( const char *pchPath, const char *pchPattern, uint32_t unMaxDepth, uint32_t unThreadCount,
+	const DirectoryTreeVisitor_t & visitor )
+{
+	if ( !pchPath || !*pchPath || !visitor )
+		return false;
+
+	CDirectoryTreeWalker walker( pchPattern, unMaxDepth, unThreadCount, visitor );
+	return walker.BWalk( pchPath );
+}
+
+#endif // !_WIN32
+
+
+#if !defined( VRCORE_NO_PLATFORM ) || defined( LINUX )
+
+#if !defined( VRCORE_NO_PLATFORM )
 #include <vrcore/log.h>
+#else
+// Without the platform layer files carry none of the Windows only attributes
+#define _A_HIDDEN	0
+#define _A_RDONLY	0
+#define _A_SYSTEM	0
+#define _A_ARCH		0
+#endif
+
+#if defined( LINUX )
+// the records getdents64 fills its buffer with
+struct LinuxDirent64_t
+{
+	uint64_t d_ino;
+	int64_t d_off;
+	unsigned short d_reclen;
+	unsigned char d_type;
+	char d_name[ 1 ];
+};
+
+static const size_t k_unDirentBufferSize = 32 * 1024;
+#endif
 
 //-----------------------------------------------------------------------------
 CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern )
 {
+#if !defined( LINUX )
 	m_pFindData = NULL;
+#endif
 
 	// put in the path
 	if ( pchPath )
@@ -124,11 +861,20 @@ CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern )
 #if defined( _WIN32 )
 		m_hFind = HMD_INVALID_HANDLE_VALUE;
 		m_pFindData = new WIN32_FIND_DATAW;
+		memset( m_pFindData, 0, sizeof( *m_pFindData ) );
+#elif defined( LINUX )
+		m_nDirFd = -1;
+		m_unDirentOffset = 0;
+		m_unDirentLength = 0;
+		m_pchCurrentName = "";
+		m_unCurrentType = DT_UNKNOWN;
+		m_bCurrentStatFetched = false;
+		m_bCurrentStatValid = false;
 #else
 		m_hFind = -1;
 		m_pFindData = new _finddata_t;
-#endif
 		memset( m_pFindData, 0, sizeof( *m_pFindData ) );
+#endif
 	}
 }
 
@@ -150,6 +896,36 @@ void CDirIterator::Init( const std::string &sPathAndPattern )
 	{
 		m_sFilename = UTF16to8( m_pFindData->cFileName );
 	}
+#elif defined( LINUX )
+	m_nDirFd = -1;
+	m_unDirentOffset = 0;
+	m_unDirentLength = 0;
+	m_pchCurrentName = "";
+	m_unCurrentType = DT_UNKNOWN;
+	m_bCurrentStatFetched = false;
+	m_bCurrentStatValid = false;
+
+	// the pattern is everything after the last slash
+	bool bSuccess = false;
+	std::string::size_type nSlash = sPathAndPattern.find_last_of( '/' );
+	if ( nSlash != std::string::npos )
+	{
+		std::string sDirectory = nSlash == 0 ? std::string( "/" ) : sPathAndPattern.substr( 0, nSlash );
+		m_pattern.Compile( sPathAndPattern.c_str() + nSlash + 1 );
+
+		m_nDirFd = open( sDirectory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+		if ( m_nDirFd >= 0 )
+		{
+			// like FindFirstFile, fail if nothing matches
+			m_vecDirentBuffer.resize( k_unDirentBufferSize );
+			bSuccess = BReadNextEntry();
+			if ( !bSuccess )
+			{
+				close( m_nDirFd );
+				m_nDirFd = -1;
+			}
+		}
+	}
 #else
 	m_pFindData = new _finddata_t;
 	memset( m_pFindData, 0, sizeof( *m_pFindData ) );
@@ -184,6 +960,11 @@ CDirIterator::~CDirIterator()
 		FindClose( m_hFind );
 	}
 	delete m_pFindData;
+#elif defined( LINUX )
+	if ( m_nDirFd >= 0 )
+	{
+		close( m_nDirFd );
+	}
 #else
 	if ( m_hFind != -1 )
 	{
@@ -210,6 +991,8 @@ bool CDirIterator::IsValid() const
 {
 #if defined( _WIN32 )
 	return m_hFind != HMD_INVALID_HANDLE_VALUE;
+#elif defined( LINUX )
+	return m_nDirFd >= 0;
 #else
 	return m_hFind != -1;
 #endif
@@ -222,6 +1005,8 @@ bool CDirIterator::BValidFilename()
 {
 #if defined( _WIN32 )
 	const char *pch = m_sFilename.c_str();
+#elif defined( LINUX )
+	const char *pch = m_pchCurrentName;
 #else
 	const char *pch = m_pFindData->name;
 #endif
@@ -258,6 +1043,8 @@ bool CDirIterator::BNextFile()
 		{
 			m_sFilename = UTF16to8( m_pFindData->cFileName );
 		}
+#elif defined( LINUX )
+		bool bFound = BReadNextEntry();
 #else
 		bool bFound = ( _findnext( m_hFind, m_pFindData ) == 0 );
 #endif
@@ -291,12 +1078,67 @@ std::string CDirIterator::CurrentFileName()
 {
 #if defined( _WIN32 )
 	return m_sFilename;
+#elif defined( LINUX )
+	return m_pchCurrentName;
 #else
 	return m_pFindData->name;
 #endif
 }
 
 
+#if defined( LINUX )
+//-----------------------------------------------------------------------------
+// Purpose: advances to the next entry that matches the pattern, reading
+// another batch from the directory when the buffer runs out
+//-----------------------------------------------------------------------------
+bool CDirIterator::BReadNextEntry()
+{
+	for ( ;; )
+	{
+		if ( m_unDirentOffset >= m_unDirentLength )
+		{
+			long nRead = syscall( SYS_getdents64, m_nDirFd, &m_vecDirentBuffer[ 0 ], m_vecDirentBuffer.size() );
+			if ( nRead <= 0 )
+				return false;
+
+			m_unDirentOffset = 0;
+			m_unDirentLength = ( size_t )nRead;
+		}
+
+		const LinuxDirent64_t *pEntry = ( const LinuxDirent64_t * )&m_vecDirentBuffer[ m_unDirentOffset ];
+		m_unDirentOffset += pEntry->d_reclen;
+
+		const char *pchName = pEntry->d_name;
+		if ( pchName[ 0 ] == '.' && ( pchName[ 1 ] == 0 || ( pchName[ 1 ] == '.' && pchName[ 2 ] == 0 ) ) )
+			continue;
+
+		if ( !m_pattern.BMatches( pchName ) )
+			continue;
+
+		m_pchCurrentName = pEntry->d_name;
+		m_unCurrentType = pEntry->d_type;
+		m_bCurrentStatFetched = false;
+		return true;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: stats the current file the first time it's needed. Returns NULL
+// if the file could not be stat'd.
+//-----------------------------------------------------------------------------
+const struct stat *CDirIterator::GetCurrentStat() const
+{
+	if ( !m_bCurrentStatFetched )
+	{
+		m_bCurrentStatValid = fstatat( m_nDirFd, m_pchCurrentName, &m_currentStat, 0 ) == 0;
+		m_bCurrentStatFetched = true;
+	}
+	return m_bCurrentStatValid ? &m_currentStat : NULL;
+}
+#endif
+
+
 //-----------------------------------------------------------------------------
 // Purpose: returns size of the file
 //-----------------------------------------------------------------------------
@@ -305,6 +1147,9 @@ int64_t CDirIterator::CurrentFileLength() const
 #if defined( _WIN32 )
 	LARGE_INTEGER li = { { m_pFindData->nFileSizeLow, ( LONG )m_pFindData->nFileSizeHigh } };
 	return li.QuadPart;
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat ? ( int64_t )pStat->st_size : 0;
 #else
 	return ( int64_t )m_pFindData->size;
 #endif
@@ -346,6 +1191,9 @@ int64_t CDirIterator::CurrentFileWriteTime() const
 {
 #if defined( _WIN32 )
 	return FileTimeToUnixTime( m_pFindData->ftLastWriteTime );
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat ? ( int64_t )pStat->st_mtime : 0;
 #else
 	return m_pFindData->time_write;
 #endif
@@ -359,6 +1207,9 @@ int64_t CDirIterator::CurrentFileCreateTime() const
 {
 #if defined( _WIN32 )
 	return FileTimeToUnixTime( m_pFindData->ftCreationTime );
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat ? ( int64_t )pStat->st_ctime : 0;
 #else
 	return m_pFindData->time_create;
 #endif
@@ -372,6 +1223,12 @@ bool CDirIterator::BCurrentIsDir() const
 {
 #if defined( _WIN32 )
 	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0;
+#elif defined( LINUX )
+	// d_type answers this without a stat unless the entry is a symlink or the filesystem doesn't fill it in
+	if ( m_unCurrentType != DT_UNKNOWN && m_unCurrentType != DT_LNK )
+		return m_unCurrentType == DT_DIR;
+	const struct stat *pStat = GetCurrentStat();
+	return pStat && S_ISDIR( pStat->st_mode );
 #else
 	return ( m_pFindData->attrib & _A_SUBDIR ? true : false );
 #endif
@@ -385,6 +1242,9 @@ bool CDirIterator::BCurrentIsHidden() const
 {
 #if defined( _WIN32 )
 	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_HIDDEN ) != 0;
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat && ( pStat->st_mode & _A_HIDDEN ) ? true : false;
 #else
 	return ( m_pFindData->attrib & _A_HIDDEN ? true : false );
 #endif
@@ -398,6 +1258,9 @@ bool CDirIterator::BCurrentIsReadOnly() const
 {
 #if defined( _WIN32 )
 	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_READONLY ) != 0;
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat && ( pStat->st_mode & _A_RDONLY ) ? true : false;
 #else
 	return ( m_pFindData->attrib & _A_RDONLY ? true : false );
 #endif
@@ -411,6 +1274,9 @@ bool CDirIterator::BCurrentIsSystem() const
 {
 #if defined( _WIN32 )
 	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_SYSTEM ) != 0;
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat && ( pStat->st_mode & _A_SYSTEM ) ? true : false;
 #else
 	return ( m_pFindData->attrib & _A_SYSTEM ? true : false );
 #endif
@@ -424,12 +1290,20 @@ bool CDirIterator::BCurrentIsMarkedForArchive() const
 {
 #if defined( _WIN32 )
 	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_ARCHIVE ) != 0;
+#elif defined( LINUX )
+	const struct stat *pStat = GetCurrentStat();
+	return pStat && ( pStat->st_mode & _A_ARCH ) ? true : false;
 #else
 	return ( m_pFindData->attrib & _A_ARCH ? true : false );
 #endif
 }
 
 
+#endif // !VRCORE_NO_PLATFORM || LINUX
+
+
+#if !defined( VRCORE_NO_PLATFORM )
+
 //-----------------------------------------------------------------------------
 //
 // A huge pile of stuff from fileio.cpp in steam/tier1
@@ -439,7 +1313,8 @@ bool CDirIterator::BCurrentIsMarkedForArchive() const
 #if !defined( _WIN32 )
 // findfirst/findnext implementation from filesystem/linux_support.[h|cpp]
 
-static char selectBuf[ PATH_MAX ];
+// scandir's filter has no context pointer, so _findfirst leaves the pattern here
+static CFilenamePattern s_selectPattern;
 
 #if defined( OSX ) && !defined( __MAC_10_8 )
 static int FileSelect( direntBig_t *ent )
@@ -449,64 +1324,12 @@ static int FileSelect( const direntBig_t *ent )
 #error
 #endif
 {
-	const char *mask = selectBuf;
 	const char *name = ent->d_name;
 
-	return FileSelect( name, mask );
-}
-
-static int FileSelect( const char *name, const char *mask )
-{
-	// printf("Test:%s %s\n",mask,name);
-
 	if ( !strcmp( name, "." ) || !strcmp( name, ".." ) )
 		return 0;
 
-	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
-		return 1;
-
-	while ( *mask && *name )
-	{
-		if ( *mask == '*' )
-		{
-			mask++;		  // move to the next char in the mask
-			if ( !*mask ) // if this is the end of the mask its a match
-			{
-				return 1;
-			}
-			while ( *name && toupper( *name ) != toupper( *mask ) )
-			{ // while the two don't meet up again
-				name++;
-			}
-			if ( !*name )
-			{ // end of the name
-				break;
-			}
-		}
-		else if ( *mask != '?' )
-		{
-			if ( toupper( *mask ) != toupper( *name ) )
-			{ // mismatched!
-				return 0;
-			}
-			else
-			{
-				mask++;
-				name++;
-				if ( !*mask && !*name )
-				{ // if its at the end of the buffer
-					return 1;
-				}
-			}
-		}
-		else /* mask is "?", we don't care*/
-		{
-			mask++;
-			name++;
-		}
-	}
-
-	return ( !*mask && !*name ); // both of the strings are at the end
+	return s_selectPattern.BMatches( name ) ? 1 : 0;
 }
 
 int FillDataStruct( _finddata_t *dat )
@@ -585,9 +1408,9 @@ int _findfirst( const char *fileName, _finddata_t *dat )
 	if ( strlen( dir ) > 0 )
 	{
 		if ( strlen( dir ) == 1 )
-			strncpy( selectBuf, fileName + 1, sizeof( selectBuf ) );
+			s_selectPattern.Compile( fileName + 1 );
 		else
-			strncpy( selectBuf, fileName + strlen( dir ) + 1, sizeof( selectBuf ) );
+			s_selectPattern.Compile( fileName + strlen( dir ) + 1 );
 
 		n = scandirBig( dir, &dat->namelist, FileSelect, alphasortBig );
 		if ( n < 0 )
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
+#include <functional>
 
 
 #if !defined(_WIN32)
@@ -15,16 +17,98 @@ extern bool BCreateDirectoryRecursive( const char *pchPath );
 extern bool BCreateDirectory( const char *pchPath );
 
 
-#if !defined( VRCORE_NO_PLATFORM )
+// A file name pattern using * and ? wildcards, compiled once so it can be matched against
+// many names. Matching ignores ASCII case, and "*.*" matches every name, as on Windows.
+// A NULL pattern also matches every name.
+class CFilenamePattern
+{
+public:
+	CFilenamePattern();
+	explicit CFilenamePattern( const char *pchPattern );
+
+	void Compile( const char *pchPattern );
+
+	bool BMatches( const char *pchName ) const;
+	bool BMatches( const char *pchName, size_t unNameLength ) const;
+
+private:
+	enum EMatchType
+	{
+		k_EMatchType_All,		// "*" and "*.*"
+		k_EMatchType_Literal,	// no wildcards
+		k_EMatchType_Prefix,	// "text*"
+		k_EMatchType_Suffix,	// "*text", including "*.ext"
+		k_EMatchType_General,	// anything else
+	};
+
+	bool BMatchesGeneral( const char *pchName, size_t unNameLength ) const;
+
+	EMatchType m_eMatchType;
+
+	// the pattern in lower case with runs of * collapsed. For the fast paths this
+	// is just the text that has to match, without the *.
+	std::string m_sPattern;
+
+	// for general matches, the number of characters before the first * and after the last one
+	size_t m_unHeadLength;
+	size_t m_unTailLength;
+};
+
+
+#if !defined( _WIN32 )
+
+// one entry found by BWalkDirectoryTree
+struct DirectoryTreeEntry_t
+{
+	int nDirectoryFd;				// the directory containing the entry, for use with openat, fstatat, unlinkat, etc.
+	const char *pchDirectoryPath;	// path of that directory relative to the root of the walk, "" for the root itself
+	const char *pchName;			// name of the entry itself
+	uint32_t unDepth;				// 0 for entries directly inside the root
+	bool bIsDirectory;				// symlinks to directories are not directories and are not followed
+};
 
+enum EDirectoryTreeWalkResult
+{
+	k_EDirectoryTreeWalk_Continue,
+	k_EDirectoryTreeWalk_SkipChildren,	// don't descend into this directory
+	k_EDirectoryTreeWalk_Stop,			// stop the whole walk as soon as possible
+};
+
+typedef std::function< EDirectoryTreeWalkResult( const DirectoryTreeEntry_t & entry ) > DirectoryTreeVisitor_t;
+
+static const uint32_t k_unDirectoryTreeUnlimitedDepth = 0xFFFFFFFF;
+
+// Walks the tree under pchPath on unThreadCount threads (0 to use one per CPU) and calls visitor for every
+// entry whose name matches pchPattern (see CFilenamePattern, NULL matches everything). Directories are descended into whether
+// they match or not, up to unMaxDepth levels below the root. The visitor is called concurrently from all
+// of the threads, in no particular order, and the strings in the entry are only valid during the call.
+// Each directory is read to the end before any of its entries are visited, so the visitor may unlink or
+// rename entries of the directory it is given. pchPath itself is not followed if it is a symlink.
+//
+// Returns false if any part of the tree could not be read. Stopping the walk from the visitor is not an error.
+extern bool BWalkDirectoryTree( const char *pchPath, const char *pchPattern, uint32_t unMaxDepth, uint32_t unThreadCount,
+	const DirectoryTreeVisitor_t & visitor );
+
+#endif // !_WIN32
+
+
+// The Linux iterator only uses system headers, so it is available without the platform layer
+#if !defined( VRCORE_NO_PLATFORM ) || defined( LINUX )
+
+#if !defined( VRCORE_NO_PLATFORM )
 // for finddata_t
 #include <vrcore/platform.h>
+#endif
 
 typedef void *HMDHANDLE;
 
 // iterator class, initialize with the path & pattern you want to want files/dirs for.
 //
 // all string setters and accessors use UTF-8 encoding.
+//
+// On Linux the directory is streamed with getdents64 rather than read up front, so files come
+// back in directory order rather than sorted, and the size, time and attribute accessors only
+// stat the file the first time one of them is called for it.
 class CDirIterator
 {
 public:
@@ -74,10 +158,30 @@ private:
 	HMDHANDLE m_hFind;
 	struct _WIN32_FIND_DATAW *m_pFindData;
 	std::string m_sFilename;
+#elif defined( LINUX )
+	bool BReadNextEntry();
+	const struct stat *GetCurrentStat() const;
+
+	int m_nDirFd;
+	CFilenamePattern m_pattern;
+
+	// getdents64 results, reused for each batch
+	std::vector< char > m_vecDirentBuffer;
+	size_t m_unDirentOffset;
+	size_t m_unDirentLength;
+
+	// points into m_vecDirentBuffer
+	const char *m_pchCurrentName;
+	unsigned char m_unCurrentType;
+
+	// filled in on demand by GetCurrentStat
+	mutable bool m_bCurrentStatFetched;
+	mutable bool m_bCurrentStatValid;
+	mutable struct stat m_currentStat;
 #else
 	int64_t m_hFind;
 	struct _finddata_t *m_pFindData;
 #endif
 };
 
-#endif // VRCORE_NO_PLATFORM
\ No newline at end of file
+#endif // !VRCORE_NO_PLATFORM || LINUX
\ No newline at end of file
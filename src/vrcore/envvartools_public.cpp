@@ -2,8 +2,13 @@
 #include <vrcore/envvartools_public.h>
 #include <vrcore/strtools_public.h>
 #include <stdlib.h>
+#include <string.h>
 #include <string>
 #include <cctype>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -73,8 +78,136 @@ bool GetEnvironmentVariableAsBool( const char *pchVarName, bool bDefault )
 	return bDefault;
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Process-wide snapshot behind GetEnvironmentVariableCached. Names
+//			and values are interned and never freed, so the pointers handed out
+//			stay valid after the snapshot is invalidated. Invalidating only
+//			bumps the generation; each variable is reread the next time it's
+//			asked for, and only takes more memory if its value changed.
+//
+//			The first k_unEnvVarTableSize / 2 variables looked up are published
+//			in an insert-only open addressed table, so looking one of them up
+//			again while the generation is unchanged takes no lock. Anything
+//			else goes through the map under the lock.
+//-----------------------------------------------------------------------------
+struct EnvVarCacheEntry_t
+{
+	std::string sName;
+	std::atomic< const char * > pchValue;
+	std::atomic< uint32_t > unGeneration;
+};
+
+static const uint32_t k_unEnvVarTableSize = 256;
+
+static std::mutex s_mutexEnvVarCache;
+static std::atomic< uint32_t > s_unEnvVarCacheGeneration( 1 );
+static std::deque< std::string > s_dequeEnvVarValues;
+static std::deque< EnvVarCacheEntry_t > s_dequeEnvVarEntries;
+static std::unordered_map< std::string, EnvVarCacheEntry_t * > s_mapEnvVarEntries;
+static std::atomic< EnvVarCacheEntry_t * > s_rgEnvVarTable[ k_unEnvVarTableSize ];
+static uint32_t s_unEnvVarTableCount = 0;
+
+static uint32_t HashEnvVarName( const char *pchVarName )
+{
+	// FNV-1a
+	uint32_t unHash = 2166136261u;
+	for ( ; *pchVarName; pchVarName++ )
+	{
+		unHash = ( unHash ^ (unsigned char)*pchVarName ) * 16777619u;
+	}
+	return unHash;
+}
+
+static EnvVarCacheEntry_t *FindPublishedEnvVar( const char *pchVarName )
+{
+	for ( uint32_t i = 0, unSlot = HashEnvVarName( pchVarName ); i < k_unEnvVarTableSize; i++, unSlot++ )
+	{
+		EnvVarCacheEntry_t *pEntry = s_rgEnvVarTable[ unSlot % k_unEnvVarTableSize ].load( std::memory_order_acquire );
+		if ( !pEntry )
+			return NULL;
+		if ( pEntry->sName == pchVarName )
+			return pEntry;
+	}
+	return NULL;
+}
+
+const char *GetEnvironmentVariableCached( const char *pchVarName )
+{
+	EnvVarCacheEntry_t *pEntry = FindPublishedEnvVar( pchVarName );
+	if ( pEntry && pEntry->unGeneration.load( std::memory_order_acquire ) == s_unEnvVarCacheGeneration.load( std::memory_order_acquire ) )
+		return pEntry->pchValue.load( std::memory_order_acquire );
+
+	std::lock_guard< std::mutex > lock( s_mutexEnvVarCache );
+	const uint32_t unGeneration = s_unEnvVarCacheGeneration.load( std::memory_order_acquire );
+
+	auto iter = s_mapEnvVarEntries.find( pchVarName );
+	if ( iter == s_mapEnvVarEntries.end() )
+	{
+		s_dequeEnvVarEntries.emplace_back();
+		pEntry = &s_dequeEnvVarEntries.back();
+		pEntry->sName = pchVarName;
+		pEntry->pchValue.store( NULL, std::memory_order_relaxed );
+		pEntry->unGeneration.store( 0, std::memory_order_relaxed );
+		s_mapEnvVarEntries.emplace( pEntry->sName, pEntry );
+
+		// keep the table at most half full so probes stay short
+		if ( s_unEnvVarTableCount < k_unEnvVarTableSize / 2 )
+		{
+			uint32_t unSlot = HashEnvVarName( pchVarName );
+			while ( s_rgEnvVarTable[ unSlot % k_unEnvVarTableSize ].load( std::memory_order_relaxed ) )
+				unSlot++;
+			s_rgEnvVarTable[ unSlot % k_unEnvVarTableSize ].store( pEntry, std::memory_order_release );
+			s_unEnvVarTableCount++;
+		}
+	}
+	else
+	{
+		pEntry = iter->second;
+		if ( pEntry->unGeneration.load( std::memory_order_relaxed ) == unGeneration )
+			return pEntry->pchValue.load( std::memory_order_relaxed );
+	}
+
+	// read under the lock, so a concurrent SetEnvironmentVariable can't slip in between
+	// reading a stale value and stamping it with the new generation
+#if defined(_WIN32)
+	static char rchValue[32767]; // max size for an env var on Windows
+	const char *pchValue = NULL;
+	if ( GetEnvironmentVariableA( pchVarName, rchValue, sizeof( rchValue ) ) != 0 )
+		pchValue = rchValue;
+#elif defined(POSIX)
+	const char *pchValue = getenv( pchVarName );
+#else
+#error "Unsupported Platform"
+#endif
+
+	const char *pchCachedValue = pEntry->pchValue.load( std::memory_order_relaxed );
+	if ( !pchValue )
+	{
+		pchCachedValue = NULL;
+	}
+	else if ( !pchCachedValue || strcmp( pchCachedValue, pchValue ) != 0 )
+	{
+		s_dequeEnvVarValues.emplace_back( pchValue );
+		pchCachedValue = s_dequeEnvVarValues.back().c_str();
+	}
+
+	// readers that see the new generation also see the value stored before it
+	pEntry->pchValue.store( pchCachedValue, std::memory_order_release );
+	pEntry->unGeneration.store( unGeneration, std::memory_order_release );
+	return pchCachedValue;
+}
+
+void InvalidateEnvironmentVariableCache()
+{
+	s_unEnvVarCacheGeneration.fetch_add( 1, std::memory_order_acq_rel );
+}
+
 bool SetEnvironmentVariable( const char *pchVarName, const char *pchVarValue )
 {
+	// changing the environment under the snapshot lock means a reread never races it
+	std::lock_guard< std::mutex > lock( s_mutexEnvVarCache );
+	InvalidateEnvironmentVariableCache();
+
 #if defined(_WIN32)
 	return 0 != SetEnvironmentVariableA( pchVarName, pchVarValue );
 #elif defined(POSIX)
@@ -6,3 +6,14 @@
 std::string GetEnvironmentVariable( const char *pchVarName );
 bool GetEnvironmentVariableAsBool( const char *pchVarName, bool bDefault );
 bool SetEnvironmentVariable( const char *pchVarName, const char *pchVarValue );
+
+/** Returns the value of an environment variable, or NULL if it isn't set, from a process-wide
+* snapshot. The returned pointer stays valid for the life of the process, even after the variable
+* changes. Looking up a variable again while the snapshot is current takes no lock and doesn't
+* read the environment.
+*
+* SetEnvironmentVariable invalidates the snapshot. Changes made any other way (setenv, putenv,
+* _putenv_s, or another library doing so) are not seen until InvalidateEnvironmentVariableCache
+* is called. Thread safe. */
+const char *GetEnvironmentVariableCached( const char *pchVarName );
+void InvalidateEnvironmentVariableCache();
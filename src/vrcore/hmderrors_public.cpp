@@ -2,7 +2,9 @@
 #include "openvr.h"
 #include "hmderrors_public.h"
 #include <stdio.h>
+#include <string.h>
 #include <algorithm>
+#include <vector>
 
 using namespace vr;
 
@@ -131,236 +133,244 @@ const char *GetEnglishStringForHmdError( vr::EVRInitError eError )
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Every EVRInitError with an ID string. GetIDForVRInitError and
+//			GetVRInitErrorForID are both generated from this list.
+//-----------------------------------------------------------------------------
+#define VR_INIT_ERROR_IDS( X ) \
+	X( VRInitError_None ) \
+	X( VRInitError_Unknown ) \
+	\
+	X( VRInitError_Init_InstallationNotFound ) \
+	X( VRInitError_Init_InstallationCorrupt ) \
+	X( VRInitError_Init_VRClientDLLNotFound ) \
+	X( VRInitError_Init_FileNotFound ) \
+	X( VRInitError_Init_FactoryNotFound ) \
+	X( VRInitError_Init_InterfaceNotFound ) \
+	X( VRInitError_Init_InvalidInterface ) \
+	X( VRInitError_Init_UserConfigDirectoryInvalid ) \
+	X( VRInitError_Init_HmdNotFound ) \
+	X( VRInitError_Init_NotInitialized ) \
+	X( VRInitError_Init_PathRegistryNotFound ) \
+	X( VRInitError_Init_NoConfigPath ) \
+	X( VRInitError_Init_NoLogPath ) \
+	X( VRInitError_Init_PathRegistryNotWritable ) \
+	X( VRInitError_Init_AppInfoInitFailed ) \
+	X( VRInitError_Init_Retry ) \
+	X( VRInitError_Init_InitCanceledByUser ) \
+	X( VRInitError_Init_AnotherAppLaunching ) \
+	X( VRInitError_Init_SettingsInitFailed ) \
+	X( VRInitError_Init_ShuttingDown ) \
+	X( VRInitError_Init_TooManyObjects ) \
+	X( VRInitError_Init_NoServerForBackgroundApp ) \
+	X( VRInitError_Init_NotSupportedWithCompositor ) \
+	X( VRInitError_Init_NotAvailableToUtilityApps ) \
+	X( VRInitError_Init_Internal ) \
+	X( VRInitError_Init_HmdDriverIdIsNone ) \
+	X( VRInitError_Init_HmdNotFoundPresenceFailed ) \
+	X( VRInitError_Init_VRMonitorNotFound ) \
+	X( VRInitError_Init_VRMonitorStartupFailed ) \
+	X( VRInitError_Init_LowPowerWatchdogNotSupported ) \
+	X( VRInitError_Init_InvalidApplicationType ) \
+	X( VRInitError_Init_NotAvailableToWatchdogApps ) \
+	X( VRInitError_Init_WatchdogDisabledInSettings ) \
+	X( VRInitError_Init_VRDashboardNotFound ) \
+	X( VRInitError_Init_VRDashboardStartupFailed ) \
+	X( VRInitError_Init_VRHomeNotFound ) \
+	X( VRInitError_Init_VRHomeStartupFailed ) \
+	X( VRInitError_Init_RebootingBusy ) \
+	X( VRInitError_Init_FirmwareUpdateBusy ) \
+	X( VRInitError_Init_FirmwareRecoveryBusy ) \
+	X( VRInitError_Init_USBServiceBusy ) \
+	X( VRInitError_Init_VRWebHelperStartupFailed ) \
+	X( VRInitError_Init_TrackerManagerInitFailed ) \
+	X( VRInitError_Init_AlreadyRunning ) \
+	X( VRInitError_Init_FailedForVrMonitor ) \
+	X( VRInitError_Init_PropertyManagerInitFailed ) \
+	X( VRInitError_Init_WebServerFailed ) \
+	X( VRInitError_Init_IllegalTypeTransition ) \
+	X( VRInitError_Init_MismatchedRuntimes ) \
+	X( VRInitError_Init_InvalidProcessId ) \
+	X( VRInitError_Init_VRServiceStartupFailed ) \
+	X( VRInitError_Init_PrismNeedsNewDrivers ) \
+	X( VRInitError_Init_PrismStartupTimedOut ) \
+	X( VRInitError_Init_CouldNotStartPrism ) \
+	X( VRInitError_Init_PrismClientInitFailed ) \
+	X( VRInitError_Init_PrismClientStartFailed ) \
+	X( VRInitError_Init_PrismExitedUnexpectedly ) \
+	X( VRInitError_Init_BadLuid ) \
+	X( VRInitError_Init_NoServerForAppContainer ) \
+	X( VRInitError_Init_DuplicateBootstrapper ) \
+	X( VRInitError_Init_VRDashboardServicePending ) \
+	X( VRInitError_Init_VRDashboardServiceTimeout ) \
+	X( VRInitError_Init_VRDashboardServiceStopped ) \
+	X( VRInitError_Init_VRDashboardAlreadyStarted ) \
+	X( VRInitError_Init_VRDashboardCopyFailed ) \
+	X( VRInitError_Init_VRDashboardTokenFailure ) \
+	X( VRInitError_Init_VRDashboardEnvironmentFailure ) \
+	X( VRInitError_Init_VRDashboardPathFailure ) \
+	\
+	X( VRInitError_Driver_Failed ) \
+	X( VRInitError_Driver_Unknown ) \
+	X( VRInitError_Driver_HmdUnknown ) \
+	X( VRInitError_Driver_NotLoaded ) \
+	X( VRInitError_Driver_RuntimeOutOfDate ) \
+	X( VRInitError_Driver_HmdInUse ) \
+	X( VRInitError_Driver_NotCalibrated ) \
+	X( VRInitError_Driver_CalibrationInvalid ) \
+	X( VRInitError_Driver_HmdDisplayNotFound ) \
+	X( VRInitError_Driver_TrackedDeviceInterfaceUnknown ) \
+	/* X( VRInitError_Driver_HmdDisplayNotFoundAfterFix ) */ \
+	X( VRInitError_Driver_HmdDriverIdOutOfBounds ) \
+	X( VRInitError_Driver_HmdDisplayMirrored ) \
+	X( VRInitError_Driver_HmdDisplayNotFoundLaptop ) \
+	X( VRInitError_Driver_PeerDriverNotInstalled ) \
+	X( VRInitError_Driver_WirelessHmdNotConnected ) \
+	\
+	X( VRInitError_IPC_ServerInitFailed ) \
+	X( VRInitError_IPC_ConnectFailed ) \
+	X( VRInitError_IPC_SharedStateInitFailed ) \
+	X( VRInitError_IPC_CompositorInitFailed ) \
+	X( VRInitError_IPC_MutexInitFailed ) \
+	X( VRInitError_IPC_Failed ) \
+	X( VRInitError_IPC_CompositorConnectFailed ) \
+	X( VRInitError_IPC_CompositorInvalidConnectResponse ) \
+	X( VRInitError_IPC_ConnectFailedAfterMultipleAttempts ) \
+	X( VRInitError_IPC_ConnectFailedAfterTargetExited ) \
+	X( VRInitError_IPC_NamespaceUnavailable ) \
+	\
+	X( VRInitError_Compositor_Failed ) \
+	X( VRInitError_Compositor_D3D11HardwareRequired ) \
+	X( VRInitError_Compositor_FirmwareRequiresUpdate ) \
+	X( VRInitError_Compositor_OverlayInitFailed ) \
+	X( VRInitError_Compositor_ScreenshotsInitFailed ) \
+	X( VRInitError_Compositor_UnableToCreateDevice ) \
+	X( VRInitError_Compositor_SharedStateIsNull ) \
+	X( VRInitError_Compositor_NotificationManagerIsNull ) \
+	X( VRInitError_Compositor_ResourceManagerClientIsNull ) \
+	X( VRInitError_Compositor_MessageOverlaySharedStateInitFailure ) \
+	X( VRInitError_Compositor_PropertiesInterfaceIsNull ) \
+	X( VRInitError_Compositor_CreateFullscreenWindowFailed ) \
+	X( VRInitError_Compositor_SettingsInterfaceIsNull ) \
+	X( VRInitError_Compositor_FailedToShowWindow ) \
+	X( VRInitError_Compositor_DistortInterfaceIsNull ) \
+	X( VRInitError_Compositor_DisplayFrequencyFailure ) \
+	X( VRInitError_Compositor_RendererInitializationFailed ) \
+	X( VRInitError_Compositor_DXGIFactoryInterfaceIsNull ) \
+	X( VRInitError_Compositor_DXGIFactoryCreateFailed ) \
+	X( VRInitError_Compositor_DXGIFactoryQueryFailed ) \
+	X( VRInitError_Compositor_InvalidAdapterDesktop ) \
+	X( VRInitError_Compositor_InvalidHmdAttachment ) \
+	X( VRInitError_Compositor_InvalidOutputDesktop ) \
+	X( VRInitError_Compositor_InvalidDeviceProvided ) \
+	X( VRInitError_Compositor_D3D11RendererInitializationFailed ) \
+	X( VRInitError_Compositor_FailedToFindDisplayMode ) \
+	X( VRInitError_Compositor_FailedToCreateSwapChain ) \
+	X( VRInitError_Compositor_FailedToGetBackBuffer ) \
+	X( VRInitError_Compositor_FailedToCreateRenderTarget ) \
+	X( VRInitError_Compositor_FailedToCreateDXGI2SwapChain ) \
+	X( VRInitError_Compositor_FailedtoGetDXGI2BackBuffer ) \
+	X( VRInitError_Compositor_FailedToCreateDXGI2RenderTarget ) \
+	X( VRInitError_Compositor_FailedToGetDXGIDeviceInterface ) \
+	X( VRInitError_Compositor_SelectDisplayMode ) \
+	X( VRInitError_Compositor_FailedToCreateNvAPIRenderTargets ) \
+	X( VRInitError_Compositor_NvAPISetDisplayMode ) \
+	X( VRInitError_Compositor_FailedToCreateDirectModeDisplay ) \
+	X( VRInitError_Compositor_InvalidHmdPropertyContainer ) \
+	X( VRInitError_Compositor_UpdateDisplayFrequency ) \
+	X( VRInitError_Compositor_CreateRasterizerState ) \
+	X( VRInitError_Compositor_CreateWireframeRasterizerState ) \
+	X( VRInitError_Compositor_CreateSamplerState ) \
+	X( VRInitError_Compositor_CreateClampToBorderSamplerState ) \
+	X( VRInitError_Compositor_CreateAnisoSamplerState ) \
+	X( VRInitError_Compositor_CreateOverlaySamplerState ) \
+	X( VRInitError_Compositor_CreatePanoramaSamplerState ) \
+	X( VRInitError_Compositor_CreateFontSamplerState ) \
+	X( VRInitError_Compositor_CreateNoBlendState ) \
+	X( VRInitError_Compositor_CreateBlendState ) \
+	X( VRInitError_Compositor_CreateAlphaBlendState ) \
+	X( VRInitError_Compositor_CreateBlendStateMaskR ) \
+	X( VRInitError_Compositor_CreateBlendStateMaskG ) \
+	X( VRInitError_Compositor_CreateBlendStateMaskB ) \
+	X( VRInitError_Compositor_CreateDepthStencilState ) \
+	X( VRInitError_Compositor_CreateDepthStencilStateNoWrite ) \
+	X( VRInitError_Compositor_CreateDepthStencilStateNoDepth ) \
+	X( VRInitError_Compositor_CreateFlushTexture ) \
+	X( VRInitError_Compositor_CreateDistortionSurfaces ) \
+	X( VRInitError_Compositor_CreateConstantBuffer ) \
+	X( VRInitError_Compositor_CreateHmdPoseConstantBuffer ) \
+	X( VRInitError_Compositor_CreateHmdPoseStagingConstantBuffer ) \
+	X( VRInitError_Compositor_CreateSharedFrameInfoConstantBuffer ) \
+	X( VRInitError_Compositor_CreateOverlayConstantBuffer ) \
+	X( VRInitError_Compositor_CreateSceneTextureIndexConstantBuffer ) \
+	X( VRInitError_Compositor_CreateReadableSceneTextureIndexConstantBuffer ) \
+	X( VRInitError_Compositor_CreateLayerGraphicsTextureIndexConstantBuffer ) \
+	X( VRInitError_Compositor_CreateLayerComputeTextureIndexConstantBuffer ) \
+	X( VRInitError_Compositor_CreateLayerComputeSceneTextureIndexConstantBuffer ) \
+	X( VRInitError_Compositor_CreateComputeHmdPoseConstantBuffer ) \
+	X( VRInitError_Compositor_CreateGeomConstantBuffer ) \
+	X( VRInitError_Compositor_CreatePanelMaskConstantBuffer ) \
+	X( VRInitError_Compositor_CreatePixelSimUBO ) \
+	X( VRInitError_Compositor_CreateMSAARenderTextures ) \
+	X( VRInitError_Compositor_CreateResolveRenderTextures ) \
+	X( VRInitError_Compositor_CreateComputeResolveRenderTextures ) \
+	X( VRInitError_Compositor_CreateDriverDirectModeResolveTextures ) \
+	X( VRInitError_Compositor_OpenDriverDirectModeResolveTextures ) \
+	X( VRInitError_Compositor_CreateFallbackSyncTexture ) \
+	X( VRInitError_Compositor_ShareFallbackSyncTexture ) \
+	X( VRInitError_Compositor_CreateOverlayIndexBuffer ) \
+	X( VRInitError_Compositor_CreateOverlayVertexBuffer ) \
+	X( VRInitError_Compositor_CreateTextVertexBuffer ) \
+	X( VRInitError_Compositor_CreateTextIndexBuffer ) \
+	X( VRInitError_Compositor_CreateMirrorTextures ) \
+	X( VRInitError_Compositor_CreateLastFrameRenderTexture ) \
+	X( VRInitError_Compositor_CreateMirrorOverlay ) \
+	X( VRInitError_Compositor_FailedToCreateVirtualDisplayBackbuffer ) \
+	X( VRInitError_Compositor_DisplayModeNotSupported ) \
+	X( VRInitError_Compositor_CreateOverlayInvalidCall ) \
+	X( VRInitError_Compositor_CreateOverlayAlreadyInitialized ) \
+	X( VRInitError_Compositor_FailedToCreateMailbox ) \
+	X( VRInitError_Compositor_WindowInterfaceIsNull ) \
+	X( VRInitError_Compositor_SystemLayerCreateInstance ) \
+	X( VRInitError_Compositor_SystemLayerCreateSession ) \
+	X( VRInitError_Compositor_CreateInverseDistortUVs ) \
+	X( VRInitError_Compositor_CreateBackbufferDepth ) \
+	X( VRInitError_Compositor_CannotDRMLeaseDisplay ) \
+	X( VRInitError_Compositor_CannotConnectToDisplayServer ) \
+	X( VRInitError_Compositor_GnomeNoDRMLeasing ) \
+	X( VRInitError_Compositor_FailedToInitializeEncoder ) \
+	X( VRInitError_Compositor_CreateBlurTexture ) \
+	\
+	/* Vendor-specific errors */ \
+	X( VRInitError_VendorSpecific_UnableToConnectToOculusRuntime ) \
+	X( VRInitError_VendorSpecific_WindowsNotInDevMode ) \
+	X( VRInitError_VendorSpecific_OculusLinkNotEnabled ) \
+	X( VRInitError_VendorSpecific_OculusRuntimeBadInstall ) \
+	\
+	/* Lighthouse */ \
+	X( VRInitError_VendorSpecific_HmdFound_CantOpenDevice ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnableToRequestConfigStart ) \
+	X( VRInitError_VendorSpecific_HmdFound_NoStoredConfig ) \
+	X( VRInitError_VendorSpecific_HmdFound_ConfigFailedSanityCheck ) \
+	X( VRInitError_VendorSpecific_HmdFound_ConfigTooBig ) \
+	X( VRInitError_VendorSpecific_HmdFound_ConfigTooSmall ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnableToInitZLib ) \
+	X( VRInitError_VendorSpecific_HmdFound_CantReadFirmwareVersion ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnableToSendUserDataStart ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataStart ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataNext ) \
+	X( VRInitError_VendorSpecific_HmdFound_UserDataAddressRange ) \
+	X( VRInitError_VendorSpecific_HmdFound_UserDataError ) \
+	X( VRInitError_VendorSpecific_HmdFound_UnexpectedConfiguration_1 ) \
+	\
+	X( VRInitError_Steam_SteamInstallationNotFound )
+
+
 const char *GetIDForVRInitError( vr::EVRInitError eError )
 {
 	switch( eError )
 	{
-		RETURN_ENUM_AS_STRING( VRInitError_None );
-		RETURN_ENUM_AS_STRING( VRInitError_Unknown );
-
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InstallationNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InstallationCorrupt );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRClientDLLNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_FileNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_FactoryNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InterfaceNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InvalidInterface );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_UserConfigDirectoryInvalid );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_HmdNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NotInitialized );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PathRegistryNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NoConfigPath );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NoLogPath );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PathRegistryNotWritable );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_AppInfoInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_Retry );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InitCanceledByUser );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_AnotherAppLaunching );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_SettingsInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_ShuttingDown );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_TooManyObjects );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NoServerForBackgroundApp );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NotSupportedWithCompositor );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NotAvailableToUtilityApps );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_Internal );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_HmdDriverIdIsNone );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_HmdNotFoundPresenceFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRMonitorNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRMonitorStartupFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_LowPowerWatchdogNotSupported );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InvalidApplicationType );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NotAvailableToWatchdogApps );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_WatchdogDisabledInSettings );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardStartupFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRHomeNotFound );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRHomeStartupFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_RebootingBusy );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_FirmwareUpdateBusy );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_FirmwareRecoveryBusy );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_USBServiceBusy );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRWebHelperStartupFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_TrackerManagerInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_AlreadyRunning );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_FailedForVrMonitor);
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PropertyManagerInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_WebServerFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_IllegalTypeTransition );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_MismatchedRuntimes );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_InvalidProcessId );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRServiceStartupFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PrismNeedsNewDrivers );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PrismStartupTimedOut );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_CouldNotStartPrism );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PrismClientInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PrismClientStartFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_PrismExitedUnexpectedly );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_BadLuid );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_NoServerForAppContainer );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_DuplicateBootstrapper );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardServicePending );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardServiceTimeout );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardServiceStopped );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardAlreadyStarted );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardCopyFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardTokenFailure );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardEnvironmentFailure );
-		RETURN_ENUM_AS_STRING( VRInitError_Init_VRDashboardPathFailure );
-
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_Failed );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_Unknown );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdUnknown);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_NotLoaded);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_RuntimeOutOfDate);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdInUse);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_NotCalibrated);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_CalibrationInvalid);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdDisplayNotFound);
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_TrackedDeviceInterfaceUnknown );
-		// RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdDisplayNotFoundAfterFix );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdDriverIdOutOfBounds );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdDisplayMirrored );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_HmdDisplayNotFoundLaptop );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_PeerDriverNotInstalled );
-		RETURN_ENUM_AS_STRING( VRInitError_Driver_WirelessHmdNotConnected );
-
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_ServerInitFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_ConnectFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_SharedStateInitFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_CompositorInitFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_MutexInitFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_Failed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_CompositorConnectFailed);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_CompositorInvalidConnectResponse);
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_ConnectFailedAfterMultipleAttempts );
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_ConnectFailedAfterTargetExited );
-		RETURN_ENUM_AS_STRING( VRInitError_IPC_NamespaceUnavailable );
-
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_Failed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_D3D11HardwareRequired );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FirmwareRequiresUpdate );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_OverlayInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_ScreenshotsInitFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_UnableToCreateDevice );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_SharedStateIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_NotificationManagerIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_ResourceManagerClientIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_MessageOverlaySharedStateInitFailure );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_PropertiesInterfaceIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateFullscreenWindowFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_SettingsInterfaceIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToShowWindow );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DistortInterfaceIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DisplayFrequencyFailure );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_RendererInitializationFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DXGIFactoryInterfaceIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DXGIFactoryCreateFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DXGIFactoryQueryFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_InvalidAdapterDesktop );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_InvalidHmdAttachment );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_InvalidOutputDesktop );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_InvalidDeviceProvided );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_D3D11RendererInitializationFailed );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToFindDisplayMode );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateSwapChain );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToGetBackBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateRenderTarget );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateDXGI2SwapChain );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedtoGetDXGI2BackBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateDXGI2RenderTarget );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToGetDXGIDeviceInterface );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_SelectDisplayMode );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateNvAPIRenderTargets );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_NvAPISetDisplayMode );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateDirectModeDisplay );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_InvalidHmdPropertyContainer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_UpdateDisplayFrequency );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateRasterizerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateWireframeRasterizerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateSamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateClampToBorderSamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateAnisoSamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlaySamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreatePanoramaSamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateFontSamplerState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateNoBlendState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBlendState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateAlphaBlendState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBlendStateMaskR );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBlendStateMaskG );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBlendStateMaskB );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateDepthStencilState );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateDepthStencilStateNoWrite );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateDepthStencilStateNoDepth );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateFlushTexture );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateDistortionSurfaces );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateHmdPoseConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateHmdPoseStagingConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateSharedFrameInfoConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlayConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateSceneTextureIndexConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateReadableSceneTextureIndexConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateLayerGraphicsTextureIndexConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateLayerComputeTextureIndexConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateLayerComputeSceneTextureIndexConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateComputeHmdPoseConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateGeomConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreatePanelMaskConstantBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreatePixelSimUBO );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateMSAARenderTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateResolveRenderTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateComputeResolveRenderTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateDriverDirectModeResolveTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_OpenDriverDirectModeResolveTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateFallbackSyncTexture );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_ShareFallbackSyncTexture );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlayIndexBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlayVertexBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateTextVertexBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateTextIndexBuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateMirrorTextures );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateLastFrameRenderTexture );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateMirrorOverlay );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateVirtualDisplayBackbuffer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_DisplayModeNotSupported );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlayInvalidCall );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateOverlayAlreadyInitialized );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToCreateMailbox );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_WindowInterfaceIsNull );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_SystemLayerCreateInstance );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_SystemLayerCreateSession );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateInverseDistortUVs );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBackbufferDepth );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CannotDRMLeaseDisplay );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CannotConnectToDisplayServer );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_GnomeNoDRMLeasing );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_FailedToInitializeEncoder );
-		RETURN_ENUM_AS_STRING( VRInitError_Compositor_CreateBlurTexture );
-
-		// Vendor-specific errors
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_UnableToConnectToOculusRuntime);
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_WindowsNotInDevMode );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_OculusLinkNotEnabled );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_OculusRuntimeBadInstall );
-
-		// Lighthouse
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_CantOpenDevice);
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnableToRequestConfigStart);
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_NoStoredConfig);
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_ConfigFailedSanityCheck );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_ConfigTooBig );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_ConfigTooSmall );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnableToInitZLib );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_CantReadFirmwareVersion );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnableToSendUserDataStart );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataStart );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataNext );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UserDataAddressRange );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UserDataError );
-		RETURN_ENUM_AS_STRING( VRInitError_VendorSpecific_HmdFound_UnexpectedConfiguration_1 );
-
-		RETURN_ENUM_AS_STRING( VRInitError_Steam_SteamInstallationNotFound );
+		VR_INIT_ERROR_IDS( RETURN_ENUM_AS_STRING )
 
 	default:
 		{
@@ -371,3 +381,85 @@ const char *GetIDForVRInitError( vr::EVRInitError eError )
 	}
 }
 
+
+//-----------------------------------------------------------------------------
+// Purpose: Open addressed hash table from ID to EVRInitError, built the
+//			first time it's needed. There are a few hundred IDs, so with the
+//			table kept at most a quarter full a lookup is nearly always a
+//			single string compare.
+//-----------------------------------------------------------------------------
+struct VRInitErrorID_t
+{
+	vr::EVRInitError eError;
+	const char *pchID;
+};
+
+#define VR_INIT_ERROR_ID_ENTRY( enumValue ) { enumValue, #enumValue },
+
+static const VRInitErrorID_t k_rgVRInitErrorIDs[] =
+{
+	VR_INIT_ERROR_IDS( VR_INIT_ERROR_ID_ENTRY )
+};
+
+static const size_t k_unVRInitErrorIDCount = sizeof( k_rgVRInitErrorIDs ) / sizeof( k_rgVRInitErrorIDs[ 0 ] );
+
+static uint32_t HashVRInitErrorID( const char *pchID )
+{
+	// FNV-1a
+	uint32_t unHash = 2166136261u;
+	for ( ; *pchID; pchID++ )
+	{
+		unHash = ( unHash ^ ( uint8_t )*pchID ) * 16777619u;
+	}
+	return unHash;
+}
+
+class CVRInitErrorIDTable
+{
+public:
+	CVRInitErrorIDTable()
+	{
+		m_unMask = 1;
+		while ( m_unMask + 1 < k_unVRInitErrorIDCount * 4 )
+			m_unMask = ( m_unMask << 1 ) | 1;
+
+		m_vecSlots.assign( m_unMask + 1, nullptr );
+		for ( const VRInitErrorID_t & entry : k_rgVRInitErrorIDs )
+		{
+			uint32_t unSlot = HashVRInitErrorID( entry.pchID ) & m_unMask;
+			while ( m_vecSlots[ unSlot ] )
+				unSlot = ( unSlot + 1 ) & m_unMask;
+			m_vecSlots[ unSlot ] = &entry;
+		}
+	}
+
+	const VRInitErrorID_t *Find( const char *pchID ) const
+	{
+		for ( uint32_t unSlot = HashVRInitErrorID( pchID ) & m_unMask; m_vecSlots[ unSlot ]; unSlot = ( unSlot + 1 ) & m_unMask )
+		{
+			if ( !strcmp( m_vecSlots[ unSlot ]->pchID, pchID ) )
+				return m_vecSlots[ unSlot ];
+		}
+		return nullptr;
+	}
+
+private:
+	uint32_t m_unMask;
+	std::vector< const VRInitErrorID_t * > m_vecSlots;
+};
+
+
+bool GetVRInitErrorForID( const char *pchID, vr::EVRInitError *peError )
+{
+	if ( !pchID )
+		return false;
+
+	static const CVRInitErrorIDTable s_table;
+	const VRInitErrorID_t *pEntry = s_table.Find( pchID );
+	if ( !pEntry )
+		return false;
+
+	if ( peError )
+		*peError = pEntry->eError;
+	return true;
+}
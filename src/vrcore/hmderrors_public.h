@@ -4,3 +4,6 @@
 const char *GetEnglishStringForHmdError( vr::EVRInitError eError );
 const char *GetIDForVRInitError( vr::EVRInitError eError );
 
+/** The reverse of GetIDForVRInitError. Returns false if pchID isn't the ID of any EVRInitError. */
+bool GetVRInitErrorForID( const char *pchID, vr::EVRInitError *peError );
+
@@ -1,6 +1,7 @@
 //========= Copyright Valve Corporation ============//
 #include <vrcore/strtools_public.h>
 #include <vrcore/pathtools_public.h>
+#include <vrcore/dirtools_public.h>
 
 #if defined( _WIN32)
 #include <windows.h>
@@ -17,6 +18,9 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <alloca.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
 #endif
 
 #if defined OSX
@@ -27,8 +31,11 @@
 #endif
 
 #include <sys/stat.h>
+#include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
 /** Returns the path (including filename) to the current executable */
 std::string Path_GetExecutablePath()
@@ -119,15 +126,21 @@ std::string Path_GetTemporaryDirectory()
 
 /** Returns the specified path without its filename */
 std::string Path_StripFilename( const std::string & sPath, char slash )
+{
+	return sPath.substr( 0, Path_StripFilenameLength( sPath.c_str(), sPath.length(), slash ) );
+}
+
+size_t Path_StripFilenameLength( const char *pchPath, size_t unLength, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string::size_type n = sPath.find_last_of( slash );
-	if( n == std::string::npos )
-		return sPath;
-	else
-		return std::string( sPath.begin(), sPath.begin() + n );
+	for( size_t n = unLength; n > 0; n-- )
+	{
+		if( pchPath[ n - 1 ] == slash )
+			return n - 1;
+	}
+	return unLength;
 }
 
 /** returns just the filename from the provided full or relative path. */
@@ -228,18 +241,25 @@ std::string Path_MakeAbsolute( const std::string & sRelativePath, const std::str
 
 /** Fixes the directory separators for the current platform */
 std::string Path_FixSlashes( const std::string & sPath, char slash )
+{
+	std::string sFixed = sPath;
+	if( !sFixed.empty() )
+	{
+		Path_FixSlashesInPlace( &sFixed[ 0 ], sFixed.length(), slash );
+	}
+	return sFixed;
+}
+
+void Path_FixSlashesInPlace( char *pchPath, size_t unLength, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string sFixed = sPath;
-	for( std::string::iterator i = sFixed.begin(); i != sFixed.end(); i++ )
+	for( size_t i = 0; i < unLength; i++ )
 	{
-		if( *i == '/' || *i == '\\' )
-			*i = slash;
+		if( pchPath[ i ] == '/' || pchPath[ i ] == '\\' )
+			pchPath[ i ] = slash;
 	}
-
-	return sFixed;
 }
 
 
@@ -254,24 +274,52 @@ char Path_GetSlash()
 
 /** Jams two paths together with the right kind of slash */
 std::string Path_Join( const std::string & first, const std::string & second, char slash )
+{
+	if( first.empty() )
+		return second;
+
+	// the joined path is never longer than both halves plus a slash
+	std::string sJoined;
+	sJoined.resize( first.length() + second.length() + 2 );
+	size_t unJoinedLength = Path_JoinToBuffer( &sJoined[ 0 ], sJoined.length(), first.c_str(), first.length(),
+		second.c_str(), second.length(), slash );
+	sJoined.resize( unJoinedLength );
+	return sJoined;
+}
+
+size_t Path_JoinToBuffer( char *pchBuffer, size_t unBufferSize, const char *pchFirst, size_t unFirstLength,
+	const char *pchSecond, size_t unSecondLength, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
+	size_t unJoinedLength;
+	if( !unFirstLength )
+	{
+		unJoinedLength = unSecondLength;
+		if( unJoinedLength < unBufferSize )
+		{
+			memmove( pchBuffer, pchSecond, unSecondLength );
+			pchBuffer[ unJoinedLength ] = '\0';
+		}
+		return unJoinedLength;
+	}
+
 	// only insert a slash if we don't already have one
-	std::string::size_type nLen = first.length();
-	if( !nLen )
-		return second;
-#if defined(_WIN32)
-	if( first.back() == '\\' || first.back() == '/' )
-	    nLen--;
-#else
-	char last_char = first[first.length()-1];
-	if (last_char == '\\' || last_char == '/')
-	    nLen--;
-#endif
+	char chLast = pchFirst[ unFirstLength - 1 ];
+	if( chLast == '\\' || chLast == '/' )
+		unFirstLength--;
 
-	return first.substr( 0, nLen ) + std::string( 1, slash ) + second;
+	unJoinedLength = unFirstLength + 1 + unSecondLength;
+	if( unJoinedLength < unBufferSize )
+	{
+		// second goes first in case it overlaps the end of the buffer that first is about to be moved into
+		memmove( pchBuffer + unFirstLength + 1, pchSecond, unSecondLength );
+		memmove( pchBuffer, pchFirst, unFirstLength );
+		pchBuffer[ unFirstLength ] = slash;
+		pchBuffer[ unJoinedLength ] = '\0';
+	}
+	return unJoinedLength;
 }
 
 
@@ -298,55 +346,58 @@ std::string Path_Join(
 
 
 std::string Path_RemoveTrailingSlash( const std::string & sRawPath, char slash )
+{
+	return sRawPath.substr( 0, Path_RemoveTrailingSlashLength( sRawPath.c_str(), sRawPath.length(), slash ) );
+}
+
+size_t Path_RemoveTrailingSlashLength( const char *pchPath, size_t unLength, char slash )
 {
 	if ( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string sPath = sRawPath;
-	std::string::size_type nCurrent = sRawPath.length();
-	if ( nCurrent == 0 )
-		return sPath;
-
-	int nLastFound = -1;
-	nCurrent--;
-	while( nCurrent != 0 )
+	// a slash at the very start of the path is never removed
+	while ( unLength > 1 && pchPath[ unLength - 1 ] == slash )
 	{
-		if ( sRawPath[ nCurrent ] == slash )
-		{
-			nLastFound = (int)nCurrent;
-			nCurrent--;
-		}
-		else
-		{
-			break;
-		}
-	}
-		
-	if ( nLastFound >= 0 )
-	{
-		sPath.erase( nLastFound, std::string::npos );
+		unLength--;
 	}
-	
-	return sPath;
+	return unLength;
 }
 
 
 /** Removes redundant <dir>/.. elements in the path. Returns an empty path if the 
 * specified path has a broken number of directories for its number of ..s */
 std::string Path_Compact( const std::string & sRawPath, char slash )
+{
+	std::string sPath = sRawPath;
+	if( !sPath.empty() )
+	{
+		sPath.resize( Path_CompactInPlace( &sPath[ 0 ], sPath.length(), slash ) );
+	}
+	return sPath;
+}
+
+/** Removes unCount characters from the path starting at unStart and returns the new length */
+static size_t EraseFromPath( char *pchPath, size_t unLength, size_t unStart, size_t unCount )
+{
+	if( unCount > unLength - unStart )
+		unCount = unLength - unStart;
+	memmove( pchPath + unStart, pchPath + unStart + unCount, unLength - unStart - unCount );
+	return unLength - unCount;
+}
+
+size_t Path_CompactInPlace( char *pchPath, size_t unLength, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string sPath = Path_FixSlashes( sRawPath, slash );
-	std::string sSlashString( 1, slash );
+	Path_FixSlashesInPlace( pchPath, unLength, slash );
 
 	// strip out all /./
-	for( std::string::size_type i = 0; (i + 3) < sPath.length();  )
+	for( size_t i = 0; (i + 3) < unLength;  )
 	{
-		if( sPath[ i ] == slash && sPath[ i+1 ] == '.' && sPath[ i+2 ] == slash )
+		if( pchPath[ i ] == slash && pchPath[ i+1 ] == '.' && pchPath[ i+2 ] == slash )
 		{
-			sPath.replace( i, 3, sSlashString );
+			unLength = EraseFromPath( pchPath, unLength, i + 1, 2 );
 		}
 		else
 		{
@@ -354,50 +405,46 @@ std::string Path_Compact( const std::string & sRawPath, char slash )
 		}
 	}
 
-
 	// get rid of trailing /. but leave the path separator
-	if( sPath.length() > 2 )
+	if( unLength > 2 )
 	{
-		std::string::size_type len = sPath.length();
-		if( sPath[ len-1 ] == '.'  && sPath[ len-2 ] == slash )
+		if( pchPath[ unLength-1 ] == '.'  && pchPath[ unLength-2 ] == slash )
 		{
-			sPath.pop_back();
-			//Not sure why the following line of code was used for a while.  It causes problems with strlen.
-			//sPath[len-1] = 0;  // for now, at least 
+			unLength--;
 		}
 	}
 
 	// get rid of leading ./ 
-	if( sPath.length() > 2 )
+	if( unLength > 2 )
 	{
-		if( sPath[ 0 ] == '.'  && sPath[ 1 ] == slash )
+		if( pchPath[ 0 ] == '.'  && pchPath[ 1 ] == slash )
 		{
-			sPath.replace( 0, 2, "" );
+			unLength = EraseFromPath( pchPath, unLength, 0, 2 );
 		}
 	}
 
 	// each time we encounter .. back up until we've found the previous directory name
 	// then get rid of both
-	std::string::size_type i = 0;
-	while( i < sPath.length() )
+	size_t i = 0;
+	while( i < unLength )
 	{
-		if( i > 0 && sPath.length() - i >= 2 
-			&& sPath[i] == '.'
-			&& sPath[i+1] == '.'
-			&& ( i + 2 == sPath.length() || sPath[ i+2 ] == slash )
-			&& sPath[ i-1 ] == slash )
+		if( i > 0 && unLength - i >= 2 
+			&& pchPath[i] == '.'
+			&& pchPath[i+1] == '.'
+			&& ( i + 2 == unLength || pchPath[ i+2 ] == slash )
+			&& pchPath[ i-1 ] == slash )
 		{
 			// check if we've hit the start of the string and have a bogus path
 			if( i == 1 )
-				return "";
+				return 0;
 			
 			// find the separator before i-1
-			std::string::size_type iDirStart = i-2;
-			while( iDirStart > 0 && sPath[ iDirStart - 1 ] != slash )
+			size_t iDirStart = i-2;
+			while( iDirStart > 0 && pchPath[ iDirStart - 1 ] != slash )
 				--iDirStart;
 
 			// remove everything from iDirStart to i+2
-			sPath.replace( iDirStart, (i - iDirStart) + 3, "" );
+			unLength = EraseFromPath( pchPath, unLength, iDirStart, (i - iDirStart) + 3 );
 
 			// start over
 			i = 0;
@@ -408,7 +455,7 @@ std::string Path_Compact( const std::string & sRawPath, char slash )
 		}
 	}
 
-	return sPath;
+	return unLength;
 }
 
 
@@ -771,6 +818,200 @@ std::string Path_ReadTextFile( const std::string &strFilename )
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: read-only views of file contents
+//-----------------------------------------------------------------------------
+CMappedFile::CMappedFile()
+	: m_bValid( false )
+	, m_pData( nullptr )
+	, m_unSize( 0 )
+	, m_pMapping( nullptr )
+{
+}
+
+CMappedFile::~CMappedFile()
+{
+	Close();
+}
+
+CMappedFile::CMappedFile( CMappedFile && other )
+	: m_bValid( false )
+	, m_pData( nullptr )
+	, m_unSize( 0 )
+	, m_pMapping( nullptr )
+{
+	*this = std::move( other );
+}
+
+CMappedFile & CMappedFile::operator=( CMappedFile && other )
+{
+	if ( this != &other )
+	{
+		Close();
+
+		m_bValid = other.m_bValid;
+		m_unSize = other.m_unSize;
+		m_pMapping = other.m_pMapping;
+		m_vecBuffer.swap( other.m_vecBuffer );
+		m_pData = m_pMapping ? other.m_pData : ( m_vecBuffer.empty() ? nullptr : &m_vecBuffer[ 0 ] );
+
+		other.m_bValid = false;
+		other.m_pData = nullptr;
+		other.m_unSize = 0;
+		other.m_pMapping = nullptr;
+	}
+	return *this;
+}
+
+void CMappedFile::Close()
+{
+	if ( m_pMapping )
+	{
+#if defined( _WIN32 )
+		UnmapViewOfFile( m_pMapping );
+#else
+		munmap( m_pMapping, m_unSize );
+#endif
+		m_pMapping = nullptr;
+	}
+
+	std::vector<uint8_t>().swap( m_vecBuffer );
+	m_pData = nullptr;
+	m_unSize = 0;
+	m_bValid = false;
+}
+
+
+bool Path_MapFile( const std::string &strFilename, CMappedFile *pMappedFile, uint32_t unHints )
+{
+	if ( !pMappedFile )
+		return false;
+
+	pMappedFile->Close();
+
+#if defined( _WIN32 )
+	std::wstring wstrFilename = UTF8to16( strFilename.c_str() );
+	DWORD dwFlags = FILE_ATTRIBUTE_NORMAL;
+	if ( unHints & k_EPathMapFileHint_Sequential )
+		dwFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+
+	// share everything, to match the _SH_DENYNO used by Path_ReadBinaryFile
+	HANDLE hFile = CreateFileW( wstrFilename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, dwFlags, NULL );
+	if ( hFile == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER liSize;
+	if ( GetFileType( hFile ) == FILE_TYPE_DISK && GetFileSizeEx( hFile, &liSize ) && liSize.QuadPart > 0
+		&& (uint64_t)liSize.QuadPart <= (uint64_t)SIZE_MAX )
+	{
+		HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+		if ( hMapping != NULL )
+		{
+			// the view keeps the file and the mapping object alive after their handles are closed
+			void *pView = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+			CloseHandle( hMapping );
+			if ( pView )
+			{
+				CloseHandle( hFile );
+				pMappedFile->m_pMapping = pView;
+				pMappedFile->m_pData = (const uint8_t *)pView;
+				pMappedFile->m_unSize = (size_t)liSize.QuadPart;
+				pMappedFile->m_bValid = true;
+				return true;
+			}
+		}
+	}
+
+	// not something we can map, so read it until it runs out
+	std::vector<uint8_t> & vecBuffer = pMappedFile->m_vecBuffer;
+	uint8_t rchChunk[ 64 * 1024 ];
+	DWORD dwRead = 0;
+	BOOL bOk;
+	while ( ( bOk = ReadFile( hFile, rchChunk, sizeof( rchChunk ), &dwRead, NULL ) ) && dwRead > 0 )
+	{
+		vecBuffer.insert( vecBuffer.end(), rchChunk, rchChunk + dwRead );
+	}
+	CloseHandle( hFile );
+
+	// a closed pipe reports ERROR_BROKEN_PIPE at the end of the data
+	if ( !bOk && GetLastError() != ERROR_BROKEN_PIPE )
+	{
+		std::vector<uint8_t>().swap( vecBuffer );
+		return false;
+	}
+#else
+	int nFd;
+	do
+	{
+		nFd = open( strFilename.c_str(), O_RDONLY | O_CLOEXEC );
+	} while ( nFd < 0 && errno == EINTR );
+	if ( nFd < 0 )
+		return false;
+
+	struct stat statBuf;
+	if ( fstat( nFd, &statBuf ) != 0 )
+	{
+		close( nFd );
+		return false;
+	}
+
+	// Regular files that claim to be empty may still have contents (procfs and sysfs, for example),
+	// so those are read like pipes
+	if ( S_ISREG( statBuf.st_mode ) && statBuf.st_size > 0 && (uint64_t)statBuf.st_size <= (uint64_t)SIZE_MAX )
+	{
+		size_t unSize = (size_t)statBuf.st_size;
+		void *pMapping = mmap( nullptr, unSize, PROT_READ, MAP_PRIVATE, nFd, 0 );
+		if ( pMapping != MAP_FAILED )
+		{
+			close( nFd );
+
+			if ( unHints & k_EPathMapFileHint_Sequential )
+				madvise( pMapping, unSize, MADV_SEQUENTIAL );
+			if ( unHints & k_EPathMapFileHint_WillNeed )
+				madvise( pMapping, unSize, MADV_WILLNEED );
+
+			pMappedFile->m_pMapping = pMapping;
+			pMappedFile->m_pData = (const uint8_t *)pMapping;
+			pMappedFile->m_unSize = unSize;
+			pMappedFile->m_bValid = true;
+			return true;
+		}
+	}
+
+	// not something we can map, so read it until it runs out
+	std::vector<uint8_t> & vecBuffer = pMappedFile->m_vecBuffer;
+	if ( S_ISREG( statBuf.st_mode ) && statBuf.st_size > 0 && (uint64_t)statBuf.st_size <= (uint64_t)SIZE_MAX )
+	{
+		vecBuffer.reserve( (size_t)statBuf.st_size );
+	}
+
+	uint8_t rchChunk[ 64 * 1024 ];
+	ssize_t nRead;
+	for ( ;; )
+	{
+		nRead = read( nFd, rchChunk, sizeof( rchChunk ) );
+		if ( nRead > 0 )
+			vecBuffer.insert( vecBuffer.end(), rchChunk, rchChunk + nRead );
+		else if ( nRead == 0 || errno != EINTR )
+			break;
+	}
+	close( nFd );
+
+	if ( nRead < 0 )
+	{
+		std::vector<uint8_t>().swap( vecBuffer );
+		return false;
+	}
+#endif
+
+	pMappedFile->m_pData = vecBuffer.empty() ? nullptr : &vecBuffer[ 0 ];
+	pMappedFile->m_unSize = vecBuffer.size();
+	pMappedFile->m_bValid = true;
+	return true;
+}
+
+
 bool Path_MakeWritable( const std::string &strFilename )
 {
 #if defined ( _WIN32 )
@@ -818,11 +1059,17 @@ bool Path_WriteStringToTextFile( const std::string &strFilename, const char *pch
 	return ok;
 }
 
-bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const char *pchData )
+//-----------------------------------------------------------------------------
+// Purpose: Writes a file by calling writeFile on a temporary next to it and
+//			then replacing the file with the temporary. On Windows, if the
+//			replace fails, falls back to calling writeFile on the file itself.
+//-----------------------------------------------------------------------------
+template< typename WriteFile_t >
+static bool Path_WriteFileAtomic( const std::string &strFilename, const WriteFile_t & writeFile )
 {
 	std::string strTmpFilename = strFilename + ".tmp";
 
-	if ( !Path_WriteStringToTextFile( strTmpFilename, pchData ) )
+	if ( !writeFile( strTmpFilename ) )
 		return false;
 
 	// Platform specific atomic file replacement
@@ -832,7 +1079,7 @@ bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const cha
 	if ( !::ReplaceFileW( wsFilename.c_str(), wsTmpFilename.c_str(), nullptr, 0, 0, 0 ) )
 	{
 		// if we couldn't ReplaceFile, try a non-atomic write as a fallback
-		if ( !Path_WriteStringToTextFile( strFilename, pchData ) )
+		if ( !writeFile( strFilename ) )
 			return false;
 	}
 #elif defined( POSIX )
@@ -845,6 +1092,17 @@ bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const cha
 	return true;
 }
 
+bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const char *pchData )
+{
+	return Path_WriteFileAtomic( strFilename, [pchData]( const std::string &strPath ) { return Path_WriteStringToTextFile( strPath, pchData ); } );
+}
+
+/** Same as Path_WriteStringToTextFileAtomic, but writes the data exactly as it is */
+bool Path_WriteBinaryFileAtomic( const std::string &strFilename, unsigned char *pData, unsigned nSize )
+{
+	return Path_WriteFileAtomic( strFilename, [pData, nSize]( const std::string &strPath ) { return Path_WriteBinaryFile( strPath, pData, nSize ); } );
+}
+
 
 #if defined(WIN32)
 #define FILE_URL_PREFIX "file:///"
@@ -872,11 +1130,7 @@ std::string Path_FilePathToUrl( const std::string & sRelativePath, const std::st
 			return sAbsolute;
 		sAbsolute = Path_FixSlashes( sAbsolute, '/' );
 
-		size_t unBufferSize = sAbsolute.length() * 3;
-		char *pchBuffer = (char *)alloca( unBufferSize );
-		V_URLEncodeFullPath( pchBuffer, (int)unBufferSize, sAbsolute.c_str(), (int)sAbsolute.length() );
-
-		return std::string( FILE_URL_PREFIX ) + pchBuffer;
+		return FILE_URL_PREFIX + V_URLEncodeFullPath( sAbsolute );
 	}
 }
 
@@ -887,11 +1141,18 @@ std::string Path_UrlToFilePath( const std::string & sFileUrl )
 {
 	if ( !strnicmp( sFileUrl.c_str(), FILE_URL_PREFIX, strlen( FILE_URL_PREFIX ) ) )
 	{
-		char *pchBuffer = (char *)alloca( sFileUrl.length() );
-		V_URLDecodeNoPlusForSpace( pchBuffer, (int)sFileUrl.length(), 
-			sFileUrl.c_str() + strlen( FILE_URL_PREFIX ), (int)( sFileUrl.length() - strlen( FILE_URL_PREFIX ) ) );
+		// the prefix has nothing to decode, so decoding the whole URL saves copying the rest out first
+		std::string sPath = V_URLDecodeNoPlusForSpace( sFileUrl );
+		sPath.erase( 0, strlen( FILE_URL_PREFIX ) );
 
-		return Path_FixSlashes( pchBuffer );
+		// a decoded %00 ends the path
+		size_t nNull = sPath.find( '\0' );
+		if ( nNull != std::string::npos )
+			sPath.resize( nNull );
+
+		if ( !sPath.empty() )
+			Path_FixSlashesInPlace( &sPath[ 0 ], sPath.length() );
+		return sPath;
 	}
 	else
 	{
@@ -1065,7 +1326,71 @@ bool Path_DeleteDirectory( const std::string &sDirectoryPath, bool bDeleteSubdir
 
 	return true;
 #else
-	return false;
+	// Files are unlinked in parallel as the walk visits them, which is safe because the
+	// walker has already read each directory to the end. Directories can only be removed
+	// once they are empty, so they are collected and removed deepest first after the walk
+	// is done. Symlinks are unlinked, never followed, and a root that is one fails. An
+	// unlinkat or rmdir that fails part way through leaves the tree partly deleted, as
+	// on Windows.
+	if ( !bDeleteSubdirectories )
+	{
+		// a subdirectory fails the whole call, so look for one before anything is unlinked
+		// rather than finding it after some of the files are already gone
+		bool bHasSubdirectory = false;
+		if ( !BWalkDirectoryTree( sDirectoryPath.c_str(), nullptr, 0, 1,
+			[&]( const DirectoryTreeEntry_t & entry ) -> EDirectoryTreeWalkResult
+			{
+				if ( !entry.bIsDirectory )
+					return k_EDirectoryTreeWalk_Continue;
+				bHasSubdirectory = true;
+				return k_EDirectoryTreeWalk_Stop;
+			} ) || bHasSubdirectory )
+		{
+			return false;
+		}
+	}
+
+	std::mutex mutexDirectories;
+	std::vector< std::pair< uint32_t, std::string > > vecDirectories;
+	std::atomic< bool > bFailed( false );
+
+	bool bWalked = BWalkDirectoryTree( sDirectoryPath.c_str(), nullptr,
+		bDeleteSubdirectories ? k_unDirectoryTreeUnlimitedDepth : 0, 0,
+		[&]( const DirectoryTreeEntry_t & entry ) -> EDirectoryTreeWalkResult
+		{
+			if ( entry.bIsDirectory )
+			{
+				if ( !bDeleteSubdirectories )
+				{
+					bFailed = true;
+					return k_EDirectoryTreeWalk_Stop;
+				}
+
+				std::lock_guard< std::mutex > lock( mutexDirectories );
+				vecDirectories.push_back( std::make_pair( entry.unDepth, Path_Join( entry.pchDirectoryPath, entry.pchName, '/' ) ) );
+				return k_EDirectoryTreeWalk_Continue;
+			}
+
+			if ( unlinkat( entry.nDirectoryFd, entry.pchName, 0 ) != 0 )
+			{
+				bFailed = true;
+				return k_EDirectoryTreeWalk_Stop;
+			}
+			return k_EDirectoryTreeWalk_Continue;
+		} );
+
+	if ( !bWalked || bFailed )
+		return false;
+
+	std::sort( vecDirectories.begin(), vecDirectories.end(),
+		[]( const std::pair< uint32_t, std::string > & lhs, const std::pair< uint32_t, std::string > & rhs ) { return lhs.first > rhs.first; } );
+	for ( size_t i = 0; i < vecDirectories.size(); i++ )
+	{
+		if ( rmdir( Path_Join( sDirectoryPath, vecDirectories[ i ].second, '/' ).c_str() ) != 0 )
+			return false;
+	}
+
+	return rmdir( sDirectoryPath.c_str() ) == 0;
 #endif
 }
 
@@ -75,6 +75,31 @@ bool Path_IsSamePath( const std::string & sPath1, const std::string & sPath2 );
 //** Removed trailing slashes */
 std::string Path_RemoveTrailingSlash( const std::string & sRawPath, char slash = 0 );
 
+/** Allocation-free versions of the functions above. They work on a pointer and length and
+* either modify the path in place or return the length of the part of it that should be kept,
+* so a caller can run them on a stack buffer without creating any strings.
+* If slash is unspecified the native path separator of the current platform will be used. */
+
+/** Returns the length of the path without its filename, so it is always a prefix of pchPath */
+size_t Path_StripFilenameLength( const char *pchPath, size_t unLength, char slash = 0 );
+
+/** Returns the length of the path without trailing slashes */
+size_t Path_RemoveTrailingSlashLength( const char *pchPath, size_t unLength, char slash = 0 );
+
+/** Replaces every directory separator in the path with slash */
+void Path_FixSlashesInPlace( char *pchPath, size_t unLength, char slash = 0 );
+
+/** Compacts the path in place the way Path_Compact does and returns its new length. The
+* result is not null terminated. Returns 0 if the path has more ..s than directories. */
+size_t Path_CompactInPlace( char *pchPath, size_t unLength, char slash = 0 );
+
+/** Joins two paths into pchBuffer the way Path_Join does. Returns the length of the joined path,
+* not counting the null terminator. If that is not less than unBufferSize nothing is written and
+* the caller should retry with a larger buffer. pchFirst may point at pchBuffer, so longer paths
+* can be built up in place one element at a time. */
+size_t Path_JoinToBuffer( char *pchBuffer, size_t unBufferSize, const char *pchFirst, size_t unFirstLength,
+	const char *pchSecond, size_t unSecondLength, char slash = 0 );
+
 /** returns true if the specified path exists and is a directory */
 bool Path_IsDirectory( const std::string & sPath );
 
@@ -99,6 +124,57 @@ bool Path_WriteBinaryFile( const std::string &strFilename, unsigned char *pData,
 std::string Path_ReadTextFile( const std::string &strFilename );
 bool Path_WriteStringToTextFile( const std::string &strFilename, const char *pchData );
 bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const char *pchData );
+bool Path_WriteBinaryFileAtomic( const std::string &strFilename, unsigned char *pData, unsigned nSize );
+
+/** Access hints for Path_MapFile. These are only advice to the OS and may be ignored. */
+enum EPathMapFileHint
+{
+	k_EPathMapFileHint_None			= 0,
+	k_EPathMapFileHint_Sequential	= 1 << 0,	// data will be read front to back
+	k_EPathMapFileHint_WillNeed		= 1 << 1,	// start paging the whole file in now
+};
+
+/** A read-only view of the contents of a file, filled in by Path_MapFile. Regular files are
+* mapped into memory so reading them does not copy the data. Pipes and other special files
+* can't be mapped and are read into a buffer owned by the view instead. The data stays
+* valid until the view is closed or destroyed. */
+class CMappedFile
+{
+public:
+	CMappedFile();
+	~CMappedFile();
+
+	CMappedFile( CMappedFile && other );
+	CMappedFile & operator=( CMappedFile && other );
+
+	/** Releases the mapping or buffer. The view is empty afterward. */
+	void Close();
+
+	/** Returns true if a file is open in this view. Empty files are valid but have no data. */
+	bool IsValid() const { return m_bValid; }
+
+	/** Returns true if the data is mapped from the file rather than copied into a buffer */
+	bool IsMapped() const { return m_pMapping != nullptr; }
+
+	const uint8_t *GetData() const { return m_pData; }
+	size_t GetSize() const { return m_unSize; }
+
+private:
+	CMappedFile( const CMappedFile & ) = delete;
+	CMappedFile & operator=( const CMappedFile & ) = delete;
+
+	friend bool Path_MapFile( const std::string &strFilename, CMappedFile *pMappedFile, uint32_t unHints );
+
+	bool m_bValid;
+	const uint8_t *m_pData;
+	size_t m_unSize;
+	void *m_pMapping;
+	std::vector<uint8_t> m_vecBuffer;
+};
+
+/** Opens a read-only view of the file. unHints is a combination of EPathMapFileHint values.
+* Returns false if the file could not be opened or read. */
+bool Path_MapFile( const std::string &strFilename, CMappedFile *pMappedFile, uint32_t unHints = k_EPathMapFileHint_None );
 
 /** Returns a file:// url for paths, or an http or https url if that's what was provided */
 std::string Path_FilePathToUrl( const std::string & sRelativePath, const std::string & sBasePath );
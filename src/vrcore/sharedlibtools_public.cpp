@@ -1,6 +1,13 @@
 //========= Copyright Valve Corporation ============//
 #include <vrcore/sharedlibtools_public.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -8,17 +15,23 @@
 
 #if defined(POSIX)
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
-SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr )
+SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr, ESharedLibBinding eBinding )
 {
 	SharedLibHandle pHandle = nullptr;
+#if defined(POSIX)
+	int nBindingFlag = eBinding == k_ESharedLibBinding_Lazy ? RTLD_LAZY : RTLD_NOW;
+#endif
 #if defined( _WIN32)
 	pHandle = ( SharedLibHandle )LoadLibraryEx( pchPath, NULL, LOAD_WITH_ALTERED_SEARCH_PATH );
 #elif defined(LINUXARM64)	
-	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|RTLD_DEEPBIND|RTLD_NOW );
+	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|RTLD_DEEPBIND|nBindingFlag );
 #elif defined(POSIX)
-	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|RTLD_NOW );
+	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|nBindingFlag );
 #endif
 
 	if ( pHandle == nullptr && pErrStr )
@@ -48,10 +61,117 @@ void *SharedLib_GetFunction( SharedLibHandle lib, const char *pchFunctionName)
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Results of SharedLib_GetFunctions for one table. The names and 
+//			optional flags are kept to notice a table address being reused for
+//			different symbols, or a table being changed between calls.
+//-----------------------------------------------------------------------------
+struct SharedLibSymbolCache_t
+{
+	const SharedLibSymbol_t *pSymbols;
+	std::vector< const char * > vecNames;
+	std::vector< bool > vecOptional;
+	std::vector< void * > vecFunctions;
+	bool bSuccess;
+	std::string sError;
+};
+
+// Tables on the stack get a new address, and so a new entry, each time. Capping the entries per
+// library keeps that from growing without bound; past the cap the oldest entry is dropped.
+static const size_t k_unMaxSymbolCachesPerLib = 32;
+
+static std::mutex s_symbolCacheMutex;
+static std::unordered_map< SharedLibHandle, std::deque< SharedLibSymbolCache_t > > s_mapSymbolCaches;
+
+static bool BCacheMatches( const SharedLibSymbolCache_t & cache, const SharedLibSymbol_t *pSymbols, size_t unSymbolCount )
+{
+	if ( cache.pSymbols != pSymbols || cache.vecNames.size() != unSymbolCount )
+		return false;
+
+	for ( size_t i = 0; i < unSymbolCount; i++ )
+	{
+		if ( cache.vecNames[ i ] != pSymbols[ i ].pchName || cache.vecOptional[ i ] != pSymbols[ i ].bOptional )
+			return false;
+	}
+	return true;
+}
+
+
+bool SharedLib_GetFunctions( SharedLibHandle lib, const SharedLibSymbol_t *pSymbols, size_t unSymbolCount, std::string *pErrStr )
+{
+	std::lock_guard< std::mutex > lock( s_symbolCacheMutex );
+
+	std::deque< SharedLibSymbolCache_t > & dequeCaches = s_mapSymbolCaches[ lib ];
+	for ( const SharedLibSymbolCache_t & cache : dequeCaches )
+	{
+		if ( !BCacheMatches( cache, pSymbols, unSymbolCount ) )
+			continue;
+
+		for ( size_t i = 0; i < unSymbolCount; i++ )
+		{
+			*pSymbols[ i ].ppFunction = cache.vecFunctions[ i ];
+		}
+		if ( pErrStr )
+			*pErrStr = cache.sError;
+		return cache.bSuccess;
+	}
+
+	SharedLibSymbolCache_t cache;
+	cache.pSymbols = pSymbols;
+	cache.vecNames.resize( unSymbolCount );
+	cache.vecOptional.resize( unSymbolCount );
+	cache.vecFunctions.resize( unSymbolCount );
+	cache.bSuccess = true;
+
+	for ( size_t i = 0; i < unSymbolCount; i++ )
+	{
+#if defined(POSIX)
+		// clear any stale error so a missing symbol can be told apart from one whose value is NULL
+		dlerror();
+#endif
+		void *pFunction = SharedLib_GetFunction( lib, pSymbols[ i ].pchName );
+		cache.vecNames[ i ] = pSymbols[ i ].pchName;
+		cache.vecOptional[ i ] = pSymbols[ i ].bOptional;
+		cache.vecFunctions[ i ] = pFunction;
+		*pSymbols[ i ].ppFunction = pFunction;
+		if ( pFunction || pSymbols[ i ].bOptional )
+			continue;
+
+		cache.bSuccess = false;
+		if ( !cache.sError.empty() )
+			cache.sError += "; ";
+		cache.sError += pSymbols[ i ].pchName;
+#if defined( _WIN32)
+		cache.sError += ": " + std::to_string( GetLastError() );
+#elif defined(POSIX)
+		char *pErr = dlerror();
+		cache.sError += ": ";
+		cache.sError += pErr ? pErr : "symbol is NULL";
+#endif
+	}
+
+	if ( pErrStr )
+		*pErrStr = cache.sError;
+
+	bool bSuccess = cache.bSuccess;
+	if ( dequeCaches.size() >= k_unMaxSymbolCachesPerLib )
+		dequeCaches.pop_front();
+	dequeCaches.push_back( std::move( cache ) );
+	return bSuccess;
+}
+
+
 void SharedLib_Unload( SharedLibHandle lib )
 {
 	if ( !lib )
 		return;
+
+	{
+		// a later load can get the same handle back for a different mapping
+		std::lock_guard< std::mutex > lock( s_symbolCacheMutex );
+		s_mapSymbolCaches.erase( lib );
+	}
+
 #if defined( _WIN32)
 	FreeLibrary( (HMODULE)lib );
 #elif defined(POSIX)
@@ -60,3 +180,60 @@ void SharedLib_Unload( SharedLibHandle lib )
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Pulls a library file into the page cache ahead of loading it, so
+//			the loader's page faults don't each wait on the disk
+//-----------------------------------------------------------------------------
+static void PrefetchSharedLib( const std::string & sPath )
+{
+#if defined( LINUX )
+	// dlopen searches the library path for bare names, so only prefetch real paths
+	if ( sPath.find( '/' ) == std::string::npos )
+		return;
+
+	int fd = open( sPath.c_str(), O_RDONLY | O_CLOEXEC );
+	if ( fd < 0 )
+		return;
+
+	struct stat st;
+	if ( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) )
+		readahead( fd, 0, st.st_size );
+	close( fd );
+#endif
+}
+
+
+std::vector< SharedLibLoadResult_t > SharedLib_LoadMultiple( const std::vector< std::string > & vecPaths, ESharedLibBinding eBinding, uint32_t unThreadCount )
+{
+	std::vector< SharedLibLoadResult_t > vecResults( vecPaths.size() );
+
+	if ( unThreadCount == 0 )
+		unThreadCount = std::min( std::max( std::thread::hardware_concurrency(), 1u ), 4u );
+	unThreadCount = ( uint32_t )std::min< size_t >( unThreadCount, vecPaths.size() );
+
+	// workers take the next path until there are none left. The load error
+	// state (dlerror, GetLastError) is per thread, so each error stays with its library.
+	std::atomic< size_t > unNextPath( 0 );
+	auto fnWorker = [ & ]()
+	{
+		for ( size_t i = unNextPath++; i < vecPaths.size(); i = unNextPath++ )
+		{
+			PrefetchSharedLib( vecPaths[ i ] );
+			vecResults[ i ].lib = SharedLib_Load( vecPaths[ i ].c_str(), &vecResults[ i ].sError, eBinding );
+		}
+	};
+
+	std::vector< std::thread > vecThreads;
+	for ( uint32_t unThread = 1; unThread < unThreadCount; unThread++ )
+	{
+		vecThreads.emplace_back( fnWorker );
+	}
+	fnWorker();
+
+	for ( std::thread & thread : vecThreads )
+	{
+		thread.join();
+	}
+
+	return vecResults;
+}
@@ -1,13 +1,64 @@
 //========= Copyright Valve Corporation ============//
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 typedef void *SharedLibHandle;
 
-SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr = nullptr );
+/** When a library's own imports are bound. Ignored on Windows, which always binds them at load. */
+enum ESharedLibBinding
+{
+	k_ESharedLibBinding_Now,	// bind everything at load, so missing imports fail the load
+	k_ESharedLibBinding_Lazy,	// bind functions on first call
+};
+
+SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr = nullptr, ESharedLibBinding eBinding = k_ESharedLibBinding_Now );
 void *SharedLib_GetFunction( SharedLibHandle lib, const char *pchFunctionName);
 void SharedLib_Unload( SharedLibHandle lib );
 
+/** One entry in a table of symbols for SharedLib_GetFunctions */
+struct SharedLibSymbol_t
+{
+	const char *pchName;
+	void **ppFunction;	// receives the address, or NULL if the symbol isn't found
+	bool bOptional;		// a missing optional symbol doesn't fail the batch
+};
+
+/** Builds a SharedLibSymbol_t that fills in a typed function pointer */
+template< typename T >
+inline SharedLibSymbol_t SharedLibSymbol( const char *pchName, T **ppFunction, bool bOptional = false )
+{
+	SharedLibSymbol_t symbol = { pchName, reinterpret_cast< void ** >( ppFunction ), bOptional };
+	return symbol;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Resolves every symbol in the table, filling in each ppFunction.
+//			Returns false if any required symbol is missing, and lists each
+//			one that is (with the loader's reason) in pErrStr. The results are
+//			cached against the library and the table, so the table should be
+//			static; resolving the same table again is just a copy until the
+//			library is unloaded with SharedLib_Unload. Only the most recently
+//			resolved few dozen tables are remembered for each library.
+//-----------------------------------------------------------------------------
+bool SharedLib_GetFunctions( SharedLibHandle lib, const SharedLibSymbol_t *pSymbols, size_t unSymbolCount, std::string *pErrStr = nullptr );
+
+/** The result of loading one library with SharedLib_LoadMultiple */
+struct SharedLibLoadResult_t
+{
+	SharedLibHandle lib;	// NULL if the library failed to load
+	std::string sError;
+};
 
+//-----------------------------------------------------------------------------
+// Purpose: Loads several libraries at once on a small pool of threads. Where
+//			the platform supports it each library file is read ahead into the
+//			page cache before it is loaded, so the disk reads for one library
+//			overlap with loading another. Results are returned in the same
+//			order as the paths. unThreadCount of 0 picks a default.
+//-----------------------------------------------------------------------------
+std::vector< SharedLibLoadResult_t > SharedLib_LoadMultiple( const std::vector< std::string > & vecPaths,
+	ESharedLibBinding eBinding = k_ESharedLibBinding_Now, uint32_t unThreadCount = 0 );
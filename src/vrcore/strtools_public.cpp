@@ -3,13 +3,15 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <sstream>
+#include <ctype.h>
+#include <wchar.h>
 #include <codecvt>
 #include <iostream>
 #include <functional>
 #include <locale>
 #include <codecvt>
 #include <cstdarg>
+#include <cmath>
 
 #if !defined( VRCORE_NO_PLATFORM )
 #include <vrcore/assert.h>
@@ -21,6 +23,11 @@
 #include <windows.h>
 #endif
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define VRCORE_STRTOOLS_SSE2
+#endif
+
 #if defined( OSX ) || defined( LINUX )
 //-----------------------------------------------------------------------------
 // Purpose:  stricmp -> strcasecmp bridge
@@ -61,9 +68,7 @@ bool StringHasSuffix( const std::string &sString, const std::string &sSuffix )
 	if ( cSuffixLen > cStrLen )
 		return false;
 
-	std::string sStringSuffix = sString.substr( cStrLen - cSuffixLen, cSuffixLen );
-
-	return 0 == stricmp( sStringSuffix.c_str(), sSuffix.c_str() );
+	return 0 == stricmp( sString.c_str() + cStrLen - cSuffixLen, sSuffix.c_str() );
 }
 
 bool StringHasSuffixCaseSensitive( const std::string &sString, const std::string &sSuffix )
@@ -74,9 +79,7 @@ bool StringHasSuffixCaseSensitive( const std::string &sString, const std::string
 	if ( cSuffixLen > cStrLen )
 		return false;
 
-	std::string sStringSuffix = sString.substr( cStrLen - cSuffixLen, cSuffixLen );
-
-	return 0 == strncmp( sStringSuffix.c_str(), sSuffix.c_str(),cSuffixLen );
+	return 0 == strncmp( sString.c_str() + cStrLen - cSuffixLen, sSuffix.c_str(), cSuffixLen );
 }
 
 std::string StringReplace( const std::string &sModify, const std::string &sFind, const std::string &sReplace )
@@ -96,20 +99,275 @@ std::string StringReplace( const std::string &sModify, const std::string &sFind,
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Converts a UTF-16 formatted string to a UTF-8 formatted string
+// Purpose: Decodes one multi-byte UTF-8 sequence, rejecting overlong forms,
+// surrogates and anything past U+10FFFF. Returns the length of the sequence,
+// or 0 if it isn't valid. Each length is decoded on its own, without a loop
+// over the trail bytes, since this runs once per character of non-ASCII text.
 //-----------------------------------------------------------------------------
-std::string UTF16to8( const std::wstring &in )
+static inline size_t DecodeUTF8Sequence( const uint8_t *pIn, const uint8_t *pInEnd, uint32_t *punCodePoint )
 {
-	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
+	uint32_t unLead = *pIn;
+	size_t unAvailable = ( size_t )( pInEnd - pIn );
+	if ( unLead >= 0xC2 && unLead <= 0xDF )
+	{
+		if ( unAvailable < 2 || ( pIn[ 1 ] & 0xC0 ) != 0x80 )
+			return 0;
+		*punCodePoint = ( ( unLead & 0x1F ) << 6 ) | ( pIn[ 1 ] & 0x3F );
+		return 2;
+	}
 
-	try
+	if ( unLead >= 0xE0 && unLead <= 0xEF )
 	{
-		return s_convert.to_bytes( in );
+		if ( unAvailable < 3 || ( pIn[ 1 ] & 0xC0 ) != 0x80 || ( pIn[ 2 ] & 0xC0 ) != 0x80 )
+			return 0;
+		uint32_t unCodePoint = ( ( unLead & 0x0F ) << 12 ) | ( ( pIn[ 1 ] & 0x3F ) << 6 ) | ( pIn[ 2 ] & 0x3F );
+		// overlong, or a surrogate
+		if ( unCodePoint < 0x800 || ( unCodePoint >= 0xD800 && unCodePoint <= 0xDFFF ) )
+			return 0;
+		*punCodePoint = unCodePoint;
+		return 3;
 	}
-	catch ( ... )
+
+	if ( unLead >= 0xF0 && unLead <= 0xF4 )
 	{
-		return std::string();
+		if ( unAvailable < 4 || ( pIn[ 1 ] & 0xC0 ) != 0x80 || ( pIn[ 2 ] & 0xC0 ) != 0x80 || ( pIn[ 3 ] & 0xC0 ) != 0x80 )
+			return 0;
+		uint32_t unCodePoint = ( ( unLead & 0x07 ) << 18 ) | ( ( pIn[ 1 ] & 0x3F ) << 12 ) | ( ( pIn[ 2 ] & 0x3F ) << 6 ) | ( pIn[ 3 ] & 0x3F );
+		// overlong, or past U+10FFFF
+		if ( unCodePoint < 0x10000 || unCodePoint > 0x10FFFF )
+			return 0;
+		*punCodePoint = unCodePoint;
+		return 4;
+	}
+
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts UTF-8 to UTF-16. Runs of ASCII are widened 16 bytes at a
+// time where SSE2 is available. Everything else is decoded one code point at
+// a time.
+//-----------------------------------------------------------------------------
+bool UTF8to16Buffer( const char *pchIn, size_t unInLength, wchar_t *pwchOut, size_t unOutCapacity, size_t *punOutLength )
+{
+	const uint8_t *pIn = ( const uint8_t * )pchIn;
+	const uint8_t *pInEnd = pIn + unInLength;
+	wchar_t *pOut = pwchOut;
+	wchar_t *pOutEnd = pwchOut + unOutCapacity;
+
+	while ( pIn < pInEnd )
+	{
+#if defined( VRCORE_STRTOOLS_SSE2 )
+		while ( pInEnd - pIn >= 16 && pOutEnd - pOut >= 16 )
+		{
+			__m128i vBytes = _mm_loadu_si128( ( const __m128i * )pIn );
+			if ( _mm_movemask_epi8( vBytes ) != 0 )
+				break;
+
+			const __m128i vZero = _mm_setzero_si128();
+			__m128i vLow = _mm_unpacklo_epi8( vBytes, vZero );
+			__m128i vHigh = _mm_unpackhi_epi8( vBytes, vZero );
+			if ( sizeof( wchar_t ) == 2 )
+			{
+				_mm_storeu_si128( ( __m128i * )pOut, vLow );
+				_mm_storeu_si128( ( __m128i * )( pOut + 8 ), vHigh );
+			}
+			else
+			{
+				_mm_storeu_si128( ( __m128i * )pOut, _mm_unpacklo_epi16( vLow, vZero ) );
+				_mm_storeu_si128( ( __m128i * )( pOut + 4 ), _mm_unpackhi_epi16( vLow, vZero ) );
+				_mm_storeu_si128( ( __m128i * )( pOut + 8 ), _mm_unpacklo_epi16( vHigh, vZero ) );
+				_mm_storeu_si128( ( __m128i * )( pOut + 12 ), _mm_unpackhi_epi16( vHigh, vZero ) );
+			}
+			pIn += 16;
+			pOut += 16;
+		}
+		if ( pIn == pInEnd )
+			break;
+
+		// Decode at least the next block one at a time before looking for ASCII again,
+		// so text with scattered non-ASCII characters doesn't retry the SIMD path for each one
+		const uint8_t *pBlockEnd = pInEnd - pIn > 16 ? pIn + 16 : pInEnd;
+#else
+		const uint8_t *pBlockEnd = pInEnd;
+#endif
+		while ( pIn < pBlockEnd )
+		{
+			uint32_t unLead = *pIn;
+			if ( unLead < 0x80 )
+			{
+				if ( pOut == pOutEnd )
+					return false;
+				*pOut++ = ( wchar_t )unLead;
+				pIn++;
+				continue;
+			}
+
+			uint32_t unCodePoint;
+			size_t unSequenceLength = DecodeUTF8Sequence( pIn, pInEnd, &unCodePoint );
+			if ( !unSequenceLength )
+				return false;
+			pIn += unSequenceLength;
+
+			if ( unCodePoint < 0x10000 )
+			{
+				if ( pOut == pOutEnd )
+					return false;
+				*pOut++ = ( wchar_t )unCodePoint;
+			}
+			else
+			{
+				if ( pOutEnd - pOut < 2 )
+					return false;
+				unCodePoint -= 0x10000;
+				*pOut++ = ( wchar_t )( 0xD800 + ( unCodePoint >> 10 ) );
+				*pOut++ = ( wchar_t )( 0xDC00 + ( unCodePoint & 0x3FF ) );
+			}
+		}
 	}
+
+	if ( punOutLength )
+		*punOutLength = pOut - pwchOut;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts UTF-16 to UTF-8. Runs of ASCII are narrowed 16 code units
+// at a time where SSE2 is available. Unpaired surrogates are rejected.
+//-----------------------------------------------------------------------------
+bool UTF16to8Buffer( const wchar_t *pwchIn, size_t unInLength, char *pchOut, size_t unOutCapacity, size_t *punOutLength )
+{
+	const wchar_t *pIn = pwchIn;
+	const wchar_t *pInEnd = pwchIn + unInLength;
+	uint8_t *pOut = ( uint8_t * )pchOut;
+	uint8_t *pOutEnd = pOut + unOutCapacity;
+
+	while ( pIn < pInEnd )
+	{
+#if defined( VRCORE_STRTOOLS_SSE2 )
+		while ( pInEnd - pIn >= 16 && pOutEnd - pOut >= 16 )
+		{
+			__m128i vBytes;
+			if ( sizeof( wchar_t ) == 2 )
+			{
+				__m128i v0 = _mm_loadu_si128( ( const __m128i * )pIn );
+				__m128i v1 = _mm_loadu_si128( ( const __m128i * )( pIn + 8 ) );
+				const __m128i vNotAscii = _mm_set1_epi16( ( short )0xFF80 );
+				__m128i vHighBits = _mm_and_si128( _mm_or_si128( v0, v1 ), vNotAscii );
+				if ( _mm_movemask_epi8( _mm_cmpeq_epi16( vHighBits, _mm_setzero_si128() ) ) != 0xFFFF )
+					break;
+				vBytes = _mm_packus_epi16( v0, v1 );
+			}
+			else
+			{
+				__m128i v0 = _mm_loadu_si128( ( const __m128i * )pIn );
+				__m128i v1 = _mm_loadu_si128( ( const __m128i * )( pIn + 4 ) );
+				__m128i v2 = _mm_loadu_si128( ( const __m128i * )( pIn + 8 ) );
+				__m128i v3 = _mm_loadu_si128( ( const __m128i * )( pIn + 12 ) );
+				const __m128i vNotAscii = _mm_set1_epi32( ( int )0xFFFFFF80 );
+				__m128i vHighBits = _mm_and_si128( _mm_or_si128( _mm_or_si128( v0, v1 ), _mm_or_si128( v2, v3 ) ), vNotAscii );
+				if ( _mm_movemask_epi8( _mm_cmpeq_epi32( vHighBits, _mm_setzero_si128() ) ) != 0xFFFF )
+					break;
+				vBytes = _mm_packus_epi16( _mm_packs_epi32( v0, v1 ), _mm_packs_epi32( v2, v3 ) );
+			}
+			_mm_storeu_si128( ( __m128i * )pOut, vBytes );
+			pIn += 16;
+			pOut += 16;
+		}
+		if ( pIn == pInEnd )
+			break;
+
+		// see UTF8to16Buffer
+		const wchar_t *pBlockEnd = pInEnd - pIn > 16 ? pIn + 16 : pInEnd;
+#else
+		const wchar_t *pBlockEnd = pInEnd;
+#endif
+		while ( pIn < pBlockEnd )
+		{
+			uint32_t unCodePoint = ( uint32_t )*pIn++;
+			if ( sizeof( wchar_t ) == 2 )
+				unCodePoint &= 0xFFFF;
+
+			if ( unCodePoint >= 0xD800 && unCodePoint <= 0xDFFF )
+			{
+				if ( unCodePoint > 0xDBFF || pIn == pInEnd )
+					return false;
+
+				uint32_t unLow = ( uint32_t )*pIn;
+				if ( sizeof( wchar_t ) == 2 )
+					unLow &= 0xFFFF;
+				if ( unLow < 0xDC00 || unLow > 0xDFFF )
+					return false;
+				pIn++;
+
+				unCodePoint = 0x10000 + ( ( unCodePoint - 0xD800 ) << 10 ) + ( unLow - 0xDC00 );
+			}
+			else if ( unCodePoint > 0x10FFFF )
+			{
+				return false;
+			}
+
+			if ( unCodePoint < 0x80 )
+			{
+				if ( pOut == pOutEnd )
+					return false;
+				*pOut++ = ( uint8_t )unCodePoint;
+			}
+			else if ( unCodePoint < 0x800 )
+			{
+				if ( pOutEnd - pOut < 2 )
+					return false;
+				*pOut++ = ( uint8_t )( 0xC0 | ( unCodePoint >> 6 ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( unCodePoint & 0x3F ) );
+			}
+			else if ( unCodePoint < 0x10000 )
+			{
+				if ( pOutEnd - pOut < 3 )
+					return false;
+				*pOut++ = ( uint8_t )( 0xE0 | ( unCodePoint >> 12 ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( unCodePoint & 0x3F ) );
+			}
+			else
+			{
+				if ( pOutEnd - pOut < 4 )
+					return false;
+				*pOut++ = ( uint8_t )( 0xF0 | ( unCodePoint >> 18 ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( ( unCodePoint >> 12 ) & 0x3F ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) );
+				*pOut++ = ( uint8_t )( 0x80 | ( unCodePoint & 0x3F ) );
+			}
+		}
+	}
+
+	if ( punOutLength )
+		*punOutLength = pOut - ( uint8_t * )pchOut;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts a UTF-16 formatted string to a UTF-8 formatted string
+//-----------------------------------------------------------------------------
+static std::string UTF16to8( const wchar_t *in, size_t unLength )
+{
+	// every UTF-16 code unit turns into at most three bytes, or four for a whole code point in a 32 bit wchar_t
+	std::string sOut;
+	sOut.resize( unLength * ( sizeof( wchar_t ) == 2 ? 3 : 4 ) );
+
+	size_t unOutLength = 0;
+	if ( !UTF16to8Buffer( in, unLength, &sOut[ 0 ], sOut.size(), &unOutLength ) )
+		return std::string();
+
+	sOut.resize( unOutLength );
+	return sOut;
+}
+
+std::string UTF16to8( const std::wstring &in )
+{
+	return UTF16to8( in.c_str(), in.length() );
 }
 
 std::string UTF16to8( const wchar_t * in )
@@ -119,25 +377,29 @@ std::string UTF16to8( const wchar_t * in )
 		return std::string();
 	}
 
-	std::wstring wstr( in );
-	return UTF16to8( wstr );
+	return UTF16to8( in, wcslen( in ) );
 }
 
 //-----------------------------------------------------------------------------
 // Purpose: Converts a UTF-8 formatted string to a UTF-16 formatted string
 //-----------------------------------------------------------------------------
-std::wstring UTF8to16( const std::string &in )
+static std::wstring UTF8to16( const char *in, size_t unLength )
 {
-	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
+	// every UTF-8 byte turns into at most one UTF-16 code unit
+	std::wstring wsOut;
+	wsOut.resize( unLength );
 
-	try
-	{
-		return s_convert.from_bytes( in );
-	}
-	catch ( ... )
-	{
+	size_t unOutLength = 0;
+	if ( !UTF8to16Buffer( in, unLength, &wsOut[ 0 ], wsOut.size(), &unOutLength ) )
 		return std::wstring();
-	}
+
+	wsOut.resize( unOutLength );
+	return wsOut;
+}
+
+std::wstring UTF8to16( const std::string &in )
+{
+	return UTF8to16( in.c_str(), in.length() );
 }
 
 std::wstring UTF8to16( const char * in )
@@ -147,8 +409,7 @@ std::wstring UTF8to16( const char * in )
 		return std::wstring();
 	}
 
-	std::string str( in );
-	return UTF8to16( str );
+	return UTF8to16( in, strlen( in ) );
 }
 
 //-----------------------------------------------------------------------------
@@ -156,44 +417,173 @@ std::wstring UTF8to16( const char * in )
 //-----------------------------------------------------------------------------
 std::string Format( const char *pchFormat, ... )
 {
-	static constexpr size_t k_ulMaxStackString = 4096;
+	std::string sOut;
 
 	va_list args;
-	char pchBuffer[k_ulMaxStackString];
-
 	va_start( args, pchFormat );
-	int unSize = vsnprintf( pchBuffer, sizeof( pchBuffer ), pchFormat, args );
+	FormatToV( sOut, pchFormat, args );
 	va_end( args );
 
+	// this has always stopped at an embedded null
+	sOut.resize( strlen( sOut.c_str() ) );
+	return sOut;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Formats on the stack and appends, or for long output formats
+//			straight into the string
+//-----------------------------------------------------------------------------
+size_t FormatToV( std::string & sOut, const char *pchFormat, va_list args )
+{
+	static constexpr size_t k_ulMaxStackString = 4096;
+
+	char pchBuffer[k_ulMaxStackString];
+
+	va_list argsCopy;
+	va_copy( argsCopy, args );
+	int nSize = vsnprintf( pchBuffer, sizeof( pchBuffer ), pchFormat, argsCopy );
+	va_end( argsCopy );
+
 	// Something went fairly wrong
-	if ( unSize < 0 )
+	if ( nSize < 0 )
 	{
 		AssertMsg( false, "Format string parse failure" );
-		return "";
+		return 0;
 	}
 
 	// Processing on the stack worked, success
-	if ( unSize < k_ulMaxStackString )
+	if ( ( size_t )nSize < k_ulMaxStackString )
 	{
-		return pchBuffer;
+		sOut.append( pchBuffer, nSize );
+		return nSize;
+	}
+
+	// vsnprintf needs room for its terminator, which is trimmed off again afterwards
+	size_t unOldLength = sOut.length();
+	sOut.resize( unOldLength + nSize + 1 );
+	nSize = vsnprintf( &sOut[ unOldLength ], nSize + 1, pchFormat, args );
+
+	// Double check, just in case
+	if ( nSize < 0 )
+	{
+		AssertMsg( false, "Format string parse failure" );
+		sOut.resize( unOldLength );
+		return 0;
 	}
 
-	// If processing on the stack failed, fallback to a dynamic allocation
-	std::vector< char > vecChar{};
-	vecChar.resize( unSize + 1 );
+	sOut.resize( unOldLength + nSize );
+	return nSize;
+}
 
+size_t FormatTo( std::string & sOut, const char *pchFormat, ... )
+{
+	va_list args;
 	va_start( args, pchFormat );
-	unSize = vsnprintf( vecChar.data(), vecChar.size(), pchFormat, args );
+	size_t unAppended = FormatToV( sOut, pchFormat, args );
 	va_end( args );
+	return unAppended;
+}
 
-	// Double check, just in case
-	if ( unSize < 0 )
+
+bool FormatToBuffer( char *pchBuffer, size_t unBufferSize, size_t *punLength, const char *pchFormat, ... )
+{
+	if ( *punLength >= unBufferSize )
+		return false;
+
+	va_list args;
+	va_start( args, pchFormat );
+	int nSize = vsnprintf( pchBuffer + *punLength, unBufferSize - *punLength, pchFormat, args );
+	va_end( args );
+
+	if ( nSize < 0 )
 	{
 		AssertMsg( false, "Format string parse failure" );
-		return "";
+		pchBuffer[ *punLength ] = '\0';
+		return false;
+	}
+
+	size_t unAvailable = unBufferSize - *punLength - 1;
+	if ( ( size_t )nSize > unAvailable )
+	{
+		*punLength += unAvailable;
+		return false;
+	}
+
+	*punLength += nSize;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Helpers for StringAppend
+//-----------------------------------------------------------------------------
+void StringAppendUint64( std::string & sOut, uint64_t unValue )
+{
+	char rchDigits[ 20 ];
+	char *pchDigits = rchDigits + sizeof( rchDigits );
+	do
+	{
+		*--pchDigits = ( char )( '0' + unValue % 10 );
+		unValue /= 10;
+	} while ( unValue );
+
+	sOut.append( pchDigits, rchDigits + sizeof( rchDigits ) - pchDigits );
+}
+
+void StringAppendInt64( std::string & sOut, int64_t nValue )
+{
+	if ( nValue < 0 )
+	{
+		sOut.push_back( '-' );
+		// negate as unsigned so INT64_MIN works
+		StringAppendUint64( sOut, 0 - ( uint64_t )nValue );
+	}
+	else
+	{
+		StringAppendUint64( sOut, ( uint64_t )nValue );
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Appends the shortest of %.<nMinDigits>g through %.<nMaxDigits>g
+//			that reads back as the same value when rounded to the precision
+//			bFloat selects. Whole numbers that fit the mantissa are appended as
+//			integers without going through printf.
+//-----------------------------------------------------------------------------
+static void StringAppendRoundTrip( std::string & sOut, double flValue, double flMaxExactInteger, int nMinDigits, int nMaxDigits, bool bFloat )
+{
+	if ( flValue >= -flMaxExactInteger && flValue <= flMaxExactInteger && flValue == (double)(int64_t)flValue
+		&& !( flValue == 0.0 && std::signbit( flValue ) ) )
+	{
+		StringAppendInt64( sOut, (int64_t)flValue );
+		return;
+	}
+
+	char rchBuffer[ 32 ];
+	int nSize = 0;
+	for ( int nDigits = nMinDigits; nDigits <= nMaxDigits; nDigits++ )
+	{
+		nSize = snprintf( rchBuffer, sizeof( rchBuffer ), "%.*g", nDigits, flValue );
+		if ( nSize <= 0 )
+			return;
+
+		// NaN never compares equal, and the widest precision is always kept
+		double flReadBack = strtod( rchBuffer, NULL );
+		if ( bFloat ? (float)flReadBack == (float)flValue : flReadBack == flValue )
+			break;
 	}
+	sOut.append( rchBuffer, nSize );
+}
 
-	return vecChar.data();
+void StringAppendDouble( std::string & sOut, double flValue )
+{
+	StringAppendRoundTrip( sOut, flValue, 9007199254740992.0, 15, 17, false );
+}
+
+void StringAppendFloat( std::string & sOut, float flValue )
+{
+	StringAppendRoundTrip( sOut, flValue, 16777216.0, 6, 9, true );
 }
 
 
@@ -228,16 +618,58 @@ void strcpy_safe( char *pchBuffer, size_t unBufferSizeBytes, const char *pchSour
 }
 
 // --------------------------------------------------------------------
-// Purpose: converts a string to upper case
+// Purpose: Changes case in place. ASCII is converted directly, 16 bytes at
+//			a time where SSE2 is available, and anything else still goes
+//			through toupper/tolower so the current locale is respected.
 // --------------------------------------------------------------------
-std::string StringToUpper( const std::string & sString )
+static void ChangeCaseInPlace( char *pch, size_t unLength, bool bUpper )
 {
-	std::string sOut;
-	sOut.reserve( sString.size() + 1 );
-	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
+	// the range of letters to flip the 0x20 bit on
+	const char cFirst = bUpper ? 'a' : 'A';
+	const char cLast = bUpper ? 'z' : 'Z';
+
+	size_t i = 0;
+#if defined( VRCORE_STRTOOLS_SSE2 )
+	const __m128i vFirst = _mm_set1_epi8( cFirst - 1 );
+	const __m128i vLast = _mm_set1_epi8( cLast + 1 );
+	const __m128i vCaseBit = _mm_set1_epi8( 0x20 );
+	for ( ; unLength - i >= 16; i += 16 )
 	{
-		sOut.push_back( (char)toupper( *i ) );
+		__m128i vBlock = _mm_loadu_si128( ( const __m128i * )( pch + i ) );
+		if ( _mm_movemask_epi8( vBlock ) == 0 )
+		{
+			__m128i vLetters = _mm_and_si128( _mm_cmpgt_epi8( vBlock, vFirst ), _mm_cmplt_epi8( vBlock, vLast ) );
+			_mm_storeu_si128( ( __m128i * )( pch + i ), _mm_xor_si128( vBlock, _mm_and_si128( vLetters, vCaseBit ) ) );
+			continue;
+		}
+
+		for ( size_t j = i; j < i + 16; j++ )
+		{
+			if ( pch[ j ] >= cFirst && pch[ j ] <= cLast )
+				pch[ j ] ^= 0x20;
+			else if ( ( uint8_t )pch[ j ] >= 0x80 )
+				pch[ j ] = ( char )( bUpper ? toupper( pch[ j ] ) : tolower( pch[ j ] ) );
+		}
+	}
+#endif
+	for ( ; i < unLength; i++ )
+	{
+		if ( pch[ i ] >= cFirst && pch[ i ] <= cLast )
+			pch[ i ] ^= 0x20;
+		else if ( ( uint8_t )pch[ i ] >= 0x80 )
+			pch[ i ] = ( char )( bUpper ? toupper( pch[ i ] ) : tolower( pch[ i ] ) );
 	}
+}
+
+
+// --------------------------------------------------------------------
+// Purpose: converts a string to upper case
+// --------------------------------------------------------------------
+std::string StringToUpper( const std::string & sString )
+{
+	std::string sOut( sString );
+	if ( !sOut.empty() )
+		ChangeCaseInPlace( &sOut[ 0 ], sOut.length(), true );
 
 	return sOut;
 }
@@ -248,12 +680,9 @@ std::string StringToUpper( const std::string & sString )
 // --------------------------------------------------------------------
 std::string StringToLower( const std::string & sString )
 {
-	std::string sOut;
-	sOut.reserve( sString.size() + 1 );
-	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
-	{
-		sOut.push_back( (char)tolower( *i ) );
-	}
+	std::string sOut( sString );
+	if ( !sOut.empty() )
+		ChangeCaseInPlace( &sOut[ 0 ], sOut.length(), false );
 
 	return sOut;
 }
@@ -524,6 +953,296 @@ size_t V_URLDecodeNoPlusForSpace( char *pchDecodeDest, int nDecodeDestLen, const
 	return V_URLDecodeInternal( pchDecodeDest, nDecodeDestLen, pchEncodedSource, nEncodedSourceLen, false );
 }
 
+
+//-----------------------------------------------------------------------------
+// Purpose: Per-byte lookup of CharNeedsEscape_Component / CharNeedsEscape_FullPath
+//			for the std::string variants, which can't afford a std::function call
+//			per character, and of iHexCharToInt for decoding.
+//-----------------------------------------------------------------------------
+enum EURLCharClass
+{
+	k_EURLCharClass_EscapeComponent = 1 << 0,
+	k_EURLCharClass_EscapeFullPath = 1 << 1,
+};
+
+struct URLCharClassTable_t
+{
+	URLCharClassTable_t()
+	{
+		for ( int i = 0; i < 256; i++ )
+		{
+			m_rgunClass[ i ] = ( CharNeedsEscape_Component( ( char )i ) ? k_EURLCharClass_EscapeComponent : 0 )
+				| ( CharNeedsEscape_FullPath( ( char )i ) ? k_EURLCharClass_EscapeFullPath : 0 );
+			m_rgnHexValue[ i ] = ( int8_t )iHexCharToInt( ( char )i );
+		}
+	}
+
+	uint8_t m_rgunClass[ 256 ];
+	int8_t m_rgnHexValue[ 256 ];
+};
+
+static const URLCharClassTable_t & GetURLCharClassTables()
+{
+	static const URLCharClassTable_t s_table;
+	return s_table;
+}
+
+static const uint8_t *GetURLCharClassTable()
+{
+	return GetURLCharClassTables().m_rgunClass;
+}
+
+
+#if defined( VRCORE_STRTOOLS_SSE2 )
+//-----------------------------------------------------------------------------
+// Purpose: Returns 0xFF in each byte of the block that needs escaping. The
+//			compares are signed, so bytes >= 0x80 fall outside every range.
+//-----------------------------------------------------------------------------
+static inline __m128i URLEscapeMask( __m128i vBlock, bool bFullPath )
+{
+	__m128i vLower = _mm_or_si128( vBlock, _mm_set1_epi8( 0x20 ) );
+	__m128i vSafe = _mm_and_si128( _mm_cmpgt_epi8( vLower, _mm_set1_epi8( 'a' - 1 ) ), _mm_cmplt_epi8( vLower, _mm_set1_epi8( 'z' + 1 ) ) );
+	vSafe = _mm_or_si128( vSafe, _mm_cmpeq_epi8( vBlock, _mm_set1_epi8( '_' ) ) );
+
+	// '-', '.', '/', '0'-'9' and ':' are contiguous, and full paths allow all of them
+	if ( bFullPath )
+	{
+		vSafe = _mm_or_si128( vSafe, _mm_and_si128( _mm_cmpgt_epi8( vBlock, _mm_set1_epi8( '-' - 1 ) ), _mm_cmplt_epi8( vBlock, _mm_set1_epi8( ':' + 1 ) ) ) );
+	}
+	else
+	{
+		vSafe = _mm_or_si128( vSafe, _mm_and_si128( _mm_cmpgt_epi8( vBlock, _mm_set1_epi8( '-' - 1 ) ), _mm_cmplt_epi8( vBlock, _mm_set1_epi8( '.' + 1 ) ) ) );
+		vSafe = _mm_or_si128( vSafe, _mm_and_si128( _mm_cmpgt_epi8( vBlock, _mm_set1_epi8( '0' - 1 ) ), _mm_cmplt_epi8( vBlock, _mm_set1_epi8( '9' + 1 ) ) ) );
+	}
+
+	return _mm_andnot_si128( vSafe, _mm_set1_epi8( ( char )0xFF ) );
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the exact length V_URLEncodeInternal would produce, not
+//			counting the null terminator
+//-----------------------------------------------------------------------------
+static size_t URLEncodedLength( const uint8_t *pIn, size_t unLength, bool bUsePlusForSpace, bool bFullPath )
+{
+	const uint8_t *pTable = GetURLCharClassTable();
+	const uint8_t unEscapeBit = bFullPath ? k_EURLCharClass_EscapeFullPath : k_EURLCharClass_EscapeComponent;
+
+	// each escaped character grows by two, except for space turning into +
+	size_t unExpanded = 0;
+	size_t i = 0;
+#if defined( VRCORE_STRTOOLS_SSE2 )
+	// count in byte lanes, flushing before they can overflow
+	const __m128i vZero = _mm_setzero_si128();
+	while ( unLength - i >= 16 )
+	{
+		size_t unBlocks = ( unLength - i ) / 16;
+		if ( unBlocks > 255 )
+			unBlocks = 255;
+
+		__m128i vCounts = vZero;
+		for ( size_t unBlock = 0; unBlock < unBlocks; unBlock++, i += 16 )
+		{
+			__m128i vBlock = _mm_loadu_si128( ( const __m128i * )( pIn + i ) );
+			__m128i vExpand = URLEscapeMask( vBlock, bFullPath );
+			if ( bUsePlusForSpace )
+				vExpand = _mm_andnot_si128( _mm_cmpeq_epi8( vBlock, _mm_set1_epi8( ' ' ) ), vExpand );
+			vCounts = _mm_sub_epi8( vCounts, vExpand );
+		}
+
+		__m128i vSums = _mm_sad_epu8( vCounts, vZero );
+		unExpanded += ( size_t )_mm_cvtsi128_si32( vSums ) + ( size_t )_mm_cvtsi128_si32( _mm_srli_si128( vSums, 8 ) );
+	}
+#endif
+	for ( ; i < unLength; i++ )
+	{
+		if ( ( pTable[ pIn[ i ] ] & unEscapeBit ) && !( bUsePlusForSpace && pIn[ i ] == ' ' ) )
+			unExpanded++;
+	}
+
+	return unLength + 2 * unExpanded;
+}
+
+
+static inline char *URLEncodeChar( char *pchOut, uint8_t unChar, bool bNeedsEscape, bool bUsePlusForSpace )
+{
+	if ( !bNeedsEscape )
+	{
+		*pchOut++ = ( char )unChar;
+	}
+	else if ( bUsePlusForSpace && unChar == ' ' )
+	{
+		*pchOut++ = '+';
+	}
+	else
+	{
+		*pchOut++ = '%';
+		*pchOut++ = cIntToHexDigit( unChar >> 4 );
+		*pchOut++ = cIntToHexDigit( unChar & 15 );
+	}
+	return pchOut;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: std::string version of V_URLEncodeInternal. The output is sized
+//			exactly up front and then filled in one pass, copying runs that need
+//			no escaping 16 bytes at a time where SSE2 is available.
+//-----------------------------------------------------------------------------
+static std::string URLEncodeString( const std::string & sSource, bool bUsePlusForSpace, bool bFullPath )
+{
+	const uint8_t *pIn = ( const uint8_t * )sSource.data();
+	size_t unLength = sSource.length();
+
+	std::string sOut;
+	sOut.resize( URLEncodedLength( pIn, unLength, bUsePlusForSpace, bFullPath ) );
+	if ( sOut.length() == unLength && !bUsePlusForSpace )
+	{
+		// nothing needed escaping
+		sOut.assign( sSource );
+		return sOut;
+	}
+
+	const uint8_t *pTable = GetURLCharClassTable();
+	const uint8_t unEscapeBit = bFullPath ? k_EURLCharClass_EscapeFullPath : k_EURLCharClass_EscapeComponent;
+	char *pchOut = &sOut[ 0 ];
+	size_t i = 0;
+#if defined( VRCORE_STRTOOLS_SSE2 )
+	for ( ; unLength - i >= 16; i += 16 )
+	{
+		__m128i vBlock = _mm_loadu_si128( ( const __m128i * )( pIn + i ) );
+		if ( _mm_movemask_epi8( URLEscapeMask( vBlock, bFullPath ) ) == 0 )
+		{
+			_mm_storeu_si128( ( __m128i * )pchOut, vBlock );
+			pchOut += 16;
+			continue;
+		}
+
+		for ( size_t j = i; j < i + 16; j++ )
+		{
+			pchOut = URLEncodeChar( pchOut, pIn[ j ], ( pTable[ pIn[ j ] ] & unEscapeBit ) != 0, bUsePlusForSpace );
+		}
+	}
+#endif
+	for ( ; i < unLength; i++ )
+	{
+		pchOut = URLEncodeChar( pchOut, pIn[ i ], ( pTable[ pIn[ i ] ] & unEscapeBit ) != 0, bUsePlusForSpace );
+	}
+
+	return sOut;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: std::string version of V_URLDecodeInternal. Decoding never grows
+//			the string, so the output is sized to the input once and trimmed
+//			at the end. Where SSE2 is available, once 16 bytes in a row have
+//			needed no decoding the rest of the run is copied 16 bytes at a
+//			time. Text that is mostly escapes never gets that far, and stays
+//			in the byte loop, which is quicker for it.
+//-----------------------------------------------------------------------------
+static std::string URLDecodeString( const std::string & sEncoded, bool bUsePlusForSpace )
+{
+	const char *pchIn = sEncoded.data();
+	size_t unLength = sEncoded.length();
+
+	std::string sOut;
+	sOut.resize( unLength );
+	char *pchOut = &sOut[ 0 ];
+	const int8_t *pHexValue = GetURLCharClassTables().m_rgnHexValue;
+
+	size_t i = 0;
+	size_t unRunStart = 0;
+	while ( i < unLength )
+	{
+#if defined( VRCORE_STRTOOLS_SSE2 )
+		if ( i - unRunStart >= 16 )
+		{
+			while ( unLength - i >= 16 )
+			{
+				__m128i vBlock = _mm_loadu_si128( ( const __m128i * )( pchIn + i ) );
+				__m128i vSpecial = _mm_cmpeq_epi8( vBlock, _mm_set1_epi8( '%' ) );
+				if ( bUsePlusForSpace )
+					vSpecial = _mm_or_si128( vSpecial, _mm_cmpeq_epi8( vBlock, _mm_set1_epi8( '+' ) ) );
+				if ( _mm_movemask_epi8( vSpecial ) != 0 )
+					break;
+
+				_mm_storeu_si128( ( __m128i * )pchOut, vBlock );
+				pchOut += 16;
+				i += 16;
+			}
+			unRunStart = i;
+			if ( i == unLength )
+				break;
+		}
+#endif
+		char c = pchIn[ i ];
+		if ( bUsePlusForSpace && c == '+' )
+		{
+			*pchOut++ = ' ';
+			i++;
+			unRunStart = i;
+		}
+		else if ( c == '%' )
+		{
+			// same as V_URLDecodeInternal: bad hex digits are passed through, and
+			// a % without two characters after it is dropped
+			if ( i + 2 < unLength )
+			{
+				int iHigh = pHexValue[ ( uint8_t )pchIn[ i + 1 ] ];
+				int iLow = pHexValue[ ( uint8_t )pchIn[ i + 2 ] ];
+				if ( ( iHigh | iLow ) >= 0 )
+				{
+					*pchOut++ = ( char )( iHigh * 16 + iLow );
+				}
+				else
+				{
+					*pchOut++ = '%';
+					*pchOut++ = pchIn[ i + 1 ];
+					*pchOut++ = pchIn[ i + 2 ];
+				}
+			}
+			i += 3;
+			unRunStart = i;
+		}
+		else
+		{
+			*pchOut++ = c;
+			i++;
+		}
+	}
+
+	sOut.resize( pchOut - sOut.data() );
+	return sOut;
+}
+
+
+std::string V_URLEncode( const std::string & sSource )
+{
+	return URLEncodeString( sSource, true, false );
+}
+
+std::string V_URLEncodeNoPlusForSpace( const std::string & sSource )
+{
+	return URLEncodeString( sSource, false, false );
+}
+
+std::string V_URLEncodeFullPath( const std::string & sSource )
+{
+	return URLEncodeString( sSource, false, true );
+}
+
+std::string V_URLDecode( const std::string & sEncoded )
+{
+	return URLDecodeString( sEncoded, true );
+}
+
+std::string V_URLDecodeNoPlusForSpace( const std::string & sEncoded )
+{
+	return URLDecodeString( sEncoded, false );
+}
+
 //-----------------------------------------------------------------------------
 void V_StripExtension( std::string &in )
 {
@@ -548,89 +1267,236 @@ void V_StripExtension( std::string &in )
 std::vector<std::string> TokenizeString( const std::string & sString, char cToken )
 {
 	std::vector<std::string> vecStrings;
-	std::istringstream stream( sString );
-	std::string s;
-	while ( std::getline( stream, s, cToken ) )
+	CStringTokenizer tokenizer( sString, cToken );
+	const char *pchToken;
+	size_t unTokenLength;
+	while ( tokenizer.BNextToken( &pchToken, &unTokenLength ) )
 	{
-		vecStrings.push_back( s );
+		vecStrings.emplace_back( pchToken, unTokenLength );
 	}
 
-	if ( !sString.empty() && sString.back() == cToken )
+	return vecStrings;
+}
+
+
+CStringTokenizer::CStringTokenizer( const char *pchString, size_t unLength, char cDelimiter )
+{
+	Init( pchString, unLength, &cDelimiter, 1, k_ETokenDelimiter_String );
+}
+
+CStringTokenizer::CStringTokenizer( const char *pchString, size_t unLength, const char *pchDelimiter, ETokenDelimiter eDelimiter )
+{
+	Init( pchString, unLength, pchDelimiter, strlen( pchDelimiter ), eDelimiter );
+}
+
+CStringTokenizer::CStringTokenizer( const std::string & sString, char cDelimiter )
+{
+	Init( sString.data(), sString.length(), &cDelimiter, 1, k_ETokenDelimiter_String );
+}
+
+CStringTokenizer::CStringTokenizer( const std::string & sString, const char *pchDelimiter, ETokenDelimiter eDelimiter )
+{
+	Init( sString.data(), sString.length(), pchDelimiter, strlen( pchDelimiter ), eDelimiter );
+}
+
+
+void CStringTokenizer::Init( const char *pchString, size_t unLength, const char *pchDelimiter, size_t unDelimiterLength, ETokenDelimiter eDelimiter )
+{
+	m_pchNext = pchString;
+	m_pchEnd = pchString + unLength;
+	m_bDone = unLength == 0;
+
+	// a single character is the same either way, and takes the memchr path
+	m_eDelimiter = unDelimiterLength == 1 ? k_ETokenDelimiter_String : eDelimiter;
+	m_cDelimiter = unDelimiterLength ? pchDelimiter[ 0 ] : 0;
+	m_pchDelimiter = unDelimiterLength == 1 ? NULL : pchDelimiter;
+	m_unDelimiterLength = unDelimiterLength;
+
+	memset( m_rgunDelimiterSet, 0, sizeof( m_rgunDelimiterSet ) );
+	if ( m_eDelimiter == k_ETokenDelimiter_AnyOf )
 	{
-		vecStrings.push_back( "" );
+		for ( size_t i = 0; i < unDelimiterLength; i++ )
+		{
+			uint8_t unChar = ( uint8_t )pchDelimiter[ i ];
+			m_rgunDelimiterSet[ unChar >> 5 ] |= 1u << ( unChar & 31 );
+		}
 	}
-
-	return vecStrings;
 }
 
+
 //-----------------------------------------------------------------------------
-// Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
+// Purpose: Returns the start of the next delimiter at or after m_pchNext, or
+//			m_pchEnd if there isn't one
 //-----------------------------------------------------------------------------
-bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+const char *CStringTokenizer::FindDelimiter() const
 {
-	typedef std::codecvt_utf8<char32_t> facet_type;
-	facet_type myfacet;
-
-	std::mbstate_t mystate = std::mbstate_t();
+	if ( m_unDelimiterLength == 0 )
+		return m_pchEnd;
 
-	sOutputUtf8.clear();
-	sOutputUtf8.reserve( pend - pbegin );
-	bool bSqueakyClean = true;
+	if ( m_eDelimiter == k_ETokenDelimiter_String )
+	{
+		// find the first character, then check the rest
+		const char *pchSearch = m_pchNext;
+		while ( ( size_t )( m_pchEnd - pchSearch ) >= m_unDelimiterLength )
+		{
+			const char *pchFound = ( const char * )memchr( pchSearch, m_cDelimiter, m_pchEnd - pchSearch - m_unDelimiterLength + 1 );
+			if ( !pchFound )
+				break;
+			if ( m_unDelimiterLength == 1 || memcmp( pchFound + 1, m_pchDelimiter + 1, m_unDelimiterLength - 1 ) == 0 )
+				return pchFound;
+			pchSearch = pchFound + 1;
+		}
+		return m_pchEnd;
+	}
 
-	const char *pmid = pbegin;
-	while ( pmid != pend )
+	const char *pchSearch = m_pchNext;
+#if defined( VRCORE_STRTOOLS_SSE2 )
+	// small sets (path separators and the like) are compared 16 bytes at a time
+	if ( m_unDelimiterLength <= 4 )
 	{
-		bool bHasError = false;
-		bool bHasValidData = false;
+		__m128i rgvDelimiter[ 4 ];
+		for ( size_t i = 0; i < 4; i++ )
+		{
+			rgvDelimiter[ i ] = _mm_set1_epi8( m_pchDelimiter[ i < m_unDelimiterLength ? i : 0 ] );
+		}
 
-		char32_t out = 0xdeadbeef, *pout;
-		pbegin = pmid;
-		switch ( myfacet.in( mystate, pbegin, pend, pmid, &out, &out + 1, pout ) )
+		while ( m_pchEnd - pchSearch >= 16 )
 		{
-		case facet_type::ok:
-			bHasValidData = true;
-			break;
+			__m128i vBlock = _mm_loadu_si128( ( const __m128i * )pchSearch );
+			__m128i vMatch = _mm_or_si128(
+				_mm_or_si128( _mm_cmpeq_epi8( vBlock, rgvDelimiter[ 0 ] ), _mm_cmpeq_epi8( vBlock, rgvDelimiter[ 1 ] ) ),
+				_mm_or_si128( _mm_cmpeq_epi8( vBlock, rgvDelimiter[ 2 ] ), _mm_cmpeq_epi8( vBlock, rgvDelimiter[ 3 ] ) ) );
+			int nMask = _mm_movemask_epi8( vMatch );
+			if ( nMask )
+			{
+				int nIndex = 0;
+				while ( !( nMask & ( 1 << nIndex ) ) )
+					nIndex++;
+				return pchSearch + nIndex;
+			}
+			pchSearch += 16;
+		}
+	}
+#endif
+	for ( ; pchSearch < m_pchEnd; pchSearch++ )
+	{
+		uint8_t unChar = ( uint8_t )*pchSearch;
+		if ( m_rgunDelimiterSet[ unChar >> 5 ] & ( 1u << ( unChar & 31 ) ) )
+			return pchSearch;
+	}
+	return m_pchEnd;
+}
 
-		case facet_type::noconv:
-			// unexpected! always converting type
-			bSqueakyClean = false;
+
+bool CStringTokenizer::BNextToken( const char **ppchToken, size_t *punTokenLength )
+{
+	if ( m_bDone )
+		return false;
+
+	const char *pchDelimiter = FindDelimiter();
+	*ppchToken = m_pchNext;
+	*punTokenLength = pchDelimiter - m_pchNext;
+
+	if ( pchDelimiter == m_pchEnd )
+	{
+		m_bDone = true;
+	}
+	else
+	{
+		m_pchNext = pchDelimiter + ( m_eDelimiter == k_ETokenDelimiter_String ? m_unDelimiterLength : 1 );
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the length of the longest prefix of the input that is
+// valid UTF-8. Runs of ASCII are skipped 16 bytes at a time where SSE2 is
+// available.
+//-----------------------------------------------------------------------------
+static size_t ValidUTF8PrefixLength( const char *pchBegin, const char *pchEnd )
+{
+	const uint8_t *pIn = ( const uint8_t * )pchBegin;
+	const uint8_t *pInEnd = ( const uint8_t * )pchEnd;
+
+	while ( pIn < pInEnd )
+	{
+#if defined( VRCORE_STRTOOLS_SSE2 )
+		while ( pInEnd - pIn >= 16 && _mm_movemask_epi8( _mm_loadu_si128( ( const __m128i * )pIn ) ) == 0 )
+		{
+			pIn += 16;
+		}
+		if ( pIn == pInEnd )
 			break;
 
-		case facet_type::partial:
-			bHasError = pbegin == pmid;
-			if ( bHasError )
-			{
-				bSqueakyClean = false;
-			}
-			else
+		// see UTF8to16Buffer
+		const uint8_t *pBlockEnd = pInEnd - pIn > 16 ? pIn + 16 : pInEnd;
+#else
+		const uint8_t *pBlockEnd = pInEnd;
+#endif
+		while ( pIn < pBlockEnd )
+		{
+			if ( *pIn < 0x80 )
 			{
-				bHasValidData = true;
+				pIn++;
+				continue;
 			}
-			break;
 
-		case facet_type::error:
-			bHasError = true;
-			bSqueakyClean = false;
-			break;
+			uint32_t unCodePoint;
+			size_t unSequenceLength = DecodeUTF8Sequence( pIn, pInEnd, &unCodePoint );
+			if ( !unSequenceLength )
+				return ( const char * )pIn - pchBegin;
+			pIn += unSequenceLength;
 		}
+	}
+
+	return pchEnd - pchBegin;
+}
+
 
-		if ( bHasValidData )
+bool IsValidUTF8( const char *pchBegin, const char *pchEnd )
+{
+	return ValidUTF8PrefixLength( pchBegin, pchEnd ) == ( size_t )( pchEnd - pchBegin );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Replaces each invalid byte with '?', one code point at a time.
+// This is the slow path for RepairUTF8; it appends to sOutputUtf8. Encoded
+// surrogates are passed through as they were by the codecvt_utf8 version this
+// replaced, even though IsValidUTF8 rejects them.
+//-----------------------------------------------------------------------------
+static bool RepairUTF8Slow( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	const uint8_t *pIn = ( const uint8_t * )pbegin;
+	const uint8_t *pInEnd = ( const uint8_t * )pend;
+
+	bool bSqueakyClean = true;
+	while ( pIn < pInEnd )
+	{
+		const uint8_t *pValid = pIn;
+		while ( pIn < pInEnd )
 		{
-			// could convert back, but no need
-			for ( const char *p = pbegin; p != pmid; ++p )
+			if ( *pIn < 0x80 )
 			{
-				sOutputUtf8 += *p;
+				pIn++;
+				continue;
 			}
-		}
 
-		if ( bHasError )
-		{
-			sOutputUtf8 += '?';
+			uint32_t unCodePoint;
+			size_t unSequenceLength = DecodeUTF8Sequence( pIn, pInEnd, &unCodePoint );
+			if ( !unSequenceLength && *pIn == 0xED && pInEnd - pIn >= 3 && ( pIn[ 1 ] & 0xE0 ) == 0xA0 && ( pIn[ 2 ] & 0xC0 ) == 0x80 )
+				unSequenceLength = 3;
+			if ( !unSequenceLength )
+				break;
+			pIn += unSequenceLength;
 		}
+		sOutputUtf8.append( ( const char * )pValid, pIn - pValid );
 
-		if ( pmid == pbegin )
+		if ( pIn < pInEnd )
 		{
-			pmid++;
+			sOutputUtf8 += '?';
+			bSqueakyClean = false;
+			pIn++;
 		}
 	}
 
@@ -638,8 +1504,38 @@ bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
+// Purpose: Input is nearly always valid already, so the valid prefix is found
+// quickly and copied in one go, and only the rest goes through the slow path.
 //-----------------------------------------------------------------------------
+bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	size_t unValidLength = ValidUTF8PrefixLength( pbegin, pend );
+
+	sOutputUtf8.clear();
+	sOutputUtf8.reserve( pend - pbegin );
+	sOutputUtf8.append( pbegin, unValidLength );
+	if ( pbegin + unValidLength == pend )
+		return true;
+
+	return RepairUTF8Slow( pbegin + unValidLength, pend, sOutputUtf8 );
+}
+
+bool RepairUTF8InPlace( std::string & sUtf8 )
+{
+	const char *pbegin = sUtf8.data();
+	const char *pend = pbegin + sUtf8.size();
+	size_t unValidLength = ValidUTF8PrefixLength( pbegin, pend );
+	if ( pbegin + unValidLength == pend )
+		return true;
+
+	std::string sRepaired;
+	sRepaired.reserve( sUtf8.size() );
+	sRepaired.append( pbegin, unValidLength );
+	bool bSqueakyClean = RepairUTF8Slow( pbegin + unValidLength, pend, sRepaired );
+	sUtf8.swap( sRepaired );
+	return bSqueakyClean;
+}
+
 bool RepairUTF8( const std::string & sInputUtf8, std::string & sOutputUtf8 )
 {
 	return RepairUTF8( sInputUtf8.data(), sInputUtf8.data() + sInputUtf8.size(), sOutputUtf8 );
@@ -2,10 +2,19 @@
 #pragma once
 
 #include <string>
+#include <stdarg.h>
 #include <stdint.h>
 #include <sys/types.h>
+#include <type_traits>
 #include <vector>
 
+// Lets GCC and clang check printf-style arguments against the format string
+#if defined( __GNUC__ )
+#define VRCORE_PRINTF_FORMAT( nFormatArg, nFirstVarArg ) __attribute__(( format( __printf__, nFormatArg, nFirstVarArg ) ))
+#else
+#define VRCORE_PRINTF_FORMAT( nFormatArg, nFirstVarArg )
+#endif
+
 /** returns true if the string has the prefix */
 bool StringHasPrefix( const std::string & sString, const std::string & sPrefix );
 bool StringHasPrefixCaseSensitive( const std::string & sString, const std::string & sPrefix );
@@ -26,6 +35,14 @@ std::wstring UTF8to16(const char * in);
 std::wstring UTF8to16( const std::string & in );
 #define Utf16FromUtf8 UTF8to16
 
+/** Converts between UTF-8 and UTF-16 into a buffer the caller provides. UTF-16 is held one code unit
+* per wchar_t even where wchar_t is 32 bits, though there a whole code point in one wchar_t is also
+* accepted. The output is not null terminated and never needs more than unInLength wchar_ts
+* (UTF8to16Buffer) or 3 * unInLength chars (UTF16to8Buffer, 4 * unInLength where wchar_t is 32 bits). Returns false if the input is not valid
+* or the output doesn't fit. These don't allocate or throw and are safe to call from any thread. */
+bool UTF8to16Buffer( const char *pchIn, size_t unInLength, wchar_t *pwchOut, size_t unOutCapacity, size_t *punOutLength );
+bool UTF16to8Buffer( const wchar_t *pwchIn, size_t unInLength, char *pchOut, size_t unOutCapacity, size_t *punOutLength );
+
 #if defined( _WIN32 )
 std::string DefaultACPtoUTF8( const char *pszStr );
 #endif
@@ -34,6 +51,12 @@ std::string DefaultACPtoUTF8( const char *pszStr );
 bool RepairUTF8( const char *begin, const char *end, std::string & sOutputUtf8 );
 bool RepairUTF8( const std::string & sInputUtf8, std::string & sOutputUtf8 );
 
+/** Like RepairUTF8, but leaves the string alone without copying it if it is already valid */
+bool RepairUTF8InPlace( std::string & sUtf8 );
+
+/** Returns true if the string is valid UTF-8 (no overlong forms, surrogates, or code points past U+10FFFF) */
+bool IsValidUTF8( const char *pchBegin, const char *pchEnd );
+
 /** Trims trailing CR, LF, Tab, and Space characters */
 std::string TrimTrailingWhitespace( const std::string& in );
 
@@ -46,7 +69,80 @@ void strcpy_safe( char (& buffer) [ bufferSize ], const char *pchSource )
 }
 
 /** Turns printf-style format args into a std::string */
-std::string Format( const char *pchFormat, ... );
+std::string Format( const char *pchFormat, ... ) VRCORE_PRINTF_FORMAT( 1, 2 );
+
+/** Appends printf-style format args to sOut, reusing its storage. Returns the number of chars appended. */
+size_t FormatTo( std::string & sOut, const char *pchFormat, ... ) VRCORE_PRINTF_FORMAT( 2, 3 );
+size_t FormatToV( std::string & sOut, const char *pchFormat, va_list args );
+
+/** Appends printf-style format args to the null terminated string of length *punLength in pchBuffer,
+* and advances *punLength. Returns false if the output had to be truncated to fit. */
+bool FormatToBuffer( char *pchBuffer, size_t unBufferSize, size_t *punLength, const char *pchFormat, ... ) VRCORE_PRINTF_FORMAT( 4, 5 );
+
+//-----------------------------------------------------------------------------
+// Purpose: Type-safe alternative to FormatTo for simple concatenation, e.g.
+//			StringAppend( sOut, "/devices/", unDeviceIndex, "/", sName ).
+//			Strings and chars are appended as they are and integers in decimal
+//			without going through printf. Only plain char is a character;
+//			int8_t and uint8_t are integers. bool appends "true" or "false".
+//			Floating point values are appended with the fewest significant
+//			digits that read back as the same float or double, so 1234567.0 is
+//			"1234567" and 0.1 is "0.1". Whole numbers skip printf; others still
+//			go through snprintf. Anything else fails to compile.
+//-----------------------------------------------------------------------------
+void StringAppendInt64( std::string & sOut, int64_t nValue );
+void StringAppendUint64( std::string & sOut, uint64_t unValue );
+void StringAppendDouble( std::string & sOut, double flValue );
+void StringAppendFloat( std::string & sOut, float flValue );
+
+inline void StringAppendValue( std::string & sOut, const std::string & sValue ) { sOut.append( sValue ); }
+inline void StringAppendValue( std::string & sOut, const char *pchValue ) { if ( pchValue ) sOut.append( pchValue ); }
+inline void StringAppendValue( std::string & sOut, char cValue ) { sOut.push_back( cValue ); }
+
+// a template so that pointers don't convert to bool
+template< typename T >
+inline typename std::enable_if< std::is_same< T, bool >::value >::type StringAppendValue( std::string & sOut, T bValue )
+{
+	sOut.append( bValue ? "true" : "false" );
+}
+
+template< typename T >
+inline typename std::enable_if< std::is_integral< T >::value && std::is_signed< T >::value >::type StringAppendValue( std::string & sOut, T nValue )
+{
+	StringAppendInt64( sOut, nValue );
+}
+
+template< typename T >
+inline typename std::enable_if< std::is_integral< T >::value && !std::is_signed< T >::value && !std::is_same< T, bool >::value >::type StringAppendValue( std::string & sOut, T unValue )
+{
+	StringAppendUint64( sOut, unValue );
+}
+
+inline void StringAppendValue( std::string & sOut, float flValue ) { StringAppendFloat( sOut, flValue ); }
+
+template< typename T >
+inline typename std::enable_if< std::is_floating_point< T >::value >::type StringAppendValue( std::string & sOut, T flValue )
+{
+	StringAppendDouble( sOut, flValue );
+}
+
+inline void StringAppend( std::string & ) {}
+
+template< typename T, typename... Args >
+inline void StringAppend( std::string & sOut, const T & value, const Args &... args )
+{
+	StringAppendValue( sOut, value );
+	StringAppend( sOut, args... );
+}
+
+/** Same as StringAppend, but returns a new string */
+template< typename... Args >
+inline std::string StringConcat( const Args &... args )
+{
+	std::string sOut;
+	StringAppend( sOut, args... );
+	return sOut;
+}
 
 
 /** converts a string to upper case */
@@ -150,6 +246,14 @@ size_t V_URLDecode( char *pchDecodeDest, int nDecodeDestLen, const char *pchEnco
 /** Same as V_URLDecode, but without plus for space. */
 size_t V_URLDecodeNoPlusForSpace( char *pchDecodeDest, int nDecodeDestLen, const char *pchEncodedSource, int nEncodedSourceLen );
 
+/** std::string versions of the above, which size their output exactly. Like the buffer
+* versions, decoding %00 produces an embedded null. */
+std::string V_URLEncode( const std::string & sSource );
+std::string V_URLEncodeNoPlusForSpace( const std::string & sSource );
+std::string V_URLEncodeFullPath( const std::string & sSource );
+std::string V_URLDecode( const std::string & sEncoded );
+std::string V_URLDecodeNoPlusForSpace( const std::string & sEncoded );
+
 //-----------------------------------------------------------------------------
 // Purpose: strip extension from a path
 //-----------------------------------------------------------------------------
@@ -164,3 +268,44 @@ std::string IpAndPortToString( uint32_t unIpH, uint16_t usPortH );
 
 /** Tokenizes a string into a vector of strings */
 std::vector<std::string> TokenizeString( const std::string & sString, char cToken );
+
+enum ETokenDelimiter
+{
+	k_ETokenDelimiter_String,	// the whole delimiter string separates tokens
+	k_ETokenDelimiter_AnyOf,	// any one character of the delimiter string separates tokens
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Splits a string into tokens without allocating. Each call to
+//			BNextToken returns the next token as a pointer and length into the
+//			original string, which must outlive the tokenizer (as must the
+//			delimiter string). Like TokenizeString, adjacent delimiters produce
+//			empty tokens, a trailing delimiter produces a final empty token,
+//			and an empty string produces no tokens at all. An empty delimiter
+//			never splits.
+//-----------------------------------------------------------------------------
+class CStringTokenizer
+{
+public:
+	CStringTokenizer( const char *pchString, size_t unLength, char cDelimiter );
+	CStringTokenizer( const char *pchString, size_t unLength, const char *pchDelimiter, ETokenDelimiter eDelimiter = k_ETokenDelimiter_String );
+	CStringTokenizer( const std::string & sString, char cDelimiter );
+	CStringTokenizer( const std::string & sString, const char *pchDelimiter, ETokenDelimiter eDelimiter = k_ETokenDelimiter_String );
+
+	/** Returns the next token, which may be empty, or false if there are no more */
+	bool BNextToken( const char **ppchToken, size_t *punTokenLength );
+
+private:
+	void Init( const char *pchString, size_t unLength, const char *pchDelimiter, size_t unDelimiterLength, ETokenDelimiter eDelimiter );
+	const char *FindDelimiter() const;
+
+	const char *m_pchNext;
+	const char *m_pchEnd;
+	bool m_bDone;
+
+	ETokenDelimiter m_eDelimiter;
+	char m_cDelimiter;
+	const char *m_pchDelimiter;
+	size_t m_unDelimiterLength;
+	uint32_t m_rgunDelimiterSet[ 8 ];
+};
@@ -18,10 +18,20 @@
 #elif defined(LINUX)
 #include <dlfcn.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
 #endif
 
 #include <algorithm>
+#include <string.h>
 #include <sstream>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <sys/stat.h>
 
 #ifndef VRLog
 	#if defined( __MINGW32__ )
@@ -74,7 +84,7 @@ static std::string GetAppSettingsPath()
 	// As defined by XDG Base Directory Specification 
 	// https://specifications.freedesktop.org/basedir-spec/basedir-spec-latest.html
 
-	const char *pchHome = getenv("XDG_CONFIG_HOME");
+	const char *pchHome = GetEnvironmentVariableCached( "XDG_CONFIG_HOME" );
 	if ( ( pchHome != NULL) && ( pchHome[0] != '\0' ) )
 	{
 		return pchHome;
@@ -83,7 +93,7 @@ static std::string GetAppSettingsPath()
 	//
 	// XDG_CONFIG_HOME is not defined, use ~/.config instead
 	// 
-	pchHome = getenv( "HOME" );
+	pchHome = GetEnvironmentVariableCached( "HOME" );
 	if ( pchHome == NULL )
 	{
 		return "";
@@ -133,9 +143,9 @@ std::string CVRPathRegistry_Public::GetOpenVRConfigPath()
 //-----------------------------------------------------------------------------
 std::string CVRPathRegistry_Public::GetVRPathRegistryFilename()
 {
-	std::string sOverridePath = GetEnvironmentVariable( "VR_PATHREG_OVERRIDE" );
-	if ( !sOverridePath.empty() )
-		return sOverridePath;
+	const char *pchOverridePath = GetEnvironmentVariableCached( "VR_PATHREG_OVERRIDE" );
+	if ( pchOverridePath && *pchOverridePath )
+		return pchOverridePath;
 
 	std::string sPath = GetOpenVRConfigPath();
 	if ( sPath.empty() )
@@ -178,6 +188,31 @@ static void ParseStringListFromJson( std::vector< std::string > *pvecHistory, co
 }
 
 
+// ---------------------------------------------------------------------------
+// Purpose: Removes all but the first instance of each string from the list
+//			and fills in the set of strings that remain
+// ---------------------------------------------------------------------------
+static void RemoveDuplicateStrings( std::vector< std::string > *pvecStrings, std::unordered_set< std::string > *psetStrings )
+{
+	psetStrings->clear();
+	psetStrings->reserve( pvecStrings->size() );
+
+	size_t unKept = 0;
+	for ( size_t unIndex = 0; unIndex < pvecStrings->size(); unIndex++ )
+	{
+		if ( !psetStrings->insert( ( *pvecStrings )[ unIndex ] ).second )
+			continue;
+
+		if ( unKept != unIndex )
+		{
+			( *pvecStrings )[ unKept ] = std::move( ( *pvecStrings )[ unIndex ] );
+		}
+		unKept++;
+	}
+	pvecStrings->resize( unKept );
+}
+
+
 // ---------------------------------------------------------------------------
 // Purpose: Converts a history array to JSON
 // ---------------------------------------------------------------------------
@@ -256,6 +291,7 @@ bool CVRPathRegistry_Public::BLoadFromFile( std::string *psLoadError )
 		if ( root.isMember( "external_drivers" ) && root["external_drivers"].isArray() )
 		{
 			ParseStringListFromJson( &m_vecExternalDrivers, root, "external_drivers" );
+			RemoveDuplicateStrings( &m_vecExternalDrivers, &m_setExternalDrivers );
 		}
 	}
 	catch ( ... )
@@ -311,6 +347,174 @@ bool CVRPathRegistry_Public::BSaveToFile() const
 }
 
 
+// ---------------------------------------------------------------------------
+// Purpose: Formats the external driver list the same way BSaveToFile does when
+//			it is a member of the root object, with the specified line ending
+// ---------------------------------------------------------------------------
+static std::string ExternalDriversToJsonText( const std::vector< std::string > & vecExternalDrivers, const char *pchNewline )
+{
+	if ( vecExternalDrivers.empty() )
+		return "[]";
+
+	std::string sArray = "[";
+	sArray += pchNewline;
+	for ( size_t unIndex = 0; unIndex < vecExternalDrivers.size(); unIndex++ )
+	{
+		sArray += "\t\t";
+		sArray += Json::valueToQuotedString( vecExternalDrivers[ unIndex ].c_str() );
+		if ( unIndex + 1 < vecExternalDrivers.size() )
+			sArray += ",";
+		sArray += pchNewline;
+	}
+	sArray += "\t]";
+	return sArray;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Adds or removes one external driver in the registry file. The new
+//			list is spliced into the existing text in place of the old one,
+//			using the file's line endings. The file is read and written as
+//			binary, so everything else, including a UTF-8 BOM, is written back
+//			byte for byte.
+// ---------------------------------------------------------------------------
+static bool UpdateExternalDriverInFile( const std::string & sDriverPath, bool bAdd, std::string *psError )
+{
+	std::string sRegPath = CVRPathRegistry_Public::GetVRPathRegistryFilename();
+	if ( sRegPath.empty() )
+	{
+		if ( psError )
+			*psError = "Unable to determine VR Path Registry filename";
+		return false;
+	}
+
+	std::vector< uint8_t > vecRegistryBytes = Path_ReadBinaryFile( sRegPath );
+	if ( vecRegistryBytes.empty() )
+	{
+		if ( psError )
+			*psError = "Unable to read VR Path Registry from " + sRegPath;
+		return false;
+	}
+
+	std::string sRegistryContents( vecRegistryBytes.begin(), vecRegistryBytes.end() );
+	size_t unJsonStart = StringHasPrefixCaseSensitive( sRegistryContents, "\xEF\xBB\xBF" ) ? 3 : 0;
+	const char *pchNewline = sRegistryContents.find( "\r\n" ) != std::string::npos ? "\r\n" : "\n";
+
+	Json::Value root;
+	std::vector< std::string > vecExternalDrivers;
+	std::unordered_set< std::string > setExternalDrivers;
+	try
+	{
+		Json::CharReaderBuilder builder;
+		std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+		std::string sErrors;
+		if ( !pReader->parse( sRegistryContents.data() + unJsonStart, sRegistryContents.data() + sRegistryContents.size(), &root, &sErrors )
+			|| !root.isObject() )
+		{
+			if ( psError )
+				*psError = "Unable to parse " + sRegPath + ": " + sErrors;
+			return false;
+		}
+
+		if ( root.isMember( "external_drivers" ) && root[ "external_drivers" ].isArray() )
+		{
+			ParseStringListFromJson( &vecExternalDrivers, root, "external_drivers" );
+		}
+	}
+	catch ( ... )
+	{
+		if ( psError )
+			*psError = "Unable to parse " + sRegPath + ": exception thrown in JSON library";
+		return false;
+	}
+
+	size_t unListedCount = vecExternalDrivers.size();
+	RemoveDuplicateStrings( &vecExternalDrivers, &setExternalDrivers );
+	bool bHadDuplicates = vecExternalDrivers.size() != unListedCount;
+
+	bool bPresent = setExternalDrivers.count( sDriverPath ) != 0;
+	if ( bAdd && !bPresent )
+	{
+		vecExternalDrivers.push_back( sDriverPath );
+	}
+	else if ( !bAdd && bPresent )
+	{
+		vecExternalDrivers.erase( std::find( vecExternalDrivers.begin(), vecExternalDrivers.end(), sDriverPath ) );
+	}
+	else if ( !bHadDuplicates )
+	{
+		// nothing to do
+		return true;
+	}
+
+	// offsets are from the start of the JSON, after any BOM
+	std::string sDriversJson = ExternalDriversToJsonText( vecExternalDrivers, pchNewline );
+	if ( root.isMember( "external_drivers" ) )
+	{
+		const Json::Value & driversNode = root[ "external_drivers" ];
+		size_t unStart = unJsonStart + driversNode.getOffsetStart();
+		size_t unLimit = unJsonStart + driversNode.getOffsetLimit();
+		sRegistryContents.replace( unStart, unLimit - unStart, sDriversJson );
+	}
+	else if ( root.empty() )
+	{
+		// insert the new member just after the opening brace of the root object
+		std::string sMember = pchNewline;
+		sMember += "\t\"external_drivers\" : " + sDriversJson + pchNewline;
+		sRegistryContents.insert( unJsonStart + root.getOffsetStart() + 1, sMember );
+	}
+	else
+	{
+		// insert the new member just after the last one, so whatever follows it stays where it is
+		size_t unLastMemberEnd = 0;
+		for ( const Json::Value & member : root )
+		{
+			unLastMemberEnd = std::max( unLastMemberEnd, ( size_t )member.getOffsetLimit() );
+		}
+		std::string sMember = ",";
+		sMember += pchNewline;
+		sMember += "\t\"external_drivers\" : " + sDriversJson;
+		sRegistryContents.insert( unJsonStart + unLastMemberEnd, sMember );
+	}
+
+	if ( !Path_WriteBinaryFileAtomic( sRegPath, ( unsigned char * )&sRegistryContents[0], ( unsigned )sRegistryContents.size() ) )
+	{
+		if ( psError )
+			*psError = "Unable to write VR path registry to " + sRegPath;
+		return false;
+	}
+
+	return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Adds a driver to the external driver list in the registry file
+// ---------------------------------------------------------------------------
+bool CVRPathRegistry_Public::AddExternalDriver( const std::string & sDriverPath, std::string *psError )
+{
+	return UpdateExternalDriverInFile( sDriverPath, true, psError );
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Removes a driver from the external driver list in the registry file
+// ---------------------------------------------------------------------------
+bool CVRPathRegistry_Public::RemoveExternalDriver( const std::string & sDriverPath, std::string *psError )
+{
+	return UpdateExternalDriverInFile( sDriverPath, false, psError );
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Returns true if the driver is in the external driver list
+// ---------------------------------------------------------------------------
+bool CVRPathRegistry_Public::HasExternalDriver( const std::string & sDriverPath ) const
+{
+	return m_setExternalDrivers.count( sDriverPath ) != 0;
+}
+
+
 // ---------------------------------------------------------------------------
 // Purpose: Returns the current runtime path or NULL if no path is configured.
 // ---------------------------------------------------------------------------
@@ -348,6 +552,129 @@ std::string CVRPathRegistry_Public::GetLogPath() const
 
 
 
+// ---------------------------------------------------------------------------
+// Purpose: Identifies a version of the registry file on disk. If any of these
+//			change the file has to be parsed again.
+// ---------------------------------------------------------------------------
+struct PathRegistryFileStamp_t
+{
+	int64_t nSize;
+	int64_t nModifiedTime; // in the finest units the platform reports
+	uint64_t ulVolumeId;
+	uint64_t ulFileId;
+
+	bool operator==( const PathRegistryFileStamp_t & other ) const
+	{
+		return nSize == other.nSize && nModifiedTime == other.nModifiedTime
+			&& ulVolumeId == other.ulVolumeId && ulFileId == other.ulFileId;
+	}
+};
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Stats the registry file. Returns false if it doesn't exist.
+// ---------------------------------------------------------------------------
+static bool GetPathRegistryFileStamp( const std::string & sRegPath, PathRegistryFileStamp_t *pStamp )
+{
+#if defined( _WIN32 )
+	// _wstat64 only has one second resolution and no file id, so ask the file system directly.
+	// Opening for no access doesn't get in the way of anyone writing the file.
+	std::wstring wsRegPath = UTF8to16( sRegPath.c_str() );
+	HANDLE hFile = CreateFileW( wsRegPath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( hFile == INVALID_HANDLE_VALUE )
+		return false;
+
+	BY_HANDLE_FILE_INFORMATION info;
+	BOOL bGotInfo = GetFileInformationByHandle( hFile, &info );
+	CloseHandle( hFile );
+	if ( !bGotInfo )
+		return false;
+
+	// 100ns ticks on NTFS; atomic replacement gives the file a new index even if the size and time match
+	pStamp->nSize = ( (int64_t)info.nFileSizeHigh << 32 ) | info.nFileSizeLow;
+	pStamp->nModifiedTime = (int64_t)( ( (uint64_t)info.ftLastWriteTime.dwHighDateTime << 32 ) | info.ftLastWriteTime.dwLowDateTime );
+	pStamp->ulVolumeId = info.dwVolumeSerialNumber;
+	pStamp->ulFileId = ( (uint64_t)info.nFileIndexHigh << 32 ) | info.nFileIndexLow;
+#else
+	struct stat buf;
+	if ( stat( sRegPath.c_str(), &buf ) != 0 )
+		return false;
+
+#if defined( LINUX )
+	pStamp->nModifiedTime = (int64_t)buf.st_mtim.tv_sec * 1000000000LL + buf.st_mtim.tv_nsec;
+#elif defined( OSX )
+	pStamp->nModifiedTime = (int64_t)buf.st_mtimespec.tv_sec * 1000000000LL + buf.st_mtimespec.tv_nsec;
+#else
+	pStamp->nModifiedTime = (int64_t)buf.st_mtime * 1000000000LL;
+#endif
+	pStamp->nSize = (int64_t)buf.st_size;
+	pStamp->ulVolumeId = (uint64_t)buf.st_dev;
+	// atomic replacement of the file gives it a new inode even if the size and time match
+	pStamp->ulFileId = (uint64_t)buf.st_ino;
+#endif
+
+	return true;
+}
+
+
+// the most recently parsed registry and the file it came from
+static std::mutex s_mutexPathRegistryCache;
+static std::string s_sCachedPathRegistryFilename;
+static PathRegistryFileStamp_t s_cachedPathRegistryStamp;
+static std::shared_ptr< const CVRPathRegistry_Public > s_pCachedPathRegistry;
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Loads the registry from its well known location, reusing the last
+//			parsed copy if the file hasn't changed since. Always returns a 
+//			registry, which is empty if it couldn't be loaded.
+// ---------------------------------------------------------------------------
+static std::shared_ptr< const CVRPathRegistry_Public > LoadPathRegistryCached( bool *pbLoaded, std::string *psLoadError )
+{
+	std::string sRegPath = CVRPathRegistry_Public::GetVRPathRegistryFilename();
+
+	PathRegistryFileStamp_t stamp;
+	bool bHaveStamp = !sRegPath.empty() && GetPathRegistryFileStamp( sRegPath, &stamp );
+	if ( bHaveStamp )
+	{
+		std::lock_guard< std::mutex > lock( s_mutexPathRegistryCache );
+		if ( s_pCachedPathRegistry && s_sCachedPathRegistryFilename == sRegPath && s_cachedPathRegistryStamp == stamp )
+		{
+			*pbLoaded = true;
+			return s_pCachedPathRegistry;
+		}
+	}
+
+	// If the file changes between the stat and the read we may cache new contents with the old 
+	// stamp, but then the next stat won't match and we'll just parse it again.
+	std::shared_ptr< CVRPathRegistry_Public > pPathReg = std::make_shared< CVRPathRegistry_Public >();
+	*pbLoaded = pPathReg->BLoadFromFile( psLoadError );
+
+	if ( *pbLoaded && bHaveStamp )
+	{
+		std::lock_guard< std::mutex > lock( s_mutexPathRegistryCache );
+		s_sCachedPathRegistryFilename = sRegPath;
+		s_cachedPathRegistryStamp = stamp;
+		s_pCachedPathRegistry = pPathReg;
+	}
+
+	return pPathReg;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Forgets the last parsed registry, so the next load parses the file 
+//			even if its stamp hasn't changed. A rewrite that keeps the size
+//			and lands in the same modification time tick looks unchanged.
+// ---------------------------------------------------------------------------
+static void EvictPathRegistryCache()
+{
+	std::lock_guard< std::mutex > lock( s_mutexPathRegistryCache );
+	s_pCachedPathRegistry.reset();
+}
+
+
 // ---------------------------------------------------------------------------
 // Purpose: Returns paths using the path registry and the provided override 
 //			values. Pass NULL for any paths you don't care about.
@@ -355,17 +682,19 @@ std::string CVRPathRegistry_Public::GetLogPath() const
 bool CVRPathRegistry_Public::GetPaths( std::string *psRuntimePath, std::string *psConfigPath, std::string *psLogPath, const char *pchConfigPathOverride, const char *pchLogPathOverride, std::vector<std::string> *pvecExternalDrivers )
 {
 	std::string sLoadError;
-	CVRPathRegistry_Public pathReg;
-	bool bLoadedRegistry = pathReg.BLoadFromFile( &sLoadError );
+	bool bLoadedRegistry = false;
+	std::shared_ptr< const CVRPathRegistry_Public > pPathReg = LoadPathRegistryCached( &bLoadedRegistry, &sLoadError );
+	const CVRPathRegistry_Public & pathReg = *pPathReg;
 	int nCountEnvironmentVariables = 0;
 	int nRequestedPaths = 0;
 
 	if( psRuntimePath )
 	{
 		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchRuntimeOverrideVar ).length() != 0 )
+		const char *pchEnvOverride = GetEnvironmentVariableCached( k_pchRuntimeOverrideVar );
+		if ( pchEnvOverride && *pchEnvOverride )
 		{
-			*psRuntimePath = GetEnvironmentVariable( k_pchRuntimeOverrideVar );
+			*psRuntimePath = pchEnvOverride;
 			nCountEnvironmentVariables++;
 		}
 		else if( !pathReg.GetRuntimePath().empty() )
@@ -381,9 +710,10 @@ bool CVRPathRegistry_Public::GetPaths( std::string *psRuntimePath, std::string *
 	if( psConfigPath )
 	{
 		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchConfigOverrideVar ).length() != 0 )
+		const char *pchEnvOverride = GetEnvironmentVariableCached( k_pchConfigOverrideVar );
+		if ( pchEnvOverride && *pchEnvOverride )
 		{
-			*psConfigPath = GetEnvironmentVariable( k_pchConfigOverrideVar );
+			*psConfigPath = pchEnvOverride;
 			nCountEnvironmentVariables++;
 		}
 		else if( pchConfigPathOverride )
@@ -403,9 +733,10 @@ bool CVRPathRegistry_Public::GetPaths( std::string *psRuntimePath, std::string *
 	if( psLogPath )
 	{
 		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchLogOverrideVar ).length() != 0 )
+		const char *pchEnvOverride = GetEnvironmentVariableCached( k_pchLogOverrideVar );
+		if ( pchEnvOverride && *pchEnvOverride )
 		{
-			*psLogPath = GetEnvironmentVariable( k_pchLogOverrideVar );
+			*psLogPath = pchEnvOverride;
 			nCountEnvironmentVariables++;
 		}
 		else if( pchLogPathOverride )
@@ -441,6 +772,382 @@ bool CVRPathRegistry_Public::GetPaths( std::string *psRuntimePath, std::string *
 }
 
 
+// ---------------------------------------------------------------------------
+// Purpose: Compares two snapshots
+// ---------------------------------------------------------------------------
+bool VRPathRegistrySnapshot_t::operator==( const VRPathRegistrySnapshot_t & other ) const
+{
+	return bLoaded == other.bLoaded
+		&& sRuntimePath == other.sRuntimePath
+		&& sConfigPath == other.sConfigPath
+		&& sLogPath == other.sLogPath
+		&& vecExternalDrivers == other.vecExternalDrivers;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Resolves the registry into a new snapshot
+// ---------------------------------------------------------------------------
+static std::shared_ptr< const VRPathRegistrySnapshot_t > LoadPathRegistrySnapshot()
+{
+	std::shared_ptr< VRPathRegistrySnapshot_t > pSnapshot = std::make_shared< VRPathRegistrySnapshot_t >();
+	pSnapshot->bLoaded = CVRPathRegistry_Public::GetPaths( &pSnapshot->sRuntimePath, &pSnapshot->sConfigPath, &pSnapshot->sLogPath, 
+		nullptr, nullptr, &pSnapshot->vecExternalDrivers );
+	return pSnapshot;
+}
+
+
+#if !defined( LINUX )
+// how often the watcher checks the registry file on platforms without inotify
+static const uint32_t k_unPathRegistryPollIntervalMs = 1000;
+#endif
+
+// ---------------------------------------------------------------------------
+// Purpose: Constructor
+// ---------------------------------------------------------------------------
+CVRPathRegistryWatcher_Public::CVRPathRegistryWatcher_Public()
+	: m_unNextSubscriptionId( 1 )
+	, m_unReloadCount( 0 )
+	, m_bStopping( false )
+{
+#if defined( LINUX )
+	m_nInotifyFd = -1;
+	m_nWatchDescriptor = -1;
+	m_bWatchingRegistryDirectory = false;
+	m_rnWakePipe[0] = m_rnWakePipe[1] = -1;
+#endif
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Destructor
+// ---------------------------------------------------------------------------
+CVRPathRegistryWatcher_Public::~CVRPathRegistryWatcher_Public()
+{
+	Stop();
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Loads the initial snapshot and starts the watcher thread
+// ---------------------------------------------------------------------------
+bool CVRPathRegistryWatcher_Public::BStart()
+{
+	if ( m_thread.joinable() )
+	{
+		if ( !m_bStopping )
+			return true;
+
+		// finish a Stop that a callback started; the watcher thread can't wait for itself
+		if ( std::this_thread::get_id() == m_thread.get_id() )
+			return false;
+		Stop();
+	}
+
+	m_sRegistryFilename = CVRPathRegistry_Public::GetVRPathRegistryFilename();
+	if ( m_sRegistryFilename.empty() )
+		return false;
+
+#if defined( LINUX )
+	m_nInotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	if ( m_nInotifyFd == -1 )
+		return false;
+
+	if ( !BArmWatch() || pipe2( m_rnWakePipe, O_CLOEXEC ) == -1 )
+	{
+		VRLog( "Unable to watch VR path registry directory %s\n", Path_StripFilename( m_sRegistryFilename ).c_str() );
+		close( m_nInotifyFd );
+		m_nInotifyFd = -1;
+		m_nWatchDescriptor = -1;
+		return false;
+	}
+#endif
+
+	// the initial snapshot isn't a change, so subscribers aren't told about it
+	std::shared_ptr< const VRPathRegistrySnapshot_t > pInitialSnapshot = LoadPathRegistrySnapshot();
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_pSnapshot = pInitialSnapshot;
+	}
+	m_unReloadCount = 0;
+
+	m_bStopping = false;
+	m_thread = std::thread( &CVRPathRegistryWatcher_Public::WatchThread, this );
+	return true;
+}
+
+
+#if defined( LINUX )
+// ---------------------------------------------------------------------------
+// Purpose: Watches the registry directory. If it doesn't exist yet, watches the 
+//			closest directory above it that does instead, so that the watch can
+//			move down as the missing directories are created. Watching the
+//			directory rather than the file means atomic replacement (write to a
+//			temp file, then rename over the registry) and deletion followed by 
+//			recreation are both seen.
+// ---------------------------------------------------------------------------
+bool CVRPathRegistryWatcher_Public::BArmWatch()
+{
+	if ( m_nWatchDescriptor != -1 )
+	{
+		inotify_rm_watch( m_nInotifyFd, m_nWatchDescriptor );
+		m_nWatchDescriptor = -1;
+	}
+
+	std::string sRegistryDirectory = Path_StripFilename( m_sRegistryFilename );
+	std::string sDirectory = sRegistryDirectory;
+	for ( ;; )
+	{
+		uint32_t unMask = sDirectory == sRegistryDirectory
+			? IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE
+			: IN_CREATE | IN_MOVED_TO;
+		m_nWatchDescriptor = inotify_add_watch( m_nInotifyFd, sDirectory.c_str(), unMask | IN_ONLYDIR );
+		if ( m_nWatchDescriptor != -1 )
+		{
+			m_bWatchingRegistryDirectory = sDirectory == sRegistryDirectory;
+			return true;
+		}
+
+		if ( errno != ENOENT && errno != ENOTDIR )
+			return false;
+
+		std::string sParent = Path_StripFilename( sDirectory );
+		if ( sParent.empty() && sDirectory != "/" && Path_IsAbsolute( sDirectory ) )
+			sParent = "/";
+		if ( sParent.empty() || sParent == sDirectory )
+			return false;
+		sDirectory = sParent;
+	}
+}
+#endif
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Stops the watcher thread. Subscriptions and the last snapshot are 
+//			kept. Called from a callback, this only tells the thread to stop;
+//			it exits once the callbacks return and is joined by the next 
+//			BStart, Stop or the destructor.
+// ---------------------------------------------------------------------------
+void CVRPathRegistryWatcher_Public::Stop()
+{
+	if ( !m_thread.joinable() )
+		return;
+
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_bStopping = true;
+	}
+	m_condStop.notify_all();
+#if defined( LINUX )
+	char chWake = 0;
+	if ( write( m_rnWakePipe[1], &chWake, 1 ) == -1 )
+	{
+		VRLog( "Unable to wake VR path registry watcher\n" );
+	}
+#endif
+
+	if ( std::this_thread::get_id() == m_thread.get_id() )
+		return;
+
+	m_thread.join();
+
+#if defined( LINUX )
+	close( m_nInotifyFd );
+	close( m_rnWakePipe[0] );
+	close( m_rnWakePipe[1] );
+	m_nInotifyFd = -1;
+	m_nWatchDescriptor = -1;
+	m_rnWakePipe[0] = m_rnWakePipe[1] = -1;
+#endif
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Returns the current snapshot
+// ---------------------------------------------------------------------------
+std::shared_ptr< const VRPathRegistrySnapshot_t > CVRPathRegistryWatcher_Public::GetSnapshot() const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_pSnapshot;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Registers a callback for new snapshots
+// ---------------------------------------------------------------------------
+uint32_t CVRPathRegistryWatcher_Public::Subscribe( const SnapshotCallback_t & fnCallback )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	uint32_t unSubscriptionId = m_unNextSubscriptionId++;
+	m_vecSubscriptions.push_back( std::make_pair( unSubscriptionId, fnCallback ) );
+	return unSubscriptionId;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Removes a callback registered with Subscribe
+// ---------------------------------------------------------------------------
+void CVRPathRegistryWatcher_Public::Unsubscribe( uint32_t unSubscriptionId )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	for ( auto i = m_vecSubscriptions.begin(); i != m_vecSubscriptions.end(); i++ )
+	{
+		if ( i->first == unSubscriptionId )
+		{
+			m_vecSubscriptions.erase( i );
+			break;
+		}
+	}
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Re-reads the registry and publishes a new snapshot if anything 
+//			changed. Returns true if a snapshot was published.
+// ---------------------------------------------------------------------------
+bool CVRPathRegistryWatcher_Public::BReload()
+{
+	// we were told the file changed, so don't trust the cached copy to have noticed
+	EvictPathRegistryCache();
+
+	std::shared_ptr< const VRPathRegistrySnapshot_t > pSnapshot = LoadPathRegistrySnapshot();
+
+	std::vector< SnapshotCallback_t > vecCallbacks;
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if ( m_pSnapshot && *m_pSnapshot == *pSnapshot )
+			return false;
+
+		m_pSnapshot = pSnapshot;
+		for ( auto & subscription : m_vecSubscriptions )
+		{
+			vecCallbacks.push_back( subscription.second );
+		}
+	}
+
+	m_unReloadCount++;
+
+	for ( auto & fnCallback : vecCallbacks )
+	{
+		fnCallback( pSnapshot );
+	}
+
+	return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Waits for the registry file to change and reloads it
+// ---------------------------------------------------------------------------
+void CVRPathRegistryWatcher_Public::WatchThread()
+{
+#if defined( LINUX )
+	std::string sRegistryName = Path_StripDirectory( m_sRegistryFilename );
+
+	// inotify_event records are variable length and must be read into an aligned buffer
+	alignas( struct inotify_event ) char rchEvents[ 4096 ];
+
+	while ( !m_bStopping )
+	{
+		struct pollfd rPollFds[2];
+		rPollFds[0].fd = m_nInotifyFd;
+		rPollFds[0].events = POLLIN;
+		rPollFds[1].fd = m_rnWakePipe[0];
+		rPollFds[1].events = POLLIN;
+
+		if ( poll( rPollFds, 2, -1 ) == -1 )
+		{
+			if ( errno == EINTR )
+				continue;
+			break;
+		}
+
+		if ( rPollFds[1].revents )
+			break;
+
+		// drain everything that is queued so a burst of events results in one reload
+		bool bRegistryChanged = false;
+		bool bRearmWatch = false;
+		for ( ;; )
+		{
+			ssize_t nRead = read( m_nInotifyFd, rchEvents, sizeof( rchEvents ) );
+			if ( nRead <= 0 )
+				break;
+
+			for ( char *pchEvent = rchEvents; pchEvent < rchEvents + nRead; )
+			{
+				const struct inotify_event *pEvent = ( const struct inotify_event * )pchEvent;
+				if ( pEvent->mask & IN_Q_OVERFLOW )
+				{
+					// events were dropped, so we can't tell what changed
+					bRegistryChanged = true;
+				}
+				else if ( pEvent->wd == m_nWatchDescriptor )
+				{
+					if ( pEvent->mask & IN_IGNORED )
+					{
+						// the watched directory was deleted
+						bRearmWatch = true;
+					}
+					else if ( !m_bWatchingRegistryDirectory )
+					{
+						// a directory on the way to the registry may have been created
+						bRearmWatch = bRearmWatch || pEvent->len;
+					}
+					else if ( pEvent->len && sRegistryName == pEvent->name )
+					{
+						bRegistryChanged = true;
+					}
+				}
+				pchEvent += sizeof( struct inotify_event ) + pEvent->len;
+			}
+		}
+
+		if ( bRearmWatch )
+		{
+			if ( !BArmWatch() )
+			{
+				VRLog( "Unable to watch VR path registry directory %s\n", Path_StripFilename( m_sRegistryFilename ).c_str() );
+				break;
+			}
+
+			// the registry may have been written before its directory was watched
+			bRegistryChanged = bRegistryChanged || m_bWatchingRegistryDirectory;
+		}
+
+		if ( bRegistryChanged )
+		{
+			BReload();
+		}
+	}
+#else
+	PathRegistryFileStamp_t lastStamp;
+	bool bHadStamp = GetPathRegistryFileStamp( m_sRegistryFilename, &lastStamp );
+
+	std::unique_lock< std::mutex > lock( m_mutex );
+	while ( !m_bStopping )
+	{
+		m_condStop.wait_for( lock, std::chrono::milliseconds( k_unPathRegistryPollIntervalMs ) );
+		if ( m_bStopping )
+			break;
+
+		lock.unlock();
+
+		PathRegistryFileStamp_t stamp;
+		bool bHasStamp = GetPathRegistryFileStamp( m_sRegistryFilename, &stamp );
+		if ( bHasStamp != bHadStamp || ( bHasStamp && !( stamp == lastStamp ) ) )
+		{
+			BReload();
+		}
+		bHadStamp = bHasStamp;
+		lastStamp = stamp;
+
+		lock.lock();
+	}
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 uint32_t CVRPathRegistry_Public::GetSteamAppId()
@@ -485,6 +1192,6 @@ uint32_t CVRPathRegistry_Public::InitSteamAppId()
 //-----------------------------------------------------------------------------
 bool CVRPathRegistry_Public::IsChildOfVRServer()
 {
-	std::string app_key = GetEnvironmentVariable( "STEAMVR_APPKEY" );
-	return app_key == "openvr.component.vrserver";
+	const char *pchAppKey = GetEnvironmentVariableCached( "STEAMVR_APPKEY" );
+	return pchAppKey && !strcmp( pchAppKey, "openvr.component.vrserver" );
 }
\ No newline at end of file
@@ -3,7 +3,14 @@
 
 #include <string>
 #include <vector>
+#include <unordered_set>
 #include <stdint.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
 
 static const char *k_pchRuntimeOverrideVar = "VR_OVERRIDE";
 static const char *k_pchConfigOverrideVar = "VR_CONFIG_PATH";
@@ -32,12 +39,22 @@ public:
 	bool BLoadFromFile( std::string *psError = nullptr );
 	bool BSaveToFile() const;
 
+	/** Adds a driver to the external driver list in the registry file. Only that list is rewritten, the rest of
+	* the file, including its line endings and any BOM, is left as it is. Returns true if the driver is in the
+	* list afterwards. */
+	static bool AddExternalDriver( const std::string & sDriverPath, std::string *psError = nullptr );
+
+	/** Removes a driver from the external driver list in the registry file. Only that list is rewritten, the rest
+	* of the file is left as it is. Returns true if the driver is not in the list afterwards. */
+	static bool RemoveExternalDriver( const std::string & sDriverPath, std::string *psError = nullptr );
+
 	bool ToJsonString( std::string &sJsonString );
 
 	// methods to get the current values
 	std::string GetRuntimePath() const;
 	std::string GetConfigPath() const;
 	std::string GetLogPath() const;
+	bool HasExternalDriver( const std::string & sDriverPath ) const;
 
 protected:
 	typedef std::vector< std::string > StringVector_t;
@@ -47,6 +64,72 @@ protected:
 	StringVector_t m_vecLogPath;
 	StringVector_t m_vecConfigPath;
 
-	// full list of external drivers
+	// full list of external drivers, without duplicates, in the order they were first listed
 	StringVector_t m_vecExternalDrivers;
+	std::unordered_set< std::string > m_setExternalDrivers;
+};
+
+
+/** The paths the registry resolved to at one point in time. Never modified once it has been published. */
+struct VRPathRegistrySnapshot_t
+{
+	bool bLoaded; // false if the registry file couldn't be read
+	std::string sRuntimePath;
+	std::string sConfigPath;
+	std::string sLogPath;
+	std::vector< std::string > vecExternalDrivers;
+
+	bool operator==( const VRPathRegistrySnapshot_t & other ) const;
+	bool operator!=( const VRPathRegistrySnapshot_t & other ) const { return !( *this == other ); }
+};
+
+
+/** Watches the path registry file and publishes a new snapshot only when what it resolves to changes. 
+* On Linux this uses inotify on the directory containing the registry, or the closest existing directory
+* above it until that is created. On other platforms it polls the file's size and modification time. 
+* Callbacks are called on the watcher thread. They may call Stop, but must not destroy the watcher. */
+class CVRPathRegistryWatcher_Public
+{
+public:
+	typedef std::function< void( const std::shared_ptr< const VRPathRegistrySnapshot_t > & ) > SnapshotCallback_t;
+
+	CVRPathRegistryWatcher_Public();
+	~CVRPathRegistryWatcher_Public();
+
+	/** Loads the initial snapshot and starts watching. Returns false if the registry location can't be watched. */
+	bool BStart();
+	void Stop();
+
+	/** Returns the current snapshot. Safe to call from any thread. */
+	std::shared_ptr< const VRPathRegistrySnapshot_t > GetSnapshot() const;
+
+	/** Number of snapshots published since BStart, not counting the initial one */
+	uint32_t GetReloadCount() const { return m_unReloadCount; }
+
+	/** Registers a callback for new snapshots. Returns an id to pass to Unsubscribe. */
+	uint32_t Subscribe( const SnapshotCallback_t & fnCallback );
+	void Unsubscribe( uint32_t unSubscriptionId );
+
+private:
+	void WatchThread();
+	bool BReload();
+
+	mutable std::mutex m_mutex;
+	std::shared_ptr< const VRPathRegistrySnapshot_t > m_pSnapshot;
+	std::vector< std::pair< uint32_t, SnapshotCallback_t > > m_vecSubscriptions;
+	uint32_t m_unNextSubscriptionId;
+	std::atomic< uint32_t > m_unReloadCount;
+
+	std::string m_sRegistryFilename;
+	std::thread m_thread;
+	std::atomic< bool > m_bStopping;
+	std::condition_variable m_condStop;
+#if defined( LINUX )
+	bool BArmWatch();
+
+	int m_nInotifyFd;
+	int m_nWatchDescriptor;
+	bool m_bWatchingRegistryDirectory;
+	int m_rnWakePipe[2];
+#endif
 };
@@ -0,0 +1,255 @@
+//========= Copyright Valve Corporation ============//
+// Drives VR_InitInternalAsync against a stub vrclient that sleeps in Init.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace vr;
+
+static const uint32_t k_unInitDelayMs = 200;
+
+struct AsyncInitResult_t
+{
+	std::atomic<bool> bDone;
+	std::atomic<int> nCallbacks;
+	EVRInitError eError;
+	uint32_t unToken;
+};
+
+static void VR_CALLTYPE OnAsyncInitDone( EVRInitError eError, uint32_t unToken, void *pContext )
+{
+	AsyncInitResult_t *pResult = static_cast< AsyncInitResult_t * >( pContext );
+	pResult->eError = eError;
+	pResult->unToken = unToken;
+	++pResult->nCallbacks;
+	pResult->bDone = true;
+}
+
+static void WaitForCallback( AsyncInitResult_t &result )
+{
+	double flTimeout = VRTest_Seconds() + 10.0;
+	while ( !result.bDone && VRTest_Seconds() < flTimeout )
+	{
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	}
+	VRTEST_CHECK( result.bDone );
+}
+
+static void ResetResult( AsyncInitResult_t &result )
+{
+	result.bDone = false;
+	result.nCallbacks = 0;
+	result.eError = VRInitError_Unknown;
+	result.unToken = 0;
+}
+
+// Lookups fail fast while the init is in flight, and succeed once it completes
+static void TestSuccessfulInit()
+{
+	AsyncInitResult_t result;
+	ResetResult( result );
+
+	double flStart = VRTest_Seconds();
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, OnAsyncInitDone, &result ) );
+	VRTEST_CHECK( VRTest_Seconds() - flStart < k_unInitDelayMs / 2000.0 );
+
+	// only one async init at a time
+	VRTEST_CHECK( !VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+
+	EVRInitError eError = VRInitError_None;
+	uint32_t unToken = 0;
+	VRTEST_CHECK( !VR_PollAsyncInit( &eError, &unToken ) );
+
+	flStart = VRTest_Seconds();
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) == nullptr );
+	VRTEST_CHECK( eError == VRInitError_Init_NotInitialized );
+	VRTEST_CHECK( !VR_IsInterfaceVersionValid( IVRSystem_Version ) );
+	VRTEST_CHECK( VRTest_Seconds() - flStart < k_unInitDelayMs / 2000.0 );
+
+	WaitForCallback( result );
+	VRTEST_CHECK( result.nCallbacks == 1 );
+	VRTEST_CHECK( result.eError == VRInitError_None );
+	VRTEST_CHECK( result.unToken != 0 );
+	VRTEST_CHECK( VR_GetInitToken() == result.unToken );
+
+	VRTEST_CHECK( VR_PollAsyncInit( &eError, &unToken ) );
+	VRTEST_CHECK( eError == VRInitError_None );
+	VRTEST_CHECK( unToken == result.unToken );
+
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) != nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	// a shutdown makes the async result stale
+	VR_ShutdownInternal();
+	VRTEST_CHECK( !VR_PollAsyncInit( &eError, &unToken ) );
+}
+
+// A failed init reports its error and a zero token
+static void TestFailedInit()
+{
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_ERROR, "108" ); // VRInitError_Init_HmdNotFound
+
+	AsyncInitResult_t result;
+	ResetResult( result );
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, OnAsyncInitDone, &result ) );
+	WaitForCallback( result );
+	VRTEST_CHECK( result.eError == VRInitError_Init_HmdNotFound );
+	VRTEST_CHECK( result.unToken == 0 );
+
+	EVRInitError eError = VRInitError_None;
+	uint32_t unToken = 1;
+	VRTEST_CHECK( VR_PollAsyncInit( &eError, &unToken ) );
+	VRTEST_CHECK( eError == VRInitError_Init_HmdNotFound );
+	VRTEST_CHECK( unToken == 0 );
+
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_ERROR, "" );
+}
+
+// Shutdown waits for an init in flight, and a later synchronous init makes the async result stale
+static void TestShutdownAndSyncInitDuringAsyncInit()
+{
+	StubVRClientStats_t statsBefore = VRTest_GetStubStats();
+
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+	VR_ShutdownInternal();
+
+	StubVRClientStats_t statsAfter = VRTest_GetStubStats();
+	VRTEST_CHECK( statsAfter.unInitCalls == statsBefore.unInitCalls + 1 );
+	VRTEST_CHECK( statsAfter.unCleanupCalls == statsBefore.unCleanupCalls + 1 );
+
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+	EVRInitError eError = VRInitError_Unknown;
+	uint32_t unSyncToken = VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+	VRTEST_CHECK( unSyncToken == VR_GetInitToken() );
+
+	uint32_t unToken = 0;
+	VRTEST_CHECK( !VR_PollAsyncInit( &eError, &unToken ) );
+
+	VR_ShutdownInternal();
+	VR_ShutdownInternal();
+}
+
+// An earlier synchronous init still answers lookups while an async init is in flight
+static void TestLookupsDuringAsyncInitAfterSyncInit()
+{
+	EVRInitError eError = VRInitError_Unknown;
+	VRTEST_CHECK( VR_InitInternal2( &eError, VRApplication_Background, nullptr ) != 0 );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+	eError = VRInitError_Unknown;
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) != nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+	VRTEST_CHECK( VR_IsInterfaceVersionValid( IVRSystem_Version ) );
+
+	VR_ShutdownInternal();
+	VR_ShutdownInternal();
+}
+
+struct SlowCallback_t
+{
+	std::atomic<bool> bStarted;
+	std::atomic<bool> bFinished;
+	uint32_t unTokenInCallback;
+};
+
+static void VR_CALLTYPE OnAsyncInitDoneSlowly( EVRInitError eError, uint32_t unToken, void *pContext )
+{
+	SlowCallback_t *pCallback = static_cast< SlowCallback_t * >( pContext );
+	pCallback->bStarted = true;
+	std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+	pCallback->unTokenInCallback = VR_GetInitToken();
+	pCallback->bFinished = true;
+}
+
+// A shutdown that sees the init finish still waits for the callback, so its token is live throughout
+static void TestShutdownWaitsForCallback()
+{
+	SlowCallback_t callback;
+	callback.bStarted = false;
+	callback.bFinished = false;
+	callback.unTokenInCallback = 0;
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, OnAsyncInitDoneSlowly, &callback ) );
+
+	double flTimeout = VRTest_Seconds() + 10.0;
+	while ( !callback.bStarted && VRTest_Seconds() < flTimeout )
+	{
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	}
+	uint32_t unToken = VR_GetInitToken();
+	VR_ShutdownInternal();
+	VRTEST_CHECK( callback.bFinished );
+	VRTEST_CHECK( callback.unTokenInCallback == unToken );
+}
+
+static void VR_CALLTYPE OnAsyncInitDoneShutDown( EVRInitError eError, uint32_t unToken, void *pContext )
+{
+	// can't start another init from the loader thread, but can shut this one down
+	VRTEST_CHECK( !VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+	VR_ShutdownInternal();
+	static_cast< AsyncInitResult_t * >( pContext )->bDone = true;
+}
+
+// The callback may shut down the init it reports
+static void TestShutdownFromCallback()
+{
+	AsyncInitResult_t result;
+	ResetResult( result );
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, OnAsyncInitDoneShutDown, &result ) );
+	WaitForCallback( result );
+
+	EVRInitError eError = VRInitError_None;
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) == nullptr );
+	VRTEST_CHECK( eError == VRInitError_Init_NotInitialized );
+
+	// the next init joins the old loader thread
+	ResetResult( result );
+	VRTEST_CHECK( VR_InitInternalAsync( VRApplication_Background, nullptr, OnAsyncInitDone, &result ) );
+	WaitForCallback( result );
+	VRTEST_CHECK( result.eError == VRInitError_None );
+	VR_ShutdownInternal();
+}
+
+// No async init can start while a synchronous init or shutdown is running
+static void TestAsyncInitRefusedDuringSyncInit()
+{
+	std::atomic<bool> bSyncDone( false );
+	std::thread syncThread( [&bSyncDone]()
+	{
+		EVRInitError eError = VRInitError_Unknown;
+		VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+		VRTEST_CHECK( eError == VRInitError_None );
+		bSyncDone = true;
+	} );
+
+	// the stub sleeps in Init, so the sync init is still running here
+	std::this_thread::sleep_for( std::chrono::milliseconds( k_unInitDelayMs / 4 ) );
+	VRTEST_CHECK( !bSyncDone );
+	VRTEST_CHECK( !VR_InitInternalAsync( VRApplication_Background, nullptr, nullptr, nullptr ) );
+	syncThread.join();
+
+	EVRInitError eError = VRInitError_None;
+	uint32_t unToken = 0;
+	VRTEST_CHECK( !VR_PollAsyncInit( &eError, &unToken ) );
+	VR_ShutdownInternal();
+}
+
+int main()
+{
+	VRTest_UseStubRuntime();
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_DELAY_MS, std::to_string( k_unInitDelayMs ).c_str() );
+
+	TestSuccessfulInit();
+	TestFailedInit();
+	TestShutdownAndSyncInitDuringAsyncInit();
+	TestLookupsDuringAsyncInitAfterSyncInit();
+	TestShutdownWaitsForCallback();
+	TestShutdownFromCallback();
+	TestAsyncInitRefusedDuringSyncInit();
+
+	return VRTest_Result( "asyncinit_test" );
+}
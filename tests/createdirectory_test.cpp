@@ -0,0 +1,111 @@
+//========= Copyright Valve Corporation ============//
+// Counts the mkdir and stat calls BCreateDirectoryRecursive makes for the cases it is tuned for, and
+// checks it never makes more than the version it replaced. The counts assume nothing else in the
+// program has called it yet, so that its cache of recent directories starts out empty.
+#include "vrtest.h"
+#include "createdirectoryshim.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <sys/stat.h>
+
+static const std::string k_sTestDir = std::string( STUB_VRPATH_FILE ) + ".createdirectory";
+
+static bool BIsDirectory( const std::string & sPath )
+{
+	struct stat statBuf;
+	return stat( sPath.c_str(), &statBuf ) == 0 && S_ISDIR( statBuf.st_mode );
+}
+
+// Creates the directory and returns the number of mkdir calls it took. It must never stat.
+static uint64_t CountMkdirs( const std::string & sPath )
+{
+	CreateDirectorySyscalls_t before = CreateDirectoryShim_GetSyscalls();
+	VRTEST_CHECK( BCreateDirectoryRecursive( sPath.c_str() ) );
+	CreateDirectorySyscalls_t after = CreateDirectoryShim_GetSyscalls();
+
+	VRTEST_CHECK( after.unStat == before.unStat );
+	VRTEST_CHECK( BIsDirectory( sPath ) );
+	return after.unMkdir - before.unMkdir;
+}
+
+// What the old version took for the same path, in mkdir and stat calls together
+static uint64_t CountReferenceSyscalls( const std::string & sPath )
+{
+	CreateDirectorySyscalls_t before = CreateDirectoryShim_GetSyscalls();
+	VRTEST_CHECK( reference::BCreateDirectoryRecursive( sPath.c_str() ) );
+	CreateDirectorySyscalls_t after = CreateDirectoryShim_GetSyscalls();
+	return after.unMkdir - before.unMkdir + after.unStat - before.unStat;
+}
+
+static void TestSyscallCounts()
+{
+	Path_DeleteDirectory( k_sTestDir, true );
+	const std::string sDeep = Path_Join( k_sTestDir, "a/b/c/d", '/' );
+
+	// the parent exists, or the directory itself does: just the one mkdir
+	VRTEST_CHECK( CountMkdirs( k_sTestDir ) == 1 );
+	VRTEST_CHECK( CountMkdirs( k_sTestDir ) == 1 );
+	VRTEST_CHECK( CountMkdirs( k_sTestDir + "/" ) == 1 );
+
+	// Four levels missing and nothing cached: the full path, up to a/b/c, a/b and a (which
+	// works), then down again to a/b, a/b/c and the full path
+	VRTEST_CHECK( CountMkdirs( sDeep ) == 7 );
+	VRTEST_CHECK( CountMkdirs( sDeep ) == 1 );
+	VRTEST_CHECK( CountMkdirs( Path_Join( k_sTestDir, "a/b/c/sibling", '/' ) ) == 1 );
+
+	// a is cached now, so three levels below it start there: the full path, then x, y and z
+	VRTEST_CHECK( CountMkdirs( Path_Join( k_sTestDir, "a/x/y/z", '/' ) ) == 4 );
+
+	// a stale cache entry costs one failed mkdir before falling back to the search
+	VRTEST_CHECK( Path_DeleteDirectory( Path_Join( k_sTestDir, "a", '/' ), true ) );
+	VRTEST_CHECK( CountMkdirs( Path_Join( k_sTestDir, "a/b/c/q", '/' ) ) == 8 );
+	VRTEST_CHECK( CountMkdirs( Path_Join( k_sTestDir, "a/b/c/q", '/' ) ) == 1 );
+}
+
+// Never more calls than before, on the same sequence of paths
+static void TestAgainstReference()
+{
+	static const char *k_rgpchPaths[] = { "", "one", "one/two", "one/two/three/four/five", "one/two/three/four/five",
+		"one/two/three/four/six", "one/seven/eight", "nine/ten/eleven/twelve" };
+
+	Path_DeleteDirectory( k_sTestDir, true );
+	std::vector< uint64_t > vecReference;
+	for ( const char *pchPath : k_rgpchPaths )
+		vecReference.push_back( CountReferenceSyscalls( *pchPath ? Path_Join( k_sTestDir, pchPath, '/' ) : k_sTestDir ) );
+
+	Path_DeleteDirectory( k_sTestDir, true );
+	for ( size_t i = 0; i < vecReference.size(); ++i )
+	{
+		std::string sPath = *k_rgpchPaths[ i ] ? Path_Join( k_sTestDir, k_rgpchPaths[ i ], '/' ) : k_sTestDir;
+		uint64_t unMkdirs = CountMkdirs( sPath );
+		if ( unMkdirs > vecReference[ i ] )
+		{
+			fprintf( stderr, "%s: %llu syscalls, %llu before\n", k_rgpchPaths[ i ], (unsigned long long)unMkdirs, (unsigned long long)vecReference[ i ] );
+			VRTEST_CHECK( false );
+		}
+	}
+
+	Path_DeleteDirectory( k_sTestDir, true );
+}
+
+// A file in the way is an error, wherever on the path it is
+static void TestFileInTheWay()
+{
+	VRTEST_CHECK( BCreateDirectoryRecursive( k_sTestDir.c_str() ) );
+	const std::string sFile = Path_Join( k_sTestDir, "file", '/' );
+	VRTEST_CHECK( Path_WriteStringToTextFile( sFile, "" ) );
+	VRTEST_CHECK( !BCreateDirectoryRecursive( Path_Join( sFile, "below", '/' ).c_str() ) );
+	VRTEST_CHECK( !BCreateDirectoryRecursive( Path_Join( sFile, "below/further", '/' ).c_str() ) );
+	Path_DeleteDirectory( k_sTestDir, true );
+}
+
+int main()
+{
+	TestSyscallCounts();
+	TestAgainstReference();
+	TestFileInTheWay();
+
+	return VRTest_Result( "createdirectory_test" );
+}
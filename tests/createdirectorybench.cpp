@@ -0,0 +1,90 @@
+//========= Copyright Valve Corporation ============//
+// Times BCreateDirectoryRecursive against the version it replaced on a deep log directory that
+// already exists, one whose parent exists, and one with four levels missing, and reports the mkdir
+// and stat calls each makes. Once directories are being made, the file system's own cost swamps the
+// difference in calls, so the counts are the numbers to compare there.
+#include "vrtest.h"
+#include "createdirectoryshim.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <unistd.h>
+
+static const std::string k_sBenchDir = std::string( STUB_VRPATH_FILE ) + ".createdirectorybench";
+
+typedef bool ( *CreateDirectoryFn_t )( const char *pchPath );
+
+static void Report( const char *pchName, uint64_t unIterations, double flSeconds, const CreateDirectorySyscalls_t & before )
+{
+	CreateDirectorySyscalls_t after = CreateDirectoryShim_GetSyscalls();
+	VRTest_Report( pchName, unIterations, flSeconds );
+	printf( "%-48s %10.2f mkdir/op %6.2f stat/op\n", "", (double)( after.unMkdir - before.unMkdir ) / unIterations,
+		(double)( after.unStat - before.unStat ) / unIterations );
+}
+
+enum ECreateDirectoryCase
+{
+	k_ECreateDirectoryCase_Exists,
+	k_ECreateDirectoryCase_ParentExists,
+	k_ECreateDirectoryCase_FourMissing,
+};
+
+static void BenchCase( ECreateDirectoryCase eCase, const char *pchName, CreateDirectoryFn_t pfnCreate, uint64_t unIterations )
+{
+	const std::string sRoot = Path_Join( k_sBenchDir, pchName, '/' );
+	const std::string sLogs = Path_Join( sRoot, "config/steamvr/logs/2026/10/session", '/' );
+	VRTEST_CHECK( pfnCreate( sLogs.c_str() ) );
+
+	std::string sCase;
+	CreateDirectorySyscalls_t before = CreateDirectoryShim_GetSyscalls();
+	double flStart = VRTest_Seconds();
+	switch ( eCase )
+	{
+	case k_ECreateDirectoryCase_Exists:
+		sCase = ", exists";
+		for ( uint64_t i = 0; i < unIterations; ++i )
+			VRTEST_CHECK( pfnCreate( sLogs.c_str() ) );
+		break;
+
+	case k_ECreateDirectoryCase_ParentExists:
+		// the rmdir is in both timings, but isn't counted
+		sCase = ", parent exists";
+		for ( uint64_t i = 0; i < unIterations; ++i )
+		{
+			std::string sLeaf = Path_Join( sLogs, "leaf", '/' );
+			VRTEST_CHECK( pfnCreate( sLeaf.c_str() ) );
+			VRTEST_CHECK( rmdir( sLeaf.c_str() ) == 0 );
+		}
+		break;
+
+	case k_ECreateDirectoryCase_FourMissing:
+		sCase = ", 4 levels missing";
+		for ( uint64_t i = 0; i < unIterations; ++i )
+		{
+			std::string sSession = Path_Join( sLogs, "session" + std::to_string( i ) + "/a/b/c", '/' );
+			VRTEST_CHECK( pfnCreate( sSession.c_str() ) );
+		}
+		break;
+	}
+	Report( ( pchName + sCase ).c_str(), unIterations, VRTest_Seconds() - flStart, before );
+
+	Path_DeleteDirectory( sRoot, true );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 20000, flScale );
+
+	// each case runs both versions back to back, so that they see the file system in the same state
+	Path_DeleteDirectory( k_sBenchDir, true );
+	for ( ECreateDirectoryCase eCase : { k_ECreateDirectoryCase_Exists, k_ECreateDirectoryCase_ParentExists, k_ECreateDirectoryCase_FourMissing } )
+	{
+		BenchCase( eCase, "old", reference::BCreateDirectoryRecursive, unIterations );
+		BenchCase( eCase, "BCreateDirectoryRecursive", BCreateDirectoryRecursive, unIterations );
+	}
+	Path_DeleteDirectory( k_sBenchDir, true );
+
+	return VRTest_Result( "createdirectorybench" );
+}
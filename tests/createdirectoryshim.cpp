@@ -0,0 +1,134 @@
+//========= Copyright Valve Corporation ============//
+#include "createdirectoryshim.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <atomic>
+
+static std::atomic< uint64_t > s_unMkdir( 0 );
+static std::atomic< uint64_t > s_unStat( 0 );
+
+// The linker sends every call to these through the __wrap_ versions, and __real_ is the libc one
+extern "C"
+{
+int __real_mkdir( const char *pchPath, mode_t unMode );
+int __real_mkdirat( int nDirFd, const char *pchPath, mode_t unMode );
+int __real_stat( const char *pchPath, struct stat *pStat );
+int __real_lstat( const char *pchPath, struct stat *pStat );
+int __real_fstatat( int nDirFd, const char *pchPath, struct stat *pStat, int nFlags );
+
+int __wrap_mkdir( const char *pchPath, mode_t unMode )
+{
+	++s_unMkdir;
+	return __real_mkdir( pchPath, unMode );
+}
+
+int __wrap_mkdirat( int nDirFd, const char *pchPath, mode_t unMode )
+{
+	++s_unMkdir;
+	return __real_mkdirat( nDirFd, pchPath, unMode );
+}
+
+int __wrap_stat( const char *pchPath, struct stat *pStat )
+{
+	++s_unStat;
+	return __real_stat( pchPath, pStat );
+}
+
+int __wrap_lstat( const char *pchPath, struct stat *pStat )
+{
+	++s_unStat;
+	return __real_lstat( pchPath, pStat );
+}
+
+int __wrap_fstatat( int nDirFd, const char *pchPath, struct stat *pStat, int nFlags )
+{
+	++s_unStat;
+	return __real_fstatat( nDirFd, pchPath, pStat, nFlags );
+}
+}
+
+CreateDirectorySyscalls_t CreateDirectoryShim_GetSyscalls()
+{
+	CreateDirectorySyscalls_t syscalls;
+	syscalls.unMkdir = s_unMkdir;
+	syscalls.unStat = s_unStat;
+	return syscalls;
+}
+
+namespace reference
+{
+
+static bool Path_IsDirectory( const char *pchPath )
+{
+	struct stat buf;
+	if ( stat( pchPath, &buf ) == -1 )
+		return false;
+	return S_ISDIR( buf.st_mode );
+}
+
+static bool BCreateDirectory( const char *pchPath )
+{
+	int i = mkdir( pchPath, S_IRWXU | S_IRWXG | S_IRWXO );
+	if ( i == 0 )
+		return true;
+	if ( errno == EEXIST )
+		return true;
+
+	return false;
+}
+
+bool BCreateDirectoryRecursive( const char *pchPath )
+{
+	// Does it already exist?
+	if ( Path_IsDirectory( pchPath ) )
+		return true;
+
+	// copy the path into something we can munge
+	int len = (int)strlen( pchPath );
+	char *path = (char *)malloc( len + 1 );
+	strcpy( path, pchPath );
+
+	// Walk backwards to first non-existing dir that we find
+	char *s = path + len - 1;
+
+	const char slash = '/';
+	while ( s > path )
+	{
+		if ( *s == slash )
+		{
+			*s = '\0';
+			bool bExists = Path_IsDirectory( path );
+			*s = slash;
+
+			if ( bExists )
+			{
+				++s;
+				break;
+			}
+		}
+		--s;
+	}
+
+	// and then move forwards from there
+
+	while ( *s )
+	{
+		if ( *s == slash )
+		{
+			*s = '\0';
+			BCreateDirectory( path );
+			*s = slash;
+		}
+		s++;
+	}
+
+	bool bRetVal = BCreateDirectory( path );
+	free( path );
+	return bRetVal;
+}
+
+} // namespace reference
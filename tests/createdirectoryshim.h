@@ -0,0 +1,23 @@
+//========= Copyright Valve Corporation ============//
+// A counting shim for the syscalls BCreateDirectoryRecursive makes, shared by its test and its
+// benchmark. Programs that use it link with --wrap for each call counted, so the counts include
+// the calls made inside the client library.
+#pragma once
+
+#include <stdint.h>
+
+struct CreateDirectorySyscalls_t
+{
+	uint64_t unMkdir;	// mkdir and mkdirat
+	uint64_t unStat;	// stat, lstat and fstatat
+};
+
+CreateDirectorySyscalls_t CreateDirectoryShim_GetSyscalls();
+
+namespace reference
+{
+
+// BCreateDirectoryRecursive as it was before it started with mkdir on the full path
+bool BCreateDirectoryRecursive( const char *pchPath );
+
+} // namespace reference
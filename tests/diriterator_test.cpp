@@ -0,0 +1,115 @@
+//========= Copyright Valve Corporation ============//
+// Tests the getdents64 based CDirIterator on Linux: every matching entry comes back once, '.' and
+// '..' are skipped, and the stat based accessors agree with stat.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <set>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const std::string k_sTestDir = std::string( STUB_VRPATH_FILE ) + ".diriterator";
+
+static void WriteFile( const std::string & sName, const char *pchContents )
+{
+	VRTEST_CHECK( Path_WriteStringToTextFile( Path_Join( k_sTestDir, sName, '/' ), pchContents ) );
+}
+
+static std::set< std::string > ListNames( const char *pchPattern )
+{
+	std::set< std::string > setNames;
+	CDirIterator iterator( k_sTestDir.c_str(), pchPattern );
+	while ( iterator.BNextFile() )
+	{
+		VRTEST_CHECK( setNames.insert( iterator.CurrentFileName() ).second );
+	}
+	return setNames;
+}
+
+static void TestListing()
+{
+	Path_DeleteDirectory( k_sTestDir, true );
+	VRTEST_CHECK( BCreateDirectoryRecursive( Path_Join( k_sTestDir, "sub", '/' ).c_str() ) );
+	WriteFile( "a.txt", "a" );
+	WriteFile( "B.TXT", "bb" );
+	WriteFile( "c.json", "{}" );
+	WriteFile( ".hidden", "" );
+	VRTEST_CHECK( symlink( "sub", Path_Join( k_sTestDir, "link", '/' ).c_str() ) == 0 );
+
+	std::set< std::string > setAll = { "a.txt", "B.TXT", "c.json", ".hidden", "sub", "link" };
+	VRTEST_CHECK( ListNames( "*" ) == setAll );
+	VRTEST_CHECK( ListNames( "*.*" ) == setAll );
+	VRTEST_CHECK( ListNames( "*.txt" ) == std::set< std::string >( { "a.txt", "B.TXT" } ) );
+	VRTEST_CHECK( ListNames( "?.json" ) == std::set< std::string >( { "c.json" } ) );
+
+	CDirIterator iterator( k_sTestDir.c_str(), "*" );
+	VRTEST_CHECK( iterator.IsValid() );
+	while ( iterator.BNextFile() )
+	{
+		std::string sName = iterator.CurrentFileName();
+		struct stat statBuf;
+		VRTEST_CHECK( stat( Path_Join( k_sTestDir, sName, '/' ).c_str(), &statBuf ) == 0 );
+
+		// directories are told apart by d_type, but a link to one needs a stat
+		VRTEST_CHECK( iterator.BCurrentIsDir() == ( sName == "sub" || sName == "link" ) );
+		VRTEST_CHECK( iterator.CurrentFileLength() == (int64_t)statBuf.st_size );
+		VRTEST_CHECK( iterator.CurrentFileWriteTime() == (int64_t)statBuf.st_mtime );
+		VRTEST_CHECK( iterator.CurrentFileCreateTime() == (int64_t)statBuf.st_ctime );
+		VRTEST_CHECK( !iterator.BCurrentIsSystem() );
+	}
+	VRTEST_CHECK( !iterator.BNextFile() );
+}
+
+// Like FindFirstFile, an iterator with nothing to return isn't valid
+static void TestNothingToList()
+{
+	CDirIterator noMatches( k_sTestDir.c_str(), "*.none" );
+	VRTEST_CHECK( !noMatches.IsValid() );
+	VRTEST_CHECK( !noMatches.BNextFile() );
+
+	CDirIterator missing( ( k_sTestDir + ".missing" ).c_str(), "*" );
+	VRTEST_CHECK( !missing.IsValid() );
+	VRTEST_CHECK( !missing.BNextFile() );
+
+	CDirIterator noPath( nullptr, "*" );
+	VRTEST_CHECK( !noPath.IsValid() );
+	VRTEST_CHECK( !noPath.BNextFile() );
+
+	// a file isn't a directory to list
+	CDirIterator notDirectory( Path_Join( k_sTestDir, "a.txt", '/' ).c_str(), "*" );
+	VRTEST_CHECK( !notDirectory.IsValid() );
+}
+
+// Enough long names that the directory takes many getdents64 calls to read
+static void TestManyEntries()
+{
+	Path_DeleteDirectory( k_sTestDir, true );
+	VRTEST_CHECK( BCreateDirectoryRecursive( k_sTestDir.c_str() ) );
+
+	std::set< std::string > setExpected;
+	for ( int i = 0; i < 3000; ++i )
+	{
+		std::string sName = "file_with_a_reasonably_long_name_so_the_entries_take_up_room_" + std::to_string( i );
+		if ( i % 3 == 0 )
+			sName += ".txt";
+		WriteFile( sName, "" );
+		if ( i % 3 == 0 )
+			setExpected.insert( sName );
+	}
+
+	VRTEST_CHECK( ListNames( "*" ).size() == 3000 );
+	VRTEST_CHECK( ListNames( "*.txt" ) == setExpected );
+
+	Path_DeleteDirectory( k_sTestDir, true );
+}
+
+int main()
+{
+	TestListing();
+	TestNothingToList();
+	TestManyEntries();
+
+	return VRTest_Result( "diriterator_test" );
+}
@@ -0,0 +1,124 @@
+//========= Copyright Valve Corporation ============//
+// Times CDirIterator over a directory of 100k entries against scandir plus a stat per entry, which
+// is how the Linux iterator worked before it streamed the directory with getdents64.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const std::string k_sBenchDir = std::string( STUB_VRPATH_FILE ) + ".diriteratorbench";
+
+// One in a hundred entries is a .json file, for the filtered runs
+static void CreateEntries( uint32_t unEntries )
+{
+	Path_DeleteDirectory( k_sBenchDir, true );
+	VRTEST_CHECK( BCreateDirectoryRecursive( k_sBenchDir.c_str() ) );
+	for ( uint32_t i = 0; i < unEntries; ++i )
+	{
+		std::string sName = "entry" + std::to_string( i ) + ( i % 100 == 0 ? ".json" : ".bin" );
+		VRTEST_CHECK( Path_WriteStringToTextFile( Path_Join( k_sBenchDir, sName, '/' ), "" ) );
+	}
+}
+
+// scandir's filter has no context pointer
+static CFilenamePattern s_scandirPattern;
+
+static int ScandirSelect( const struct dirent *pEntry )
+{
+	if ( !strcmp( pEntry->d_name, "." ) || !strcmp( pEntry->d_name, ".." ) )
+		return 0;
+	return s_scandirPattern.BMatches( pEntry->d_name ) ? 1 : 0;
+}
+
+// What _findfirst/_findnext did: read and sort the whole directory, then stat every match
+static uint32_t ListWithScandir( const char *pchPattern )
+{
+	s_scandirPattern.Compile( pchPattern );
+	struct dirent **ppEntries = nullptr;
+	int nEntries = scandir( k_sBenchDir.c_str(), &ppEntries, ScandirSelect, alphasort );
+	uint32_t unFound = 0;
+	for ( int i = 0; i < nEntries; ++i )
+	{
+		struct stat statBuf;
+		std::string sPath = Path_Join( k_sBenchDir, ppEntries[ i ]->d_name, '/' );
+		if ( stat( sPath.c_str(), &statBuf ) == 0 )
+			++unFound;
+		free( ppEntries[ i ] );
+	}
+	free( ppEntries );
+	return unFound;
+}
+
+enum EIteratorWork
+{
+	k_EIteratorWork_Names,
+	k_EIteratorWork_IsDir,
+	k_EIteratorWork_Length,
+};
+
+static uint32_t ListWithIterator( const char *pchPattern, EIteratorWork eWork )
+{
+	uint32_t unFound = 0;
+	int64_t nTotalLength = 0;
+	CDirIterator iterator( k_sBenchDir.c_str(), pchPattern );
+	while ( iterator.BNextFile() )
+	{
+		if ( eWork == k_EIteratorWork_IsDir )
+			VRTEST_CHECK( !iterator.BCurrentIsDir() );
+		else if ( eWork == k_EIteratorWork_Length )
+			nTotalLength += iterator.CurrentFileLength();
+		++unFound;
+	}
+	VRTEST_CHECK( nTotalLength == 0 );
+	return unFound;
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint32_t unEntries = (uint32_t)VRTest_Scaled( 100000, flScale );
+	const uint32_t unJsonEntries = ( unEntries + 99 ) / 100;
+	const uint64_t unIterations = VRTest_Scaled( 5, flScale );
+
+	CreateEntries( unEntries );
+	std::string sSuffix = ", " + std::to_string( unEntries ) + " entries";
+
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithScandir( "*" ) == unEntries );
+	VRTest_Report( ( "scandir + stat, all" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithIterator( "*", k_EIteratorWork_Names ) == unEntries );
+	VRTest_Report( ( "CDirIterator names, all" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithIterator( "*", k_EIteratorWork_IsDir ) == unEntries );
+	VRTest_Report( ( "CDirIterator is-dir, all" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithIterator( "*", k_EIteratorWork_Length ) == unEntries );
+	VRTest_Report( ( "CDirIterator lengths, all" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithScandir( "*.json" ) == unJsonEntries );
+	VRTest_Report( ( "scandir + stat, *.json" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ListWithIterator( "*.json", k_EIteratorWork_Length ) == unJsonEntries );
+	VRTest_Report( ( "CDirIterator lengths, *.json" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	Path_DeleteDirectory( k_sBenchDir, true );
+
+	return VRTest_Result( "diriteratorbench" );
+}
@@ -0,0 +1,172 @@
+//========= Copyright Valve Corporation ============//
+// Tests BWalkDirectoryTree and the Path_DeleteDirectory built on it: every entry is visited once at
+// the right depth, symlinks are never followed, and visitors can unlink what they are given.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const std::string k_sTestDir = std::string( STUB_VRPATH_FILE ) + ".dirtree";
+static const std::string k_sOutsideDir = std::string( STUB_VRPATH_FILE ) + ".dirtree_outside";
+
+static void WriteFile( const std::string & sPath )
+{
+	VRTEST_CHECK( Path_WriteStringToTextFile( sPath, "contents" ) );
+}
+
+static bool BExists( const std::string & sPath )
+{
+	struct stat statBuf;
+	return lstat( sPath.c_str(), &statBuf ) == 0;
+}
+
+// a/b/c three levels deep with two files at each level, plus a link to a directory outside the tree
+static void CreateTree()
+{
+	Path_DeleteDirectory( k_sTestDir, true );
+	Path_DeleteDirectory( k_sOutsideDir, true );
+	VRTEST_CHECK( BCreateDirectoryRecursive( Path_Join( k_sTestDir, "a/b/c", '/' ).c_str() ) );
+	VRTEST_CHECK( BCreateDirectoryRecursive( k_sOutsideDir.c_str() ) );
+	WriteFile( Path_Join( k_sOutsideDir, "keep.txt", '/' ) );
+
+	for ( const char *pchDir : { "", "a", "a/b", "a/b/c" } )
+	{
+		std::string sDir = *pchDir ? Path_Join( k_sTestDir, pchDir, '/' ) : k_sTestDir;
+		WriteFile( Path_Join( sDir, "one.txt", '/' ) );
+		WriteFile( Path_Join( sDir, "two.json", '/' ) );
+	}
+	VRTEST_CHECK( symlink( k_sOutsideDir.c_str(), Path_Join( k_sTestDir, "a/outside", '/' ).c_str() ) == 0 );
+}
+
+// relative path of each entry visited, and the depth it was visited at
+static std::map< std::string, uint32_t > Walk( const char *pchPattern, uint32_t unMaxDepth, uint32_t unThreadCount )
+{
+	std::mutex mutex;
+	std::map< std::string, uint32_t > mapVisited;
+	VRTEST_CHECK( BWalkDirectoryTree( k_sTestDir.c_str(), pchPattern, unMaxDepth, unThreadCount,
+		[&]( const DirectoryTreeEntry_t & entry )
+		{
+			std::string sPath = *entry.pchDirectoryPath ? Path_Join( entry.pchDirectoryPath, entry.pchName, '/' ) : entry.pchName;
+			struct stat statBuf;
+			VRTEST_CHECK( fstatat( entry.nDirectoryFd, entry.pchName, &statBuf, AT_SYMLINK_NOFOLLOW ) == 0 );
+			VRTEST_CHECK( entry.bIsDirectory == S_ISDIR( statBuf.st_mode ) );
+
+			std::lock_guard< std::mutex > lock( mutex );
+			VRTEST_CHECK( mapVisited.insert( std::make_pair( sPath, entry.unDepth ) ).second );
+			return k_EDirectoryTreeWalk_Continue;
+		} ) );
+	return mapVisited;
+}
+
+static void TestWalk()
+{
+	CreateTree();
+
+	for ( uint32_t unThreads : { 1u, 4u, 0u } )
+	{
+		std::map< std::string, uint32_t > mapAll = Walk( nullptr, k_unDirectoryTreeUnlimitedDepth, unThreads );
+		VRTEST_CHECK( mapAll.size() == 12 );
+		VRTEST_CHECK( mapAll[ "one.txt" ] == 0 );
+		VRTEST_CHECK( mapAll[ "a/outside" ] == 1 );
+		VRTEST_CHECK( mapAll[ "a/b/c" ] == 2 );
+		VRTEST_CHECK( mapAll[ "a/b/c/two.json" ] == 3 );
+		VRTEST_CHECK( mapAll.count( "a/outside/keep.txt" ) == 0 );
+
+		// directories are descended into whether or not they match
+		std::map< std::string, uint32_t > mapJson = Walk( "*.JSON", k_unDirectoryTreeUnlimitedDepth, unThreads );
+		VRTEST_CHECK( mapJson.size() == 4 && mapJson.count( "a/b/c/two.json" ) == 1 );
+
+		std::map< std::string, uint32_t > mapShallow = Walk( nullptr, 1, unThreads );
+		VRTEST_CHECK( mapShallow.size() == 7 && mapShallow.count( "a/b/one.txt" ) == 0 && mapShallow.count( "a/b" ) == 1 );
+	}
+
+	// a root that is a symlink is not followed either
+	std::string sLink = k_sTestDir + "_link";
+	unlink( sLink.c_str() );
+	VRTEST_CHECK( symlink( k_sTestDir.c_str(), sLink.c_str() ) == 0 );
+	bool bVisited = false;
+	VRTEST_CHECK( !BWalkDirectoryTree( sLink.c_str(), nullptr, k_unDirectoryTreeUnlimitedDepth, 0,
+		[&]( const DirectoryTreeEntry_t & ) { bVisited = true; return k_EDirectoryTreeWalk_Continue; } ) );
+	VRTEST_CHECK( !bVisited );
+	VRTEST_CHECK( !Path_DeleteDirectory( sLink, true ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "one.txt", '/' ) ) );
+	unlink( sLink.c_str() );
+
+	VRTEST_CHECK( !BWalkDirectoryTree( ( k_sTestDir + ".missing" ).c_str(), nullptr, 0, 0,
+		[]( const DirectoryTreeEntry_t & ) { return k_EDirectoryTreeWalk_Continue; } ) );
+}
+
+// Enough long names that reading the directory takes many getdents64 calls. Every entry is
+// unlinked as it is visited, which must not make the walk skip any of the rest.
+static void TestUnlinkWhileWalking()
+{
+	Path_DeleteDirectory( k_sTestDir, true );
+	VRTEST_CHECK( BCreateDirectoryRecursive( k_sTestDir.c_str() ) );
+	const uint32_t k_unFiles = 5000;
+	for ( uint32_t i = 0; i < k_unFiles; ++i )
+	{
+		WriteFile( Path_Join( k_sTestDir, "file_with_a_reasonably_long_name_so_the_entries_take_up_room_" + std::to_string( i ), '/' ) );
+	}
+
+	std::atomic< uint32_t > unVisited( 0 );
+	VRTEST_CHECK( BWalkDirectoryTree( k_sTestDir.c_str(), nullptr, 0, 1,
+		[&]( const DirectoryTreeEntry_t & entry )
+		{
+			++unVisited;
+			VRTEST_CHECK( unlinkat( entry.nDirectoryFd, entry.pchName, 0 ) == 0 );
+			return k_EDirectoryTreeWalk_Continue;
+		} ) );
+	VRTEST_CHECK( unVisited == k_unFiles );
+	VRTEST_CHECK( rmdir( k_sTestDir.c_str() ) == 0 );
+}
+
+static void TestDeleteDirectory()
+{
+	// subdirectories are only removed when asked to
+	CreateTree();
+	VRTEST_CHECK( !Path_DeleteDirectory( k_sTestDir, false ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "a/b/c", '/' ) ) );
+
+	// and a call that fails leaves the files alone too
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "one.txt", '/' ) ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "two.json", '/' ) ) );
+	VRTEST_CHECK( !Path_DeleteDirectory( Path_Join( k_sTestDir, "a", '/' ), false ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "a/one.txt", '/' ) ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sTestDir, "a/two.json", '/' ) ) );
+
+	// the link is removed, but not what it points to
+	VRTEST_CHECK( Path_DeleteDirectory( k_sTestDir, true ) );
+	VRTEST_CHECK( !BExists( k_sTestDir ) );
+	VRTEST_CHECK( BExists( Path_Join( k_sOutsideDir, "keep.txt", '/' ) ) );
+
+	// wide and deep at once
+	for ( uint32_t unDir = 0; unDir < 20; ++unDir )
+	{
+		std::string sDir = Path_Join( k_sTestDir, "dir" + std::to_string( unDir ) + "/nested", '/' );
+		VRTEST_CHECK( BCreateDirectoryRecursive( sDir.c_str() ) );
+		for ( uint32_t unFile = 0; unFile < 300; ++unFile )
+		{
+			WriteFile( Path_Join( sDir, "a_long_enough_file_name_" + std::to_string( unFile ), '/' ) );
+		}
+	}
+	VRTEST_CHECK( Path_DeleteDirectory( k_sTestDir, true ) );
+	VRTEST_CHECK( !BExists( k_sTestDir ) );
+
+	VRTEST_CHECK( !Path_DeleteDirectory( k_sTestDir, true ) );
+	VRTEST_CHECK( Path_DeleteDirectory( k_sOutsideDir, false ) );
+}
+
+int main()
+{
+	TestWalk();
+	TestUnlinkWhileWalking();
+	TestDeleteDirectory();
+
+	return VRTest_Result( "dirtree_test" );
+}
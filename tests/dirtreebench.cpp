@@ -0,0 +1,140 @@
+//========= Copyright Valve Corporation ============//
+// Times BWalkDirectoryTree over a tree of resource-like files on 1 thread up to one per CPU (and at
+// least 4), against a serial CDirIterator-style recursion with full paths. The deletion of the tree
+// is timed with the same thread counts.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+static const std::string k_sBenchDir = std::string( STUB_VRPATH_FILE ) + ".dirtreebench";
+
+// unDirectories directories two levels deep, each holding unFilesPerDirectory files
+static uint32_t CreateTree( uint32_t unDirectories, uint32_t unFilesPerDirectory )
+{
+	Path_DeleteDirectory( k_sBenchDir, true );
+	uint32_t unEntries = 0;
+	for ( uint32_t unDir = 0; unDir < unDirectories; ++unDir )
+	{
+		std::string sDir = Path_Join( k_sBenchDir, "group" + std::to_string( unDir % 8 ) + "/resources" + std::to_string( unDir ), '/' );
+		VRTEST_CHECK( BCreateDirectoryRecursive( sDir.c_str() ) );
+		for ( uint32_t unFile = 0; unFile < unFilesPerDirectory; ++unFile )
+		{
+			VRTEST_CHECK( Path_WriteStringToTextFile( Path_Join( sDir, "texture" + std::to_string( unFile ) + ".png", '/' ), "" ) );
+		}
+		unEntries += unFilesPerDirectory + 1;
+	}
+	return unEntries + std::min( unDirectories, 8u );
+}
+
+// How a tree was walked before: recurse on full paths, one directory at a time
+static uint32_t WalkSerially( const std::string & sPath )
+{
+	uint32_t unEntries = 0;
+	DIR *pDir = opendir( sPath.c_str() );
+	if ( !pDir )
+		return 0;
+	while ( struct dirent *pEnt = readdir( pDir ) )
+	{
+		if ( pEnt->d_name[ 0 ] == '.' )
+			continue;
+		++unEntries;
+		std::string sChild = Path_Join( sPath, pEnt->d_name, '/' );
+		struct stat statBuf;
+		if ( lstat( sChild.c_str(), &statBuf ) == 0 && S_ISDIR( statBuf.st_mode ) )
+			unEntries += WalkSerially( sChild );
+	}
+	closedir( pDir );
+	return unEntries;
+}
+
+static uint32_t WalkInParallel( uint32_t unThreadCount )
+{
+	std::atomic< uint32_t > unEntries( 0 );
+	VRTEST_CHECK( BWalkDirectoryTree( k_sBenchDir.c_str(), nullptr, k_unDirectoryTreeUnlimitedDepth, unThreadCount,
+		[&]( const DirectoryTreeEntry_t & ) { ++unEntries; return k_EDirectoryTreeWalk_Continue; } ) );
+	return unEntries;
+}
+
+// What Path_DeleteDirectory does, with the thread count left to the caller
+static void DeleteInParallel( uint32_t unThreadCount )
+{
+	std::mutex mutex;
+	std::vector< std::pair< uint32_t, std::string > > vecDirectories;
+	VRTEST_CHECK( BWalkDirectoryTree( k_sBenchDir.c_str(), nullptr, k_unDirectoryTreeUnlimitedDepth, unThreadCount,
+		[&]( const DirectoryTreeEntry_t & entry )
+		{
+			if ( entry.bIsDirectory )
+			{
+				std::lock_guard< std::mutex > lock( mutex );
+				vecDirectories.push_back( std::make_pair( entry.unDepth, Path_Join( entry.pchDirectoryPath, entry.pchName, '/' ) ) );
+			}
+			else
+			{
+				VRTEST_CHECK( unlinkat( entry.nDirectoryFd, entry.pchName, 0 ) == 0 );
+			}
+			return k_EDirectoryTreeWalk_Continue;
+		} ) );
+
+	std::sort( vecDirectories.begin(), vecDirectories.end(),
+		[]( const std::pair< uint32_t, std::string > & lhs, const std::pair< uint32_t, std::string > & rhs ) { return lhs.first > rhs.first; } );
+	for ( size_t i = 0; i < vecDirectories.size(); ++i )
+	{
+		VRTEST_CHECK( rmdir( Path_Join( k_sBenchDir, vecDirectories[ i ].second, '/' ).c_str() ) == 0 );
+	}
+	VRTEST_CHECK( rmdir( k_sBenchDir.c_str() ) == 0 );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint32_t unDirectories = (uint32_t)VRTest_Scaled( 200, flScale );
+	const uint32_t unFilesPerDirectory = (uint32_t)VRTest_Scaled( 250, flScale );
+	const uint64_t unIterations = VRTest_Scaled( 10, flScale );
+
+	std::vector< uint32_t > vecThreadCounts;
+	const uint32_t unMaxThreads = std::max( 4u, std::thread::hardware_concurrency() );
+	for ( uint32_t unThreads = 1; unThreads < unMaxThreads; unThreads *= 2 )
+		vecThreadCounts.push_back( unThreads );
+	vecThreadCounts.push_back( unMaxThreads );
+
+	const uint32_t unEntries = CreateTree( unDirectories, unFilesPerDirectory );
+	std::string sSuffix = ", " + std::to_string( unEntries ) + " entries";
+	printf( "%u CPUs\n", std::thread::hardware_concurrency() );
+
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( WalkSerially( k_sBenchDir ) == unEntries );
+	VRTest_Report( ( "serial readdir + lstat" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	for ( uint32_t unThreads : vecThreadCounts )
+	{
+		flStart = VRTest_Seconds();
+		for ( uint64_t i = 0; i < unIterations; ++i )
+			VRTEST_CHECK( WalkInParallel( unThreads ) == unEntries );
+		VRTest_Report( ( "walk, " + std::to_string( unThreads ) + " threads" + sSuffix ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	}
+
+	// only the deletion is timed, not building the tree back up
+	for ( uint32_t unThreads : vecThreadCounts )
+	{
+		double flSeconds = 0;
+		for ( uint64_t i = 0; i < unIterations; ++i )
+		{
+			CreateTree( unDirectories, unFilesPerDirectory );
+			flStart = VRTest_Seconds();
+			DeleteInParallel( unThreads );
+			flSeconds += VRTest_Seconds() - flStart;
+		}
+		VRTest_Report( ( "delete, " + std::to_string( unThreads ) + " threads" + sSuffix ).c_str(), unIterations, flSeconds );
+	}
+
+	return VRTest_Result( "dirtreebench" );
+}
@@ -0,0 +1,167 @@
+//========= Copyright Valve Corporation ============//
+// Tests the GetEnvironmentVariableCached snapshot, and that the path registry overrides it reads take
+// effect when they are changed after the registry was first used.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <vrcore/vrpathregistry_public.h>
+
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// changes the environment without going through SetEnvironmentVariable, the way an application would
+static void SetEnvDirectly( const char *pchVarName, const char *pchValue )
+{
+#if defined( _WIN32 )
+	_putenv_s( pchVarName, pchValue ? pchValue : "" );
+#else
+	if ( pchValue )
+		setenv( pchVarName, pchValue, 1 );
+	else
+		unsetenv( pchVarName );
+#endif
+}
+
+static void TestCachedLookups()
+{
+	SetEnvironmentVariable( "VRTEST_VAR", nullptr );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == nullptr );
+
+	SetEnvironmentVariable( "VRTEST_VAR", "first" );
+	const char *pchFirst = GetEnvironmentVariableCached( "VRTEST_VAR" );
+	VRTEST_CHECK( pchFirst && strcmp( pchFirst, "first" ) == 0 );
+
+	// an unchanged value comes back without being copied again, and other lookups don't move it
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_OTHER_VAR" ) == nullptr );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == pchFirst );
+	SetEnvironmentVariable( "VRTEST_OTHER_VAR", "other" );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == pchFirst );
+
+	// a changed value gets a new copy, and the old one stays valid
+	SetEnvironmentVariable( "VRTEST_VAR", "second" );
+	const char *pchSecond = GetEnvironmentVariableCached( "VRTEST_VAR" );
+	VRTEST_CHECK( pchSecond && strcmp( pchSecond, "second" ) == 0 );
+	VRTEST_CHECK( strcmp( pchFirst, "first" ) == 0 );
+
+	// changes made behind the snapshot's back are only seen once it is invalidated
+	SetEnvDirectly( "VRTEST_VAR", "third" );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == pchSecond );
+	InvalidateEnvironmentVariableCache();
+	const char *pchThird = GetEnvironmentVariableCached( "VRTEST_VAR" );
+	VRTEST_CHECK( pchThird && strcmp( pchThird, "third" ) == 0 );
+
+	// the snapshot is shared by every thread
+	std::thread thread( [pchThird]()
+	{
+		VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == pchThird );
+	} );
+	thread.join();
+
+	SetEnvironmentVariable( "VRTEST_VAR", nullptr );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_VAR" ) == nullptr );
+	SetEnvironmentVariable( "VRTEST_OTHER_VAR", nullptr );
+}
+
+// More variables than the lock-free table holds still resolve through the locked map
+static void TestManyVariables()
+{
+	const uint32_t k_unCount = 1000;
+	for ( uint32_t i = 0; i < k_unCount; ++i )
+	{
+		std::string sName = "VRTEST_MANY_" + std::to_string( i );
+		SetEnvironmentVariable( sName.c_str(), std::to_string( i ).c_str() );
+	}
+	for ( uint32_t i = 0; i < k_unCount; ++i )
+	{
+		std::string sName = "VRTEST_MANY_" + std::to_string( i );
+		const char *pchValue = GetEnvironmentVariableCached( sName.c_str() );
+		VRTEST_CHECK( pchValue && std::to_string( i ) == pchValue );
+		VRTEST_CHECK( GetEnvironmentVariableCached( sName.c_str() ) == pchValue );
+		SetEnvironmentVariable( sName.c_str(), nullptr );
+	}
+}
+
+// Readers on several threads while another thread keeps changing the variable only ever see
+// values that were set
+static void TestConcurrentReadsAndSets()
+{
+	std::atomic< bool > bStop( false );
+	std::vector< std::thread > vecReaders;
+	for ( int i = 0; i < 4; ++i )
+	{
+		vecReaders.emplace_back( [&bStop]()
+		{
+			while ( !bStop )
+			{
+				const char *pchValue = GetEnvironmentVariableCached( "VRTEST_RACE" );
+				VRTEST_CHECK( !pchValue || strcmp( pchValue, "a" ) == 0 || strcmp( pchValue, "b" ) == 0 );
+			}
+		} );
+	}
+	for ( int i = 0; i < 10000; ++i )
+	{
+		SetEnvironmentVariable( "VRTEST_RACE", ( i & 1 ) ? "a" : "b" );
+	}
+	bStop = true;
+	for ( std::thread & thread : vecReaders )
+		thread.join();
+
+	SetEnvironmentVariable( "VRTEST_RACE", nullptr );
+	VRTEST_CHECK( GetEnvironmentVariableCached( "VRTEST_RACE" ) == nullptr );
+}
+
+static void TestPathOverridesAfterFirstUse()
+{
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, nullptr );
+	SetEnvironmentVariable( k_pchConfigOverrideVar, nullptr );
+	SetEnvironmentVariable( k_pchLogOverrideVar, nullptr );
+
+	std::string sRuntimePath, sConfigPath, sLogPath;
+	VRTEST_CHECK( vr::VR_IsRuntimeInstalled() );
+	VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, nullptr, nullptr ) );
+	VRTEST_CHECK( !sRuntimePath.empty() && !sConfigPath.empty() && !sLogPath.empty() );
+
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, "/vrtest/runtime" );
+	SetEnvironmentVariable( k_pchConfigOverrideVar, "/vrtest/config" );
+	SetEnvironmentVariable( k_pchLogOverrideVar, "/vrtest/log" );
+	std::string sNewRuntimePath, sNewConfigPath, sNewLogPath;
+	VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sNewRuntimePath, &sNewConfigPath, &sNewLogPath, nullptr, nullptr ) );
+	VRTEST_CHECK( sNewRuntimePath == "/vrtest/runtime" );
+	VRTEST_CHECK( sNewConfigPath == "/vrtest/config" );
+	VRTEST_CHECK( sNewLogPath == "/vrtest/log" );
+
+	// set directly, the overrides only take effect once the snapshot is invalidated
+	SetEnvDirectly( k_pchRuntimeOverrideVar, nullptr );
+	SetEnvDirectly( k_pchConfigOverrideVar, nullptr );
+	SetEnvDirectly( k_pchLogOverrideVar, nullptr );
+	VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sNewRuntimePath, &sNewConfigPath, &sNewLogPath, nullptr, nullptr ) );
+	VRTEST_CHECK( sNewRuntimePath == "/vrtest/runtime" );
+	InvalidateEnvironmentVariableCache();
+	VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sNewRuntimePath, &sNewConfigPath, &sNewLogPath, nullptr, nullptr ) );
+	VRTEST_CHECK( sNewRuntimePath == sRuntimePath );
+	VRTEST_CHECK( sNewConfigPath == sConfigPath );
+	VRTEST_CHECK( sNewLogPath == sLogPath );
+
+	// pointing the registry somewhere else is seen too
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", STUB_VRPATH_FILE ".missing" );
+	VRTEST_CHECK( CVRPathRegistry_Public::GetVRPathRegistryFilename() == STUB_VRPATH_FILE ".missing" );
+	VRTEST_CHECK( !CVRPathRegistry_Public::GetPaths( &sNewRuntimePath, nullptr, nullptr, nullptr, nullptr ) );
+	VRTEST_CHECK( !vr::VR_IsRuntimeInstalled() );
+
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", STUB_VRPATH_FILE );
+	VRTEST_CHECK( vr::VR_IsRuntimeInstalled() );
+}
+
+int main()
+{
+	VRTest_UseStubRuntime();
+
+	TestCachedLookups();
+	TestManyVariables();
+	TestConcurrentReadsAndSets();
+	TestPathOverridesAfterFirstUse();
+
+	return VRTest_Result( "envvar_test" );
+}
@@ -0,0 +1,108 @@
+//========= Copyright Valve Corporation ============//
+// Tests CVRPathRegistry_Public::AddExternalDriver and RemoveExternalDriver, in particular that
+// they leave the rest of the registry file alone.
+#include "vrtest.h"
+
+#include <vrcore/vrpathregistry_public.h>
+#include <vrcore/pathtools_public.h>
+
+static const std::string k_sRegistryFile = std::string( STUB_VRPATH_FILE ) + ".externaldrivers";
+
+static std::string ReadRegistry()
+{
+	std::vector< uint8_t > vecBytes = Path_ReadBinaryFile( k_sRegistryFile );
+	return std::string( vecBytes.begin(), vecBytes.end() );
+}
+
+static void WriteRegistry( const std::string & sContents )
+{
+	VRTEST_CHECK( Path_WriteBinaryFile( k_sRegistryFile, ( unsigned char * )&sContents[0], ( unsigned )sContents.size() ) );
+}
+
+static bool BHasExternalDriver( const std::string & sDriverPath )
+{
+	CVRPathRegistry_Public pathReg;
+	return pathReg.BLoadFromFile() && pathReg.HasExternalDriver( sDriverPath );
+}
+
+static void TestBytesPreserved()
+{
+	// a BOM, CRLF line endings, history in the other lists, and odd spacing
+	const std::string sOriginal =
+		"\xEF\xBB\xBF{\r\n"
+		"\t\"config\" : [ \"/vrtest/config\",   \"/vrtest/oldconfig\" ],\r\n"
+		"\t\"external_drivers\" : [\r\n"
+		"\t\t\"/vrtest/drivers/a\"\r\n"
+		"\t],\r\n"
+		"\t\"jsonid\" : \"vrpathreg\",\r\n"
+		"\t\"runtime\" : [\r\n\t\t\"/vrtest/runtime\",\r\n\t\t\"/vrtest/oldruntime\"\r\n\t],\r\n"
+		"\t\"version\" : 1\r\n"
+		"}\r\n";
+	WriteRegistry( sOriginal );
+
+	VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/drivers/b" ) );
+	std::string sAdded = ReadRegistry();
+	VRTEST_CHECK( BHasExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( BHasExternalDriver( "/vrtest/drivers/b" ) );
+	VRTEST_CHECK( sAdded.find( "\t\t\"/vrtest/drivers/a\",\r\n\t\t\"/vrtest/drivers/b\"\r\n\t]" ) != std::string::npos );
+	VRTEST_CHECK( sAdded.compare( 0, 3, "\xEF\xBB\xBF" ) == 0 );
+	VRTEST_CHECK( sAdded.find( "\"config\" : [ \"/vrtest/config\",   \"/vrtest/oldconfig\" ]" ) != std::string::npos );
+	for ( size_t unPos = sAdded.find( '\n' ); unPos != std::string::npos; unPos = sAdded.find( '\n', unPos + 1 ) )
+	{
+		VRTEST_CHECK( unPos > 0 && sAdded[ unPos - 1 ] == '\r' );
+	}
+
+	// adding what is there already doesn't touch the file
+	VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/drivers/b" ) );
+	VRTEST_CHECK( ReadRegistry() == sAdded );
+
+	// and removing it again gets back exactly what we started with
+	VRTEST_CHECK( CVRPathRegistry_Public::RemoveExternalDriver( "/vrtest/drivers/b" ) );
+	VRTEST_CHECK( !BHasExternalDriver( "/vrtest/drivers/b" ) );
+	VRTEST_CHECK( ReadRegistry() == sOriginal );
+}
+
+static void TestNoDriverList()
+{
+	const std::string sOriginal = "{\n\t\"jsonid\" : \"vrpathreg\",\n\t\"version\" : 1\n}\n";
+	WriteRegistry( sOriginal );
+
+	VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( BHasExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( ReadRegistry() ==
+		"{\n\t\"jsonid\" : \"vrpathreg\",\n\t\"version\" : 1,\n"
+		"\t\"external_drivers\" : [\n\t\t\"/vrtest/drivers/a\"\n\t]\n}\n" );
+
+	VRTEST_CHECK( CVRPathRegistry_Public::RemoveExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( CVRPathRegistry_Public::RemoveExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( !BHasExternalDriver( "/vrtest/drivers/a" ) );
+
+	WriteRegistry( "{}" );
+	VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/drivers/a" ) );
+	VRTEST_CHECK( ReadRegistry() == "{\n\t\"external_drivers\" : [\n\t\t\"/vrtest/drivers/a\"\n\t]\n}" );
+}
+
+static void TestDuplicatesRemoved()
+{
+	WriteRegistry( "{ \"external_drivers\" : [ \"/vrtest/a\", \"/vrtest/b\", \"/vrtest/a\" ], \"version\" : 1 }" );
+
+	std::vector< std::string > vecDrivers;
+	CVRPathRegistry_Public::GetPaths( nullptr, nullptr, nullptr, nullptr, nullptr, &vecDrivers );
+	VRTEST_CHECK( vecDrivers.size() == 2 && vecDrivers[0] == "/vrtest/a" && vecDrivers[1] == "/vrtest/b" );
+
+	// any edit writes the list back without the duplicates
+	VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/b" ) );
+	VRTEST_CHECK( ReadRegistry() == "{ \"external_drivers\" : [\n\t\t\"/vrtest/a\",\n\t\t\"/vrtest/b\"\n\t], \"version\" : 1 }" );
+}
+
+int main()
+{
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", k_sRegistryFile.c_str() );
+
+	TestBytesPreserved();
+	TestNoDriverList();
+	TestDuplicatesRemoved();
+	Path_UnlinkFile( k_sRegistryFile );
+
+	return VRTest_Result( "externaldrivers_test" );
+}
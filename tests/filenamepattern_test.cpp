@@ -0,0 +1,170 @@
+//========= Copyright Valve Corporation ============//
+// Tests CFilenamePattern against the matchers it replaced: fnmatch with FNM_CASEFOLD, which the tree
+// walker used, and CDirIterator's FileSelect. FileSelect never backtracked, so it only has to agree
+// where it found a match.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+
+#include <ctype.h>
+#include <fnmatch.h>
+#include <string.h>
+#include <random>
+
+// The matchers as they were before CFilenamePattern
+namespace reference
+{
+
+bool BMatchDirectoryTreePattern( const char *pchPattern, const char *pchName )
+{
+	return fnmatch( pchPattern, pchName, FNM_CASEFOLD ) == 0;
+}
+
+int FileSelect( const char *name, const char *mask )
+{
+	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
+		return 1;
+
+	while ( *mask && *name )
+	{
+		if ( *mask == '*' )
+		{
+			mask++;		  // move to the next char in the mask
+			if ( !*mask ) // if this is the end of the mask its a match
+			{
+				return 1;
+			}
+			while ( *name && toupper( *name ) != toupper( *mask ) )
+			{ // while the two don't meet up again
+				name++;
+			}
+			if ( !*name )
+			{ // end of the name
+				break;
+			}
+		}
+		else if ( *mask != '?' )
+		{
+			if ( toupper( *mask ) != toupper( *name ) )
+			{ // mismatched!
+				return 0;
+			}
+			else
+			{
+				mask++;
+				name++;
+				if ( !*mask && !*name )
+				{ // if its at the end of the buffer
+					return 1;
+				}
+			}
+		}
+		else /* mask is "?", we don't care*/
+		{
+			mask++;
+			name++;
+		}
+	}
+
+	return ( !*mask && !*name ); // both of the strings are at the end
+}
+
+} // namespace reference
+
+// Small alphabets, so that random names and patterns overlap often enough to match
+static std::string RandomString( std::mt19937 &rng, const char *pchAlphabet, size_t unMaxLength )
+{
+	std::string s;
+	size_t unLength = rng() % ( unMaxLength + 1 );
+	size_t unAlphabet = strlen( pchAlphabet );
+	for ( size_t i = 0; i < unLength; ++i )
+		s.push_back( pchAlphabet[ rng() % unAlphabet ] );
+	return s;
+}
+
+static void CheckPattern( const char *pchPattern, const char *pchName )
+{
+	CFilenamePattern pattern( pchPattern );
+	bool bMatches = pattern.BMatches( pchName );
+	VRTEST_CHECK( bMatches == pattern.BMatches( pchName, strlen( pchName ) ) );
+
+	// "*.*" is the one place the Windows meaning wins over the glob one
+	bool bExpected = !strcmp( pchPattern, "*.*" ) || reference::BMatchDirectoryTreePattern( pchPattern, pchName );
+	if ( bMatches != bExpected )
+	{
+		fprintf( stderr, "pattern \"%s\" name \"%s\": %d, fnmatch %d\n", pchPattern, pchName, bMatches, bExpected );
+		VRTEST_CHECK( false );
+	}
+
+	if ( reference::FileSelect( pchName, pchPattern ) && !bMatches )
+	{
+		fprintf( stderr, "pattern \"%s\" name \"%s\": FileSelect matched\n", pchPattern, pchName );
+		VRTEST_CHECK( false );
+	}
+}
+
+static void TestAgainstReference()
+{
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < 300000; ++nIteration )
+	{
+		std::string sPattern = RandomString( rng, "aAb.*?", 8 );
+		std::string sName = RandomString( rng, "aAbB._", 10 );
+		CheckPattern( sPattern.c_str(), sName.c_str() );
+	}
+
+	// the fast paths with realistic names
+	static const char *k_rgpchPatterns[] = { "*.json", "*.JSON", "driver_*", "DRIVER_*", "driver.vrdrivermanifest", "*", "*.*", "**",
+		"*.", ".*", "", "*_*.dll", "driver_?????.so", "?*", "*?", "a*b*c", "*a*a*" };
+	static const char *k_rgpchNames[] = { "driver.vrdrivermanifest", "Driver.VRDriverManifest", "driver_lighthouse.so", "driver_null.so",
+		"resources.json", "SETTINGS.JSON", "json", ".json", ".", "..", "", "x", "abc", "aXbYc", "cba", "aa", "a", "noext", "trailing." };
+	for ( const char *pchPattern : k_rgpchPatterns )
+	{
+		for ( const char *pchName : k_rgpchNames )
+		{
+			CheckPattern( pchPattern, pchName );
+		}
+	}
+}
+
+// Where FileSelect gave the wrong answer because it never retried a *
+static void TestBacktracking()
+{
+	VRTEST_CHECK( !reference::FileSelect( "a.b.json", "*.json" ) );
+	VRTEST_CHECK( CFilenamePattern( "*.json" ).BMatches( "a.b.json" ) );
+
+	VRTEST_CHECK( !reference::FileSelect( "abab", "*ab" ) );
+	VRTEST_CHECK( CFilenamePattern( "*ab" ).BMatches( "abab" ) );
+
+	VRTEST_CHECK( CFilenamePattern( "a*b?d*" ).BMatches( "abbcbxdd" ) );
+	VRTEST_CHECK( !CFilenamePattern( "a*b?d*e" ).BMatches( "abbcbxdd" ) );
+}
+
+static void TestDefaultAndRecompile()
+{
+	CFilenamePattern pattern;
+	VRTEST_CHECK( pattern.BMatches( "anything" ) && pattern.BMatches( "" ) );
+
+	pattern.Compile( "*.txt" );
+	VRTEST_CHECK( pattern.BMatches( "a.TXT" ) && !pattern.BMatches( "a.json" ) );
+
+	// only "*.*" exactly as written matches names without a dot
+	pattern.Compile( "*.**" );
+	VRTEST_CHECK( pattern.BMatches( "a.b" ) && !pattern.BMatches( "noext" ) );
+
+	pattern.Compile( nullptr );
+	VRTEST_CHECK( pattern.BMatches( "a.json" ) );
+
+	// the length overload doesn't need a terminator
+	pattern.Compile( "ab?" );
+	VRTEST_CHECK( pattern.BMatches( "abcdef", 3 ) && !pattern.BMatches( "abcdef", 4 ) );
+}
+
+int main()
+{
+	TestAgainstReference();
+	TestBacktracking();
+	TestDefaultAndRecompile();
+
+	return VRTest_Result( "filenamepattern_test" );
+}
@@ -0,0 +1,103 @@
+//========= Copyright Valve Corporation ============//
+// Times CFilenamePattern over millions of file names for each kind of pattern it compiles to, against
+// CDirIterator's old FileSelect and fnmatch, which both interpret the pattern again for every name.
+#include "vrtest.h"
+
+#include <vrcore/dirtools_public.h>
+
+#include <ctype.h>
+#include <fnmatch.h>
+#include <string.h>
+
+// CDirIterator's matcher before CFilenamePattern
+static int FileSelect( const char *name, const char *mask )
+{
+	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
+		return 1;
+
+	while ( *mask && *name )
+	{
+		if ( *mask == '*' )
+		{
+			mask++;
+			if ( !*mask )
+				return 1;
+			while ( *name && toupper( *name ) != toupper( *mask ) )
+				name++;
+			if ( !*name )
+				break;
+		}
+		else if ( *mask != '?' )
+		{
+			if ( toupper( *mask ) != toupper( *name ) )
+				return 0;
+			mask++;
+			name++;
+			if ( !*mask && !*name )
+				return 1;
+		}
+		else
+		{
+			mask++;
+			name++;
+		}
+	}
+
+	return ( !*mask && !*name );
+}
+
+// Names like a resource tree has, in one buffer so that the benchmark measures matching rather than
+// cache misses chasing std::strings
+static void BuildNames( uint32_t unNames, std::string *psNames, std::vector< size_t > *pvecOffsets )
+{
+	static const char *k_rgpchExtensions[] = { ".png", ".json", ".dds", ".so", ".vrdrivermanifest" };
+	for ( uint32_t i = 0; i < unNames; ++i )
+	{
+		pvecOffsets->push_back( psNames->length() );
+		*psNames += ( i % 7 == 0 ) ? "driver_" : "resource_";
+		*psNames += std::to_string( i * 2654435761u % 1000000 );
+		*psNames += k_rgpchExtensions[ i % 5 ];
+		psNames->push_back( 0 );
+	}
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint32_t unNames = (uint32_t)VRTest_Scaled( 2000000, flScale );
+
+	std::string sNames;
+	std::vector< size_t > vecOffsets;
+	BuildNames( unNames, &sNames, &vecOffsets );
+
+	static const char *k_rgpchPatterns[] = { "*.json", "driver_*", "driver.vrdrivermanifest", "*_1?3*.PNG" };
+	for ( const char *pchPattern : k_rgpchPatterns )
+	{
+		std::string sPattern = pchPattern;
+		uint32_t unMatches = 0;
+
+		double flStart = VRTest_Seconds();
+		CFilenamePattern pattern( pchPattern );
+		for ( size_t i = 0; i < vecOffsets.size(); ++i )
+			unMatches += pattern.BMatches( sNames.c_str() + vecOffsets[ i ] ) ? 1 : 0;
+		VRTest_Report( ( "CFilenamePattern " + sPattern ).c_str(), unNames, VRTest_Seconds() - flStart );
+
+		uint32_t unExpected = unMatches;
+		unMatches = 0;
+		flStart = VRTest_Seconds();
+		for ( size_t i = 0; i < vecOffsets.size(); ++i )
+			unMatches += fnmatch( pchPattern, sNames.c_str() + vecOffsets[ i ], FNM_CASEFOLD ) == 0 ? 1 : 0;
+		VRTest_Report( ( "fnmatch " + sPattern ).c_str(), unNames, VRTest_Seconds() - flStart );
+		VRTEST_CHECK( unMatches == unExpected );
+
+		// FileSelect can miss names that need a * retried, but never finds extra ones
+		unMatches = 0;
+		flStart = VRTest_Seconds();
+		for ( size_t i = 0; i < vecOffsets.size(); ++i )
+			unMatches += FileSelect( sNames.c_str() + vecOffsets[ i ], pchPattern );
+		VRTest_Report( ( "FileSelect " + sPattern ).c_str(), unNames, VRTest_Seconds() - flStart );
+		VRTEST_CHECK( unMatches <= unExpected );
+	}
+
+	return VRTest_Result( "filenamepatternbench" );
+}
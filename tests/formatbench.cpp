@@ -0,0 +1,160 @@
+//========= Copyright Valve Corporation ============//
+// Times Format, FormatTo, FormatToBuffer and StringAppend against the Format they grew out of, on a
+// short driver log line, and times Format on its own for output of 2 KB, which still fits the stack
+// buffer, and of 8 KB, which does not. Also checks that StringAppend's floating point output reads back
+// as the value appended.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <vector>
+
+// Format as it was before FormatTo
+static std::string ReferenceFormat( const char *pchFormat, ... )
+{
+	static constexpr size_t k_ulMaxStackString = 4096;
+
+	va_list args;
+	char pchBuffer[k_ulMaxStackString];
+
+	va_start( args, pchFormat );
+	int unSize = vsnprintf( pchBuffer, sizeof( pchBuffer ), pchFormat, args );
+	va_end( args );
+
+	if ( unSize < 0 )
+		return "";
+
+	if ( (size_t)unSize < k_ulMaxStackString )
+		return pchBuffer;
+
+	std::vector< char > vecChar{};
+	vecChar.resize( unSize + 1 );
+
+	va_start( args, pchFormat );
+	unSize = vsnprintf( vecChar.data(), vecChar.size(), pchFormat, args );
+	va_end( args );
+
+	if ( unSize < 0 )
+		return "";
+
+	return vecChar.data();
+}
+
+static void BenchLogLine( uint64_t unIterations )
+{
+	const char *pchDriver = "lighthouse";
+	const std::string sSerial = "LHR-1A2B3C4D";
+	const uint32_t unDeviceIndex = 3;
+	const std::string sExpected = "Driver lighthouse: device 3 (LHR-1A2B3C4D) activated";
+	VRTEST_CHECK( Format( "Driver %s: device %u (%s) activated", pchDriver, unDeviceIndex, sSerial.c_str() ) == sExpected );
+
+	size_t unTotal = 0;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceFormat( "Driver %s: device %u (%s) activated", pchDriver, unDeviceIndex, sSerial.c_str() ).length();
+	VRTest_Report( "old Format, log line", unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += Format( "Driver %s: device %u (%s) activated", pchDriver, unDeviceIndex, sSerial.c_str() ).length();
+	VRTest_Report( "Format, log line", unIterations, VRTest_Seconds() - flStart );
+
+	// the same string each time, as a logger would reuse its line
+	std::string sLine;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		sLine.clear();
+		unTotal += FormatTo( sLine, "Driver %s: device %u (%s) activated", pchDriver, unDeviceIndex, sSerial.c_str() );
+	}
+	VRTest_Report( "FormatTo, reused string, log line", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( sLine == sExpected );
+
+	char rgchLine[ 256 ];
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		size_t unLength = 0;
+		VRTEST_CHECK( FormatToBuffer( rgchLine, sizeof( rgchLine ), &unLength, "Driver %s: device %u (%s) activated", pchDriver, unDeviceIndex, sSerial.c_str() ) );
+		unTotal += unLength;
+	}
+	VRTest_Report( "FormatToBuffer, log line", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( sExpected == rgchLine );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		sLine.clear();
+		StringAppend( sLine, "Driver ", pchDriver, ": device ", unDeviceIndex, " (", sSerial, ") activated" );
+		unTotal += sLine.length();
+	}
+	VRTest_Report( "StringAppend, reused string, log line", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( sLine == sExpected );
+
+	VRTEST_CHECK( unTotal == 5 * unIterations * sExpected.length() );
+}
+
+static void BenchLongOutput( const char *pchName, size_t unLength, uint64_t unIterations )
+{
+	const std::string sValue( unLength - 8, 'x' );
+	std::string sName = pchName;
+
+	size_t unTotal = 0;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceFormat( "value = %s\n", sValue.c_str() ).length();
+	VRTest_Report( ( "old Format, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += Format( "value = %s\n", sValue.c_str() ).length();
+	VRTest_Report( ( "Format, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	std::string sLine;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		sLine.clear();
+		unTotal += FormatTo( sLine, "value = %s\n", sValue.c_str() );
+	}
+	VRTest_Report( ( "FormatTo, reused string, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	VRTEST_CHECK( unTotal == 3 * unIterations * ( sValue.length() + 9 ) );
+}
+
+// Floating point values read back as the value appended, with no more digits than that takes
+static void TestStringAppendFloatingPoint()
+{
+	VRTEST_CHECK( StringConcat( 1234567.0 ) == "1234567" );
+	VRTEST_CHECK( StringConcat( -42.0 ) == "-42" );
+	VRTEST_CHECK( StringConcat( 0.1 ) == "0.1" );
+	VRTEST_CHECK( StringConcat( 0.1f ) == "0.1" );
+	VRTEST_CHECK( StringConcat( 1.5e300 ) == "1.5e+300" );
+	VRTEST_CHECK( StringConcat( -0.0 ) == "-0" );
+	VRTEST_CHECK( StringConcat( 16777217.0f ) == "16777216" );
+
+	for ( double flValue : { 0.1 + 0.2, 1.0 / 3.0, 123456.789, 2.0e-310, 9007199254740993.0 * 4 } )
+	{
+		VRTEST_CHECK( strtod( StringConcat( flValue ).c_str(), nullptr ) == flValue );
+	}
+	for ( float flValue : { 1.0f / 3.0f, 3.14159265f, 1.0e-40f } )
+	{
+		VRTEST_CHECK( (float)strtod( StringConcat( flValue ).c_str(), nullptr ) == flValue );
+	}
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 1000000, flScale );
+
+	TestStringAppendFloatingPoint();
+
+	BenchLogLine( unIterations );
+	BenchLongOutput( "2 KB", 2048, unIterations / 10 + 1 );
+	BenchLongOutput( "8 KB", 8192, unIterations / 10 + 1 );
+
+	return VRTest_Result( "formatbench" );
+}
@@ -0,0 +1,112 @@
+//========= Copyright Valve Corporation ============//
+// Round trips every EVRInitError in openvr.h through GetIDForVRInitError and GetVRInitErrorForID.
+// The enumerators are read from the header itself, so an error added there but not to the ID list
+// in hmderrors_public.cpp fails this test.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <vrcore/hmderrors_public.h>
+#include <vrcore/pathtools_public.h>
+
+#include <string.h>
+#include <sstream>
+
+using namespace vr;
+
+struct InitErrorEnumerator_t
+{
+	std::string sName;
+	int nValue;
+};
+
+// Reads "VRInitError_Name = value," lines from the EVRInitError enum, skipping commented out ones
+static std::vector< InitErrorEnumerator_t > ReadInitErrorEnumerators()
+{
+	std::vector< InitErrorEnumerator_t > vecEnumerators;
+	std::istringstream stream( Path_ReadTextFile( OPENVR_HEADER_PATH ) );
+	bool bInEnum = false;
+	std::string sLine;
+	while ( std::getline( stream, sLine ) )
+	{
+		if ( !bInEnum )
+		{
+			bInEnum = sLine.find( "enum EVRInitError" ) == 0;
+			continue;
+		}
+		if ( sLine.find( "};" ) == 0 )
+			break;
+
+		size_t unStart = sLine.find_first_not_of( " \t" );
+		size_t unEquals = sLine.find( '=' );
+		if ( unStart == std::string::npos || unEquals == std::string::npos || sLine.compare( unStart, 12, "VRInitError_" ) != 0 )
+			continue;
+
+		InitErrorEnumerator_t enumerator;
+		enumerator.sName = sLine.substr( unStart, sLine.find_first_of( " \t=", unStart ) - unStart );
+		enumerator.nValue = atoi( sLine.c_str() + unEquals + 1 );
+		vecEnumerators.push_back( enumerator );
+	}
+	return vecEnumerators;
+}
+
+static void TestEveryEnumerator()
+{
+	std::vector< InitErrorEnumerator_t > vecEnumerators = ReadInitErrorEnumerators();
+	VRTEST_CHECK( vecEnumerators.size() > 200 );
+
+	for ( const InitErrorEnumerator_t & enumerator : vecEnumerators )
+	{
+		EVRInitError eError = (EVRInitError)enumerator.nValue;
+		const char *pchID = GetIDForVRInitError( eError );
+		if ( enumerator.sName != pchID )
+		{
+			fprintf( stderr, "GetIDForVRInitError( %d ) is %s, expected %s\n", enumerator.nValue, pchID, enumerator.sName.c_str() );
+			VRTEST_CHECK( enumerator.sName == pchID );
+		}
+
+		EVRInitError eFound = VRInitError_Unknown;
+		if ( !GetVRInitErrorForID( enumerator.sName.c_str(), &eFound ) || eFound != eError )
+		{
+			fprintf( stderr, "GetVRInitErrorForID( %s ) didn't return %d\n", enumerator.sName.c_str(), enumerator.nValue );
+			VRTEST_CHECK( eFound == eError );
+		}
+	}
+
+	// every value with an ID is in the header, and round trips too
+	int nValuesWithIDs = 0;
+	for ( int nValue = -1; nValue <= 4000; nValue++ )
+	{
+		const char *pchID = GetIDForVRInitError( (EVRInitError)nValue );
+		if ( strncmp( pchID, "VRInitError_", 12 ) != 0 )
+			continue;
+
+		nValuesWithIDs++;
+		EVRInitError eFound = VRInitError_Unknown;
+		VRTEST_CHECK( GetVRInitErrorForID( pchID, &eFound ) && eFound == (EVRInitError)nValue );
+	}
+	VRTEST_CHECK( nValuesWithIDs == (int)vecEnumerators.size() );
+}
+
+static void TestUnknownIDs()
+{
+	EVRInitError eFound = VRInitError_Unknown;
+	VRTEST_CHECK( !GetVRInitErrorForID( nullptr, &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "", &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "VRInitError_", &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "VRInitError_Non", &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "VRInitError_NoneX", &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "vrinitError_none", &eFound ) );
+	VRTEST_CHECK( !GetVRInitErrorForID( "Unknown error (12345)", &eFound ) );
+	VRTEST_CHECK( eFound == VRInitError_Unknown );
+
+	// the error itself is optional
+	VRTEST_CHECK( GetVRInitErrorForID( "VRInitError_Init_HmdNotFound", nullptr ) );
+}
+
+int main()
+{
+	TestEveryEnumerator();
+	TestUnknownIDs();
+
+	return VRTest_Result( "hmderrors_test" );
+}
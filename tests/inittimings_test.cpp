@@ -0,0 +1,105 @@
+//========= Copyright Valve Corporation ============//
+// Checks the per-phase timings that VR_InitInternal2 records, using the stub vrclient's
+// artificial latencies to make the phases measurable.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <vrcore/pathtools_public.h>
+
+using namespace vr;
+
+static const uint64_t k_ulLoadDelayMs = 30;
+static const uint64_t k_ulInitDelayMs = 20;
+
+static void TestNoTimingsBeforeInit()
+{
+	VRInitTimings_t timings;
+	VRTEST_CHECK( !VR_GetLastInitTimings( &timings, sizeof( timings ) ) );
+}
+
+static void TestColdInit( const std::string &sTimingsFile )
+{
+	EVRInitError eError = VRInitError_Unknown;
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	VRInitTimings_t timings;
+	VRTEST_CHECK( !VR_GetLastInitTimings( &timings, sizeof( timings ) - 1 ) );
+	VRTEST_CHECK( VR_GetLastInitTimings( &timings, sizeof( timings ) ) );
+	VRTEST_CHECK( timings.eError == VRInitError_None );
+	VRTEST_CHECK( !timings.bClientModuleWasResident );
+	VRTEST_CHECK( timings.ulModuleLoadMicroseconds >= k_ulLoadDelayMs * 1000 );
+	VRTEST_CHECK( timings.ulClientInitMicroseconds >= k_ulInitDelayMs * 1000 );
+	VRTEST_CHECK( timings.ulTotalMicroseconds >= timings.ulPathRegistryMicroseconds + timings.ulRuntimePathCheckMicroseconds
+		+ timings.ulModuleLoadMicroseconds + timings.ulFactoryMicroseconds + timings.ulClientInitMicroseconds );
+
+	// the same numbers are written to VR_INIT_TIMINGS_PATH
+	std::string sTimings = Path_ReadTextFile( sTimingsFile );
+	VRTEST_CHECK( sTimings.find( "\"error\": \"VRInitError_None\"" ) != std::string::npos );
+	VRTEST_CHECK( sTimings.find( "\"module_load_us\": " + std::to_string( timings.ulModuleLoadMicroseconds ) ) != std::string::npos );
+	VRTEST_CHECK( sTimings.find( "\"total_us\": " + std::to_string( timings.ulTotalMicroseconds ) ) != std::string::npos );
+
+	VR_ShutdownInternal();
+}
+
+static void TestResidentInit()
+{
+	VR_SetClientModuleResident( true );
+
+	EVRInitError eError = VRInitError_Unknown;
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VR_ShutdownInternal();
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	VRInitTimings_t timings;
+	VRTEST_CHECK( VR_GetLastInitTimings( &timings, sizeof( timings ) ) );
+	VRTEST_CHECK( timings.bClientModuleWasResident );
+	VRTEST_CHECK( timings.ulModuleLoadMicroseconds == 0 );
+	VRTEST_CHECK( timings.ulClientInitMicroseconds >= k_ulInitDelayMs * 1000 );
+
+	VR_ShutdownInternal();
+	VR_SetClientModuleResident( false );
+}
+
+static void TestFailedInit()
+{
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_ERROR, "108" ); // VRInitError_Init_HmdNotFound
+	EVRInitError eError = VRInitError_None;
+	VRTEST_CHECK( VR_InitInternal2( &eError, VRApplication_Background, nullptr ) == 0 );
+	VRTEST_CHECK( eError == VRInitError_Init_HmdNotFound );
+
+	VRInitTimings_t timings;
+	VRTEST_CHECK( VR_GetLastInitTimings( &timings, sizeof( timings ) ) );
+	VRTEST_CHECK( timings.eError == VRInitError_Init_HmdNotFound );
+	VRTEST_CHECK( timings.ulModuleLoadMicroseconds > 0 );
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_ERROR, "" );
+
+	// a missing path registry stops before anything is loaded
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", STUB_VRPATH_FILE ".missing" );
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_Init_PathRegistryNotFound );
+	VRTEST_CHECK( VR_GetLastInitTimings( &timings, sizeof( timings ) ) );
+	VRTEST_CHECK( timings.eError == VRInitError_Init_PathRegistryNotFound );
+	VRTEST_CHECK( timings.ulModuleLoadMicroseconds == 0 );
+	VRTEST_CHECK( timings.ulClientInitMicroseconds == 0 );
+	VRTest_UseStubRuntime();
+}
+
+int main()
+{
+	VRTest_UseStubRuntime();
+	SetEnvironmentVariable( STUBVRCLIENT_LOAD_DELAY_MS, std::to_string( k_ulLoadDelayMs ).c_str() );
+	SetEnvironmentVariable( STUBVRCLIENT_INIT_DELAY_MS, std::to_string( k_ulInitDelayMs ).c_str() );
+
+	std::string sTimingsFile = STUB_VRPATH_FILE ".timings.json";
+	Path_UnlinkFile( sTimingsFile );
+	SetEnvironmentVariable( "VR_INIT_TIMINGS_PATH", sTimingsFile.c_str() );
+
+	TestNoTimingsBeforeInit();
+	TestColdInit( sTimingsFile );
+	TestResidentInit();
+	TestFailedInit();
+
+	return VRTest_Result( "inittimings_test" );
+}
@@ -0,0 +1,136 @@
+//========= Copyright Valve Corporation ============//
+// Tests the lock-free interface cache in openvr_api_public.cpp: repeated lookups don't reach the
+// client core, a new init starts with an empty cache, and lookups racing init and shutdown on
+// other threads never see a freed cache, and caches don't pile up over init/shutdown cycles.
+// Build with -fsanitize=address to check the freeing.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <thread>
+#include <vector>
+
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+#include <malloc.h>
+#define VRTEST_HAVE_MALLINFO2
+#endif
+
+using namespace vr;
+
+static const char * const k_rgpchInterfaces[] =
+{
+	"IVRTestInterface_000", "IVRTestInterface_001", "IVRTestInterface_002", "IVRTestInterface_003",
+	"IVRTestInterface_004", "IVRTestInterface_005", "IVRTestInterface_006", "IVRTestInterface_007",
+};
+static const int k_nInterfaceCount = sizeof( k_rgpchInterfaces ) / sizeof( k_rgpchInterfaces[0] );
+
+static void TestCachedLookups()
+{
+	EVRInitError eError = VRInitError_Unknown;
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	StubVRClientStats_t statsBefore = VRTest_GetStubStats();
+	void *pInterface = VR_GetGenericInterface( IVRSystem_Version, &eError );
+	VRTEST_CHECK( pInterface != nullptr && eError == VRInitError_None );
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) == pInterface );
+	VRTEST_CHECK( VR_IsInterfaceVersionValid( IVRSystem_Version ) );
+	VRTEST_CHECK( VR_IsInterfaceVersionValid( IVRSystem_Version ) );
+	StubVRClientStats_t statsAfter = VRTest_GetStubStats();
+	VRTEST_CHECK( statsAfter.unGetGenericInterfaceCalls == statsBefore.unGetGenericInterfaceCalls + 1 );
+	VRTEST_CHECK( statsAfter.unIsInterfaceVersionValidCalls <= statsBefore.unIsInterfaceVersionValidCalls + 1 );
+
+	// invalid versions are asked about every time
+	VRTEST_CHECK( !VR_IsInterfaceVersionValid( "NotAnInterface_001" ) );
+	VRTEST_CHECK( !VR_IsInterfaceVersionValid( "NotAnInterface_001" ) );
+	VRTEST_CHECK( VRTest_GetStubStats().unIsInterfaceVersionValidCalls == statsAfter.unIsInterfaceVersionValidCalls + 2 );
+
+	VR_ShutdownInternal();
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) == nullptr );
+	VRTEST_CHECK( eError == VRInitError_Init_NotInitialized );
+
+	// a new init asks the client core again
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+	statsBefore = VRTest_GetStubStats();
+	VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) != nullptr );
+	VRTEST_CHECK( VRTest_GetStubStats().unGetGenericInterfaceCalls == statsBefore.unGetGenericInterfaceCalls + 1 );
+	VR_ShutdownInternal();
+}
+
+static void TestLookupsDuringInitAndShutdown()
+{
+	std::atomic<bool> bStop( false );
+	std::vector< std::thread > vecThreads;
+	for ( int i = 0; i < 4; ++i )
+	{
+		vecThreads.push_back( std::thread( [&bStop, i]()
+		{
+			for ( int j = i; !bStop; ++j )
+			{
+				EVRInitError eError = VRInitError_Unknown;
+				void *pInterface = VR_GetGenericInterface( k_rgpchInterfaces[ j % k_nInterfaceCount ], &eError );
+				VRTEST_CHECK( ( pInterface != nullptr ) == ( eError == VRInitError_None ) );
+			}
+		} ) );
+	}
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		EVRInitError eError = VRInitError_Unknown;
+		VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+		VRTEST_CHECK( eError == VRInitError_None );
+		std::this_thread::yield();
+		VR_ShutdownInternal();
+	}
+
+	bStop = true;
+	for ( std::thread &thread : vecThreads )
+	{
+		thread.join();
+	}
+}
+
+// An application that looks up the same interfaces on every init, the way a launcher cycling
+// init and shutdown does, doesn't use more memory the more cycles it runs.
+static void TestMemoryAcrossInitCycles()
+{
+#if defined( VRTEST_HAVE_MALLINFO2 )
+	auto RunCycles = []( int nCycles )
+	{
+		for ( int i = 0; i < nCycles; ++i )
+		{
+			EVRInitError eError = VRInitError_Unknown;
+			VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+			VRTEST_CHECK( eError == VRInitError_None );
+			for ( const char *pchInterface : k_rgpchInterfaces )
+			{
+				VRTEST_CHECK( VR_GetGenericInterface( pchInterface, &eError ) != nullptr );
+				VRTEST_CHECK( VR_IsInterfaceVersionValid( pchInterface ) );
+			}
+			VR_ShutdownInternal();
+		}
+	};
+
+	RunCycles( 10 );
+	size_t unBytesBefore = mallinfo2().uordblks;
+	RunCycles( 500 );
+	size_t unBytesAfter = mallinfo2().uordblks;
+	VRTEST_CHECK( unBytesAfter < unBytesBefore + 16 * 1024 );
+#endif
+}
+
+int main()
+{
+	VRTest_UseStubRuntime();
+
+	// keep vrclient loaded so the cycles below are quick
+	VR_SetClientModuleResident( true );
+
+	TestCachedLookups();
+	TestLookupsDuringInitAndShutdown();
+	TestMemoryAcrossInitCycles();
+
+	VR_SetClientModuleResident( false );
+
+	return VRTest_Result( "interfacecache_test" );
+}
@@ -0,0 +1,138 @@
+//========= Copyright Valve Corporation ============//
+// Times reading a large input binding style document into a Value against reading it as events,
+// from memory and in chunks, and stopping early once the wanted member is found.
+#include "vrtest.h"
+
+#include <json/json.h>
+
+#include <string.h>
+#include <algorithm>
+#include <memory>
+
+// Counts the events, and stops the parse at the member named m_pchWantedKey if it is set
+class CEventCounter : public Json::SaxHandler
+{
+public:
+	uint64_t m_unEvents = 0;
+	const char *m_pchWantedKey = nullptr;
+	bool m_bFound = false;
+
+	virtual bool onKey( const std::string &sKey )
+	{
+		++m_unEvents;
+		if ( m_pchWantedKey && sKey == m_pchWantedKey )
+		{
+			m_bFound = true;
+			return false;
+		}
+		return true;
+	}
+	virtual bool onString( const std::string & ) { ++m_unEvents; return true; }
+	virtual bool onInt( Json::Value::LargestInt ) { ++m_unEvents; return true; }
+	virtual bool onReal( double ) { ++m_unEvents; return true; }
+	virtual bool onBool( bool ) { ++m_unEvents; return true; }
+};
+
+class CMemoryChunkSource : public Json::CharReader::ChunkSource
+{
+public:
+	explicit CMemoryChunkSource( const std::string &sDoc ) : m_sDoc( sDoc ) {}
+
+	virtual size_t read( char *pchBuffer, size_t unSize )
+	{
+		size_t unChunk = std::min( unSize, m_sDoc.size() - m_unPos );
+		memcpy( pchBuffer, m_sDoc.data() + m_unPos, unChunk );
+		m_unPos += unChunk;
+		return unChunk;
+	}
+
+private:
+	const std::string &m_sDoc;
+	size_t m_unPos = 0;
+};
+
+static std::string BuildBindingDocument( uint32_t unBindings )
+{
+	std::string sDoc = "{\"version\":1,\"bindings\":{";
+	for ( uint32_t i = 0; i < unBindings; ++i )
+	{
+		char rchBinding[ 400 ];
+		snprintf( rchBinding, sizeof( rchBinding ),
+			"%s\"/actions/main/in/action%u\":{\"path\":\"/user/hand/left/input/trigger\",\"mode\":\"button\","
+			"\"weight\":%u.%u,\"enabled\":true,\"inputs\":[{\"click\":\"/actions/a%u\"},{\"touch\":null}]}\n",
+			i ? "," : "", i, i % 7, i % 10, i );
+		sDoc += rchBinding;
+	}
+	sDoc += "},\"controller_type\":\"knuckles\"}";
+	return sDoc;
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+
+	std::string sDoc = BuildBindingDocument( (uint32_t)VRTest_Scaled( 60000, flScale ) );
+	printf( "document is %.1f MB\n", sDoc.size() / 1e6 );
+
+	Json::CharReaderBuilder builder;
+	builder[ "collectComments" ] = false;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	const char *pchBegin = sDoc.data();
+	const char *pchEnd = sDoc.data() + sDoc.size();
+
+	uint64_t unIterations = VRTest_Scaled( 10, flScale );
+	std::string sErrors;
+
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		Json::Value root;
+		VRTEST_CHECK( pReader->parse( pchBegin, pchEnd, &root, &sErrors ) );
+	}
+	VRTest_Report( "parse into Value", unIterations, VRTest_Seconds() - flStart );
+
+	uint64_t unEvents = 0;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CEventCounter counter;
+		VRTEST_CHECK( pReader->parseEvents( pchBegin, pchEnd, counter, &sErrors ) );
+		unEvents = counter.m_unEvents;
+	}
+	VRTest_Report( "parseEvents from memory", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unEvents > 0 );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CEventCounter counter;
+		CMemoryChunkSource source( sDoc );
+		VRTEST_CHECK( pReader->parseEvents( source, counter, &sErrors ) );
+		VRTEST_CHECK( counter.m_unEvents == unEvents );
+	}
+	VRTest_Report( "parseEvents in chunks", unIterations, VRTest_Seconds() - flStart );
+
+	// the wanted member comes first, so the rest of the document is never tokenized
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CEventCounter counter;
+		counter.m_pchWantedKey = "bindings";
+		VRTEST_CHECK( pReader->parseEvents( pchBegin, pchEnd, counter, &sErrors ) );
+		VRTEST_CHECK( counter.m_bFound );
+	}
+	VRTest_Report( "parseEvents, stop at first member", unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CEventCounter counter;
+		counter.m_pchWantedKey = "controller_type";
+		CMemoryChunkSource source( sDoc );
+		VRTEST_CHECK( pReader->parseEvents( source, counter, &sErrors ) );
+		VRTEST_CHECK( counter.m_bFound );
+	}
+	VRTest_Report( "parseEvents in chunks, stop at last member", unIterations, VRTest_Seconds() - flStart );
+
+	return VRTest_Result( "jsonbench" );
+}
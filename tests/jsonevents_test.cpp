@@ -0,0 +1,350 @@
+//========= Copyright Valve Corporation ============//
+// Tests that CharReader::parseEvents() agrees with CharReader::parse(), both on a document in
+// memory and on one read a few bytes at a time, including where errors are reported.
+#include "vrtest.h"
+
+#include <json/json.h>
+
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// Builds a Value from the events, so the result can be compared with what parse() returns
+class CValueBuilder : public Json::SaxHandler
+{
+public:
+	Json::Value m_root;
+	int m_nStopAfter = -1;
+	int m_nValues = 0;
+
+	virtual bool onObjectBegin() { return BAdd( Json::Value( Json::objectValue ) ); }
+	virtual bool onArrayBegin() { return BAdd( Json::Value( Json::arrayValue ) ); }
+	virtual bool onObjectEnd() { m_vecOpen.pop_back(); return true; }
+	virtual bool onArrayEnd() { m_vecOpen.pop_back(); return true; }
+	virtual bool onKey( const std::string &sKey ) { m_sKey = sKey; return true; }
+	virtual bool onString( const std::string &sValue ) { return BAdd( Json::Value( sValue ) ); }
+	virtual bool onInt( Json::Value::LargestInt nValue ) { return BAdd( Json::Value( nValue ) ); }
+	virtual bool onUInt( Json::Value::LargestUInt unValue ) { return BAdd( Json::Value( unValue ) ); }
+	virtual bool onReal( double flValue ) { return BAdd( Json::Value( flValue ) ); }
+	virtual bool onBool( bool bValue ) { return BAdd( Json::Value( bValue ) ); }
+	virtual bool onNull() { return BAdd( Json::Value() ); }
+
+private:
+	bool BAdd( const Json::Value &value )
+	{
+		if ( ++m_nValues == m_nStopAfter )
+			return false;
+
+		Json::Value *pTarget;
+		if ( m_vecOpen.empty() )
+			pTarget = &m_root;
+		else if ( m_vecOpen.back()->isArray() )
+			pTarget = &m_vecOpen.back()->append( Json::Value() );
+		else
+			pTarget = &( *m_vecOpen.back() )[ m_sKey ];
+
+		*pTarget = value;
+		if ( value.isObject() || value.isArray() )
+			m_vecOpen.push_back( pTarget );
+		return true;
+	}
+
+	std::vector< Json::Value * > m_vecOpen;
+	std::string m_sKey;
+};
+
+// Hands out a document in chunks of 1 to nMaxChunk bytes
+class CSmallChunkSource : public Json::CharReader::ChunkSource
+{
+public:
+	CSmallChunkSource( const std::string &sDoc, std::mt19937 &rng, int nMaxChunk )
+		: m_sDoc( sDoc ), m_rng( rng ), m_nMaxChunk( nMaxChunk ) {}
+
+	virtual size_t read( char *pchBuffer, size_t unSize )
+	{
+		size_t unChunk = std::min( { unSize, m_sDoc.size() - m_unPos, (size_t)( 1 + m_rng() % m_nMaxChunk ) } );
+		memcpy( pchBuffer, m_sDoc.data() + m_unPos, unChunk );
+		m_unPos += unChunk;
+		return unChunk;
+	}
+
+private:
+	const std::string &m_sDoc;
+	size_t m_unPos = 0;
+	std::mt19937 &m_rng;
+	int m_nMaxChunk;
+};
+
+static const char *k_rgpchAtoms[] =
+{
+	// values
+	"0", "-1", "12345678901234567890", "-9223372036854775808", "4294967296", "1.5e3", "-0.25", "1e400",
+	"true", "false", "null", "\"a\\u00e9\\ud83d\\ude00\\n\"", "\"\"", "\"k\"",
+	// only valid with some settings, or not at all
+	"NaN", "Infinity", "-Infinity", "'sq'", "/*c*/", "//c\n", " ", "\n", "\r\n", "\r",
+};
+static const size_t k_unValueAtoms = 14;
+static const size_t k_unAtoms = sizeof( k_rgpchAtoms ) / sizeof( k_rgpchAtoms[ 0 ] );
+
+static std::string GenerateDocument( std::mt19937 &rng, int nDepth )
+{
+	int nKind = rng() % 10;
+	if ( nDepth > 4 || nKind < 5 )
+		return k_rgpchAtoms[ rng() % k_unValueAtoms ];
+
+	std::string sDoc;
+	int nCount = rng() % 4;
+	if ( nKind < 7 )
+	{
+		sDoc = "[";
+		for ( int i = 0; i < nCount; ++i )
+		{
+			if ( i )
+				sDoc += ",";
+			sDoc += GenerateDocument( rng, nDepth + 1 );
+		}
+		sDoc += "]";
+	}
+	else
+	{
+		sDoc = "{";
+		for ( int i = 0; i < nCount; ++i )
+		{
+			if ( i )
+				sDoc += ",";
+			sDoc += ( rng() % 3 ) ? "\"k" + std::to_string( rng() % 3 ) + "\"" : "7";
+			sDoc += ":";
+			sDoc += GenerateDocument( rng, nDepth + 1 );
+		}
+		sDoc += "}";
+	}
+	return sDoc;
+}
+
+// Deletes characters and inserts punctuation and atoms at random, mostly making the document invalid
+static void MutateDocument( std::mt19937 &rng, std::string *psDoc )
+{
+	static const char k_rgchPunctuation[] = "[]{},:\"'/ *tn-1eI\r\n";
+	int nMutations = rng() % 4;
+	for ( int i = 0; i < nMutations; ++i )
+	{
+		size_t unPos = rng() % ( psDoc->size() + 1 );
+		switch ( rng() % 3 )
+		{
+		case 0:
+			if ( unPos < psDoc->size() )
+				psDoc->erase( unPos, 1 );
+			break;
+		case 1:
+			psDoc->insert( unPos, 1, k_rgchPunctuation[ rng() % ( sizeof( k_rgchPunctuation ) - 1 ) ] );
+			break;
+		default:
+			psDoc->insert( unPos, k_rgpchAtoms[ rng() % k_unAtoms ] );
+			break;
+		}
+	}
+}
+
+static void ApplySettings( int nMode, Json::CharReaderBuilder *pBuilder )
+{
+	( *pBuilder )[ "collectComments" ] = false;
+	switch ( nMode )
+	{
+	case 1:
+		Json::CharReaderBuilder::strictMode( &pBuilder->settings_ );
+		break;
+	case 2:
+		( *pBuilder )[ "allowSpecialFloats" ] = true;
+		( *pBuilder )[ "allowSingleQuotes" ] = true;
+		break;
+	case 3:
+		( *pBuilder )[ "allowDroppedNullPlaceholders" ] = true;
+		( *pBuilder )[ "allowNumericKeys" ] = true;
+		( *pBuilder )[ "failIfExtra" ] = true;
+		break;
+	case 4:
+		( *pBuilder )[ "rejectDupKeys" ] = true;
+		( *pBuilder )[ "strictRoot" ] = true;
+		( *pBuilder )[ "allowComments" ] = false;
+		break;
+	}
+}
+
+// Returns the "* Line N, Column M" line that starts the first error
+static std::string FirstErrorLocation( const std::string &sErrors )
+{
+	return sErrors.substr( 0, sErrors.find( '\n' ) );
+}
+
+static void TestAgreesWithParse()
+{
+	std::mt19937 rng( 1 );
+	int nMismatches = 0;
+	for ( int nIteration = 0; nIteration < 20000; ++nIteration )
+	{
+		Json::CharReaderBuilder builder;
+		ApplySettings( nIteration % 5, &builder );
+		std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+
+		static const char *k_rgpchTrailers[] = { "", " ", "/*x*/", " 1", "\n", "\r" };
+		std::string sDoc = GenerateDocument( rng, 0 );
+		sDoc += k_rgpchTrailers[ rng() % ( sizeof( k_rgpchTrailers ) / sizeof( k_rgpchTrailers[ 0 ] ) ) ];
+		if ( rng() % 2 )
+			MutateDocument( rng, &sDoc );
+
+		Json::Value root;
+		std::string sParseErrors;
+		bool bParsed = false;
+		bool bParseThrew = false;
+		try
+		{
+			bParsed = pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &root, &sParseErrors );
+		}
+		catch ( const std::exception & )
+		{
+			bParseThrew = true;
+		}
+
+		for ( int nSource = 0; nSource < 2; ++nSource )
+		{
+			CValueBuilder handler;
+			std::string sEventErrors;
+			bool bEventsParsed = false;
+			bool bEventsThrew = false;
+			try
+			{
+				if ( nSource == 0 )
+				{
+					bEventsParsed = pReader->parseEvents( sDoc.data(), sDoc.data() + sDoc.size(), handler, &sEventErrors );
+				}
+				else
+				{
+					CSmallChunkSource source( sDoc, rng, 1 + rng() % 8 );
+					bEventsParsed = pReader->parseEvents( source, handler, &sEventErrors );
+				}
+			}
+			catch ( const std::exception & )
+			{
+				bEventsThrew = true;
+			}
+
+			bool bAgrees = bParseThrew == bEventsThrew && bParsed == bEventsParsed;
+			if ( bAgrees && bParsed )
+				bAgrees = root.toStyledString() == handler.m_root.toStyledString() && sEventErrors.empty();
+			// parse() checks the root after reading it and keeps going after errors, so the
+			// first error it reports can differ; parseEvents() only has to report one
+			if ( bAgrees && !bParsed && !bParseThrew )
+				bAgrees = !sEventErrors.empty();
+
+			if ( !bAgrees && nMismatches++ < 8 )
+			{
+				fprintf( stderr, "mismatch (source %d, settings %d) on [%s]\n  parse: %s  events: %s\n",
+					nSource, nIteration % 5, sDoc.c_str(), sParseErrors.c_str(), sEventErrors.c_str() );
+			}
+			VRTEST_CHECK( bAgrees );
+		}
+	}
+}
+
+static void TestEarlyStop()
+{
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+
+	// the document is cut short, but the handler stops before that is reached
+	std::string sDoc = "[1,2,3,4,";
+	CValueBuilder handler;
+	handler.m_nStopAfter = 3;
+	std::string sErrors;
+	VRTEST_CHECK( pReader->parseEvents( sDoc.data(), sDoc.data() + sDoc.size(), handler, &sErrors ) );
+	VRTEST_CHECK( handler.m_nValues == 3 );
+	VRTEST_CHECK( sErrors.empty() );
+}
+
+// Errors well past the first chunk are reported at the same line and column as parse() reports
+// them, whichever line breaks the document uses and wherever the chunks split them.
+static void TestErrorLocationAcrossChunks()
+{
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	std::mt19937 rng( 2 );
+
+	static const char *k_rgpchLineBreaks[] = { "\n", "\r\n", "\r" };
+	for ( const char *pchLineBreak : k_rgpchLineBreaks )
+	{
+		std::string sDoc = "[";
+		for ( int i = 0; i < 40000; ++i )
+		{
+			sDoc += "1,";
+			sDoc += pchLineBreak;
+		}
+		sDoc += "  x]";
+
+		Json::Value root;
+		std::string sParseErrors;
+		VRTEST_CHECK( !pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &root, &sParseErrors ) );
+		VRTEST_CHECK( FirstErrorLocation( sParseErrors ) == "* Line 40001, Column 3" );
+
+		CValueBuilder handler;
+		std::string sEventErrors;
+		std::istringstream stream( sDoc );
+		VRTEST_CHECK( !Json::parseEventsFromStream( builder, stream, handler, &sEventErrors ) );
+		VRTEST_CHECK( FirstErrorLocation( sEventErrors ) == FirstErrorLocation( sParseErrors ) );
+
+		CValueBuilder smallChunkHandler;
+		CSmallChunkSource source( sDoc, rng, 8 );
+		sEventErrors.clear();
+		VRTEST_CHECK( !pReader->parseEvents( source, smallChunkHandler, &sEventErrors ) );
+		VRTEST_CHECK( FirstErrorLocation( sEventErrors ) == FirstErrorLocation( sParseErrors ) );
+	}
+}
+
+// A duplicate key is only known to be an error once the ':' after it has been read, which can
+// pull in several more chunks. The error is still reported at the key.
+static void TestDuplicateKeyAcrossChunks()
+{
+	Json::CharReaderBuilder builder;
+	Json::CharReaderBuilder::strictMode( &builder.settings_ );
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	std::mt19937 rng( 3 );
+
+	// the longer padding makes the buffer grow, and move, while the ':' is being found
+	static const size_t k_rgunPadding[] = { 40, 200000 };
+	for ( size_t unPadding : k_rgunPadding )
+	{
+		std::string sDoc = "{\"aaaa\":1,\n\n \"aaaa\"" + std::string( unPadding, ' ' ) + ":2}";
+
+		Json::Value root;
+		std::string sParseErrors;
+		VRTEST_CHECK( !pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &root, &sParseErrors ) );
+		VRTEST_CHECK( FirstErrorLocation( sParseErrors ) == "* Line 3, Column 2" );
+
+		for ( int nMaxChunk : { 1, 8 } )
+		{
+			CValueBuilder handler;
+			CSmallChunkSource source( sDoc, rng, nMaxChunk );
+			std::string sEventErrors;
+			VRTEST_CHECK( !pReader->parseEvents( source, handler, &sEventErrors ) );
+			VRTEST_CHECK( sEventErrors == sParseErrors );
+		}
+
+		CValueBuilder handler;
+		std::string sEventErrors;
+		std::istringstream stream( sDoc );
+		VRTEST_CHECK( !Json::parseEventsFromStream( builder, stream, handler, &sEventErrors ) );
+		VRTEST_CHECK( sEventErrors == sParseErrors );
+	}
+}
+
+int main()
+{
+	TestAgreesWithParse();
+	TestEarlyStop();
+	TestErrorLocationAcrossChunks();
+	TestDuplicateKeyAcrossChunks();
+
+	return VRTest_Result( "jsonevents_test" );
+}
@@ -0,0 +1,155 @@
+//========= Copyright Valve Corporation ============//
+// Measures the loader in openvr_api_public.cpp against the stub vrclient. Pass a scale for the
+// iteration counts as the first argument. The stub's latencies can be set with the
+// STUBVRCLIENT_* environment variables (see stubvrclient/stubvrclient.h).
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace vr;
+
+static void BenchIsRuntimeInstalled( double flScale )
+{
+	uint64_t unIterations = VRTest_Scaled( 10000, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( VR_IsRuntimeInstalled() );
+	}
+	VRTest_Report( "VR_IsRuntimeInstalled", unIterations, VRTest_Seconds() - flStart );
+}
+
+static void BenchIsHmdPresent( double flScale )
+{
+	uint64_t unIterations = VRTest_Scaled( 1000, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( VR_IsHmdPresent() );
+	}
+	VRTest_Report( "VR_IsHmdPresent", unIterations, VRTest_Seconds() - flStart );
+}
+
+// Cold loads vrclient on every init; warm keeps it resident with VR_SetClientModuleResident
+static void BenchInitShutdown( double flScale, bool bResident )
+{
+	VR_SetClientModuleResident( bResident );
+
+	uint64_t unIterations = VRTest_Scaled( 1000, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		EVRInitError eError = VRInitError_Unknown;
+		VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+		VRTEST_CHECK( eError == VRInitError_None );
+		VR_ShutdownInternal();
+	}
+	VRTest_Report( bResident ? "VR_InitInternal2 + VR_ShutdownInternal (warm)" : "VR_InitInternal2 + VR_ShutdownInternal (cold)",
+		unIterations, VRTest_Seconds() - flStart );
+
+	VR_SetClientModuleResident( false );
+}
+
+// What a launcher does: poll for an HMD, then init
+static void BenchHmdPresentThenInit( double flScale, bool bResident )
+{
+	VR_SetClientModuleResident( bResident );
+
+	uint64_t unIterations = VRTest_Scaled( 1000, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( VR_IsHmdPresent() );
+		EVRInitError eError = VRInitError_Unknown;
+		VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+		VRTEST_CHECK( eError == VRInitError_None );
+		VR_ShutdownInternal();
+	}
+	VRTest_Report( bResident ? "VR_IsHmdPresent + init + shutdown (warm)" : "VR_IsHmdPresent + init + shutdown (cold)",
+		unIterations, VRTest_Seconds() - flStart );
+
+	VR_SetClientModuleResident( false );
+}
+
+static void BenchGetGenericInterface( double flScale )
+{
+	EVRInitError eError = VRInitError_Unknown;
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	uint64_t unIterations = VRTest_Scaled( 1000000, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( VR_GetGenericInterface( IVRSystem_Version, &eError ) != nullptr );
+	}
+	VRTest_Report( "VR_GetGenericInterface", unIterations, VRTest_Seconds() - flStart );
+
+	VR_ShutdownInternal();
+}
+
+// Runs unIterations lookups on each of nThreads threads at once. Valid interfaces are answered from
+// the lock-free interface cache. An invalid version is never cached, so it measures the locked path
+// through the client core that every lookup used to take.
+static void BenchInterfaceContention( double flScale, int nThreads, bool bCached )
+{
+	EVRInitError eError = VRInitError_Unknown;
+	VR_InitInternal2( &eError, VRApplication_Background, nullptr );
+	VRTEST_CHECK( eError == VRInitError_None );
+
+	const char *pchInterfaceVersion = bCached ? IVRSystem_Version : "NotAnInterface_001";
+	VRTEST_CHECK( VR_IsInterfaceVersionValid( pchInterfaceVersion ) == bCached );
+
+	uint64_t unIterations = VRTest_Scaled( 200000, flScale );
+	std::atomic<bool> bGo( false );
+	std::vector< std::thread > vecThreads;
+	for ( int i = 0; i < nThreads; ++i )
+	{
+		vecThreads.push_back( std::thread( [&]()
+		{
+			while ( !bGo )
+				std::this_thread::yield();
+			for ( uint64_t j = 0; j < unIterations; ++j )
+			{
+				VRTEST_CHECK( VR_IsInterfaceVersionValid( pchInterfaceVersion ) == bCached );
+			}
+		} ) );
+	}
+
+	double flStart = VRTest_Seconds();
+	bGo = true;
+	for ( std::thread &thread : vecThreads )
+	{
+		thread.join();
+	}
+	double flSeconds = VRTest_Seconds() - flStart;
+
+	std::string sName = std::string( bCached ? "VR_IsInterfaceVersionValid (cached), " : "VR_IsInterfaceVersionValid (locked), " )
+		+ std::to_string( nThreads ) + " thread(s)";
+	VRTest_Report( sName.c_str(), unIterations * nThreads, flSeconds );
+
+	VR_ShutdownInternal();
+}
+
+int main( int argc, char **argv )
+{
+	VRTest_UseStubRuntime();
+	double flScale = VRTest_BenchScale( argc, argv );
+
+	BenchIsRuntimeInstalled( flScale );
+	BenchIsHmdPresent( flScale );
+	BenchInitShutdown( flScale, false );
+	BenchInitShutdown( flScale, true );
+	BenchHmdPresentThenInit( flScale, false );
+	BenchHmdPresentThenInit( flScale, true );
+	BenchGetGenericInterface( flScale );
+	for ( int nThreads = 1; nThreads <= 8; nThreads *= 2 )
+	{
+		BenchInterfaceContention( flScale, nThreads, true );
+		BenchInterfaceContention( flScale, nThreads, false );
+	}
+
+	return VRTest_Result( "loaderbench" );
+}
@@ -0,0 +1,101 @@
+//========= Copyright Valve Corporation ============//
+// Measures SharedLib_LoadMultiple against loading the same libraries one at a time, using the
+// libraries generated from sharedlibtest/loadbenchlib.cpp. Pass a scale for the iteration counts
+// as the first argument. On Linux the cold runs first evict the libraries from the page cache.
+#include "vrtest.h"
+
+#if defined( LINUX )
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+typedef int ( *LoadBenchLibIdFn )();
+
+static std::vector< std::string > GetLibraryPaths()
+{
+	std::vector< std::string > vecPaths;
+	for ( int i = 1; i <= LOADBENCHLIB_COUNT; i++ )
+	{
+		vecPaths.push_back( std::string( LOADBENCHLIB_DIR "/loadbenchlib" ) + std::to_string( i ) + LOADBENCHLIB_SUFFIX );
+	}
+	return vecPaths;
+}
+
+// Drops the files' pages from the page cache, so the next load has to read them from disk
+static void EvictFromPageCache( const std::vector< std::string > & vecPaths )
+{
+#if defined( LINUX )
+	for ( const std::string & sPath : vecPaths )
+	{
+		int fd = open( sPath.c_str(), O_RDONLY | O_CLOEXEC );
+		if ( fd < 0 )
+			continue;
+		posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+		close( fd );
+	}
+#else
+	(void)vecPaths;
+#endif
+}
+
+static void BenchLoad( double flScale, bool bParallel, bool bCold, ESharedLibBinding eBinding )
+{
+	std::vector< std::string > vecPaths = GetLibraryPaths();
+	uint64_t unIterations = VRTest_Scaled( 50, flScale );
+	double flSeconds = 0;
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		if ( bCold )
+			EvictFromPageCache( vecPaths );
+
+		std::vector< SharedLibHandle > vecLibs;
+		double flStart = VRTest_Seconds();
+		if ( bParallel )
+		{
+			for ( const SharedLibLoadResult_t & result : SharedLib_LoadMultiple( vecPaths, eBinding ) )
+			{
+				VRTEST_CHECK( result.lib != nullptr );
+				vecLibs.push_back( result.lib );
+			}
+		}
+		else
+		{
+			for ( const std::string & sPath : vecPaths )
+			{
+				vecLibs.push_back( SharedLib_Load( sPath.c_str(), nullptr, eBinding ) );
+				VRTEST_CHECK( vecLibs.back() != nullptr );
+			}
+		}
+		flSeconds += VRTest_Seconds() - flStart;
+
+		// results come back in the order of the paths
+		for ( size_t unLib = 0; unLib < vecLibs.size(); unLib++ )
+		{
+			LoadBenchLibIdFn pfnId = ( LoadBenchLibIdFn )SharedLib_GetFunction( vecLibs[ unLib ], "LoadBenchLib_Id" );
+			VRTEST_CHECK( pfnId && pfnId() == (int)unLib + 1 );
+			SharedLib_Unload( vecLibs[ unLib ] );
+		}
+	}
+
+	std::string sName = std::string( bParallel ? "SharedLib_LoadMultiple" : "SharedLib_Load each" )
+		+ ( bCold ? ", cold" : ", warm" ) + ( eBinding == k_ESharedLibBinding_Now ? ", now" : ", lazy" );
+	VRTest_Report( sName.c_str(), unIterations, flSeconds );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+
+	for ( int nBinding = 0; nBinding < 2; nBinding++ )
+	{
+		ESharedLibBinding eBinding = nBinding ? k_ESharedLibBinding_Lazy : k_ESharedLibBinding_Now;
+		BenchLoad( flScale, false, false, eBinding );
+		BenchLoad( flScale, true, false, eBinding );
+#if defined( LINUX )
+		BenchLoad( flScale, false, true, eBinding );
+		BenchLoad( flScale, true, true, eBinding );
+#endif
+	}
+
+	return VRTest_Result( "loadmultiplebench" );
+}
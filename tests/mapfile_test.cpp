@@ -0,0 +1,193 @@
+//========= Copyright Valve Corporation ============//
+// Tests Path_MapFile and CMappedFile: regular files are mapped, pipes and special files fall back
+// to being read into a buffer, and both give the same bytes as Path_ReadBinaryFile.
+#include "vrtest.h"
+
+#include <vrcore/pathtools_public.h>
+
+#include <string.h>
+#include <thread>
+
+#if !defined( _WIN32 )
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const std::string k_sMapFile = std::string( STUB_VRPATH_FILE ) + ".mapfile";
+
+static std::vector< uint8_t > MakeContents( size_t unSize )
+{
+	std::vector< uint8_t > vecContents( unSize );
+	for ( size_t i = 0; i < unSize; ++i )
+	{
+		vecContents[ i ] = (uint8_t)( i * 131 + ( i >> 8 ) );
+	}
+	return vecContents;
+}
+
+static bool BSameBytes( const CMappedFile & mappedFile, const std::vector< uint8_t > & vecExpected )
+{
+	return mappedFile.GetSize() == vecExpected.size()
+		&& ( vecExpected.empty() || memcmp( mappedFile.GetData(), &vecExpected[ 0 ], vecExpected.size() ) == 0 );
+}
+
+static void TestRegularFile()
+{
+	static const uint32_t k_rgunHints[] =
+	{
+		k_EPathMapFileHint_None,
+		k_EPathMapFileHint_Sequential,
+		k_EPathMapFileHint_WillNeed,
+		k_EPathMapFileHint_Sequential | k_EPathMapFileHint_WillNeed,
+	};
+
+	// sizes around a page boundary, and one big enough to span many pages
+	static const size_t k_rgunSizes[] = { 1, 4095, 4096, 4097, 3 * 1024 * 1024 + 17 };
+	for ( size_t unSize : k_rgunSizes )
+	{
+		std::vector< uint8_t > vecContents = MakeContents( unSize );
+		VRTEST_CHECK( Path_WriteBinaryFile( k_sMapFile, &vecContents[ 0 ], (unsigned)vecContents.size() ) );
+		VRTEST_CHECK( Path_ReadBinaryFile( k_sMapFile ) == vecContents );
+
+		for ( uint32_t unHints : k_rgunHints )
+		{
+			CMappedFile mappedFile;
+			VRTEST_CHECK( Path_MapFile( k_sMapFile, &mappedFile, unHints ) );
+			VRTEST_CHECK( mappedFile.IsValid() );
+			VRTEST_CHECK( mappedFile.IsMapped() );
+			VRTEST_CHECK( BSameBytes( mappedFile, vecContents ) );
+		}
+	}
+
+	// an empty file is valid but has no data, and nothing to map
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sMapFile, "" ) );
+	CMappedFile mappedFile;
+	VRTEST_CHECK( Path_MapFile( k_sMapFile, &mappedFile ) );
+	VRTEST_CHECK( mappedFile.IsValid() );
+	VRTEST_CHECK( !mappedFile.IsMapped() );
+	VRTEST_CHECK( mappedFile.GetSize() == 0 );
+
+	// a failed open leaves the view empty, even if it held a file before
+	VRTEST_CHECK( Path_UnlinkFile( k_sMapFile ) );
+	VRTEST_CHECK( !Path_MapFile( k_sMapFile, &mappedFile ) );
+	VRTEST_CHECK( !mappedFile.IsValid() );
+	VRTEST_CHECK( mappedFile.GetData() == nullptr && mappedFile.GetSize() == 0 );
+	VRTEST_CHECK( !Path_MapFile( k_sMapFile, nullptr ) );
+}
+
+// The data stays valid after the file is replaced or deleted, for as long as the view is open
+static void TestOutlivesFile()
+{
+	std::vector< uint8_t > vecContents = MakeContents( 10000 );
+	VRTEST_CHECK( Path_WriteBinaryFile( k_sMapFile, &vecContents[ 0 ], (unsigned)vecContents.size() ) );
+
+	CMappedFile mappedFile;
+	VRTEST_CHECK( Path_MapFile( k_sMapFile, &mappedFile ) );
+	VRTEST_CHECK( Path_WriteStringToTextFileAtomic( k_sMapFile, "replaced" ) );
+	VRTEST_CHECK( BSameBytes( mappedFile, vecContents ) );
+	VRTEST_CHECK( Path_UnlinkFile( k_sMapFile ) );
+	VRTEST_CHECK( BSameBytes( mappedFile, vecContents ) );
+}
+
+static void TestMove( bool bMapped, const std::string & sFilename, const std::vector< uint8_t > & vecContents )
+{
+	CMappedFile mappedFile;
+	VRTEST_CHECK( Path_MapFile( sFilename, &mappedFile ) );
+	VRTEST_CHECK( mappedFile.IsMapped() == bMapped );
+
+	CMappedFile movedTo( std::move( mappedFile ) );
+	VRTEST_CHECK( !mappedFile.IsValid() && mappedFile.GetData() == nullptr && mappedFile.GetSize() == 0 );
+	VRTEST_CHECK( movedTo.IsValid() && movedTo.IsMapped() == bMapped );
+	VRTEST_CHECK( BSameBytes( movedTo, vecContents ) );
+
+	CMappedFile assignedTo;
+	assignedTo = std::move( movedTo );
+	VRTEST_CHECK( !movedTo.IsValid() );
+	VRTEST_CHECK( BSameBytes( assignedTo, vecContents ) );
+
+	assignedTo.Close();
+	VRTEST_CHECK( !assignedTo.IsValid() && assignedTo.GetData() == nullptr && assignedTo.GetSize() == 0 );
+}
+
+#if !defined( _WIN32 )
+// Pipes can't be mapped, so they are read until the writer closes them
+static void TestPipeFallback()
+{
+	const std::string sFifo = k_sMapFile + ".fifo";
+	unlink( sFifo.c_str() );
+	VRTEST_CHECK( mkfifo( sFifo.c_str(), 0600 ) == 0 );
+
+	// more than one read chunk, so the fallback has to loop
+	std::vector< uint8_t > vecContents = MakeContents( 200000 );
+	for ( int nPass = 0; nPass < 2; ++nPass )
+	{
+		std::thread writer( [&]()
+		{
+			int nFd = open( sFifo.c_str(), O_WRONLY );
+			VRTEST_CHECK( nFd >= 0 );
+			size_t unWritten = 0;
+			while ( nFd >= 0 && unWritten < vecContents.size() )
+			{
+				ssize_t nResult = write( nFd, &vecContents[ unWritten ], vecContents.size() - unWritten );
+				VRTEST_CHECK( nResult > 0 );
+				if ( nResult <= 0 )
+					break;
+				unWritten += (size_t)nResult;
+			}
+			close( nFd );
+		} );
+
+		if ( nPass == 0 )
+		{
+			CMappedFile mappedFile;
+			VRTEST_CHECK( Path_MapFile( sFifo, &mappedFile, k_EPathMapFileHint_Sequential ) );
+			VRTEST_CHECK( mappedFile.IsValid() );
+			VRTEST_CHECK( !mappedFile.IsMapped() );
+			VRTEST_CHECK( BSameBytes( mappedFile, vecContents ) );
+		}
+		else
+		{
+			// a buffered view has to take its buffer with it when it moves
+			TestMove( false, sFifo, vecContents );
+		}
+		writer.join();
+	}
+
+	unlink( sFifo.c_str() );
+}
+#endif
+
+#if defined( LINUX )
+// procfs files report a size of zero but do have contents
+static void TestZeroSizedSpecialFile()
+{
+	CMappedFile mappedFile;
+	VRTEST_CHECK( Path_MapFile( "/proc/self/status", &mappedFile ) );
+	VRTEST_CHECK( mappedFile.IsValid() );
+	VRTEST_CHECK( !mappedFile.IsMapped() );
+	VRTEST_CHECK( mappedFile.GetSize() > 0 );
+	std::string sStatus( (const char *)mappedFile.GetData(), mappedFile.GetSize() );
+	VRTEST_CHECK( sStatus.find( "Name:" ) != std::string::npos );
+}
+#endif
+
+int main()
+{
+	TestRegularFile();
+	TestOutlivesFile();
+
+	std::vector< uint8_t > vecContents = MakeContents( 50000 );
+	VRTEST_CHECK( Path_WriteBinaryFile( k_sMapFile, &vecContents[ 0 ], (unsigned)vecContents.size() ) );
+	TestMove( true, k_sMapFile, vecContents );
+	Path_UnlinkFile( k_sMapFile );
+
+#if !defined( _WIN32 )
+	TestPipeFallback();
+#endif
+#if defined( LINUX )
+	TestZeroSizedSpecialFile();
+#endif
+
+	return VRTest_Result( "mapfile_test" );
+}
@@ -0,0 +1,95 @@
+//========= Copyright Valve Corporation ============//
+// Times Path_MapFile against Path_ReadBinaryFile on 4 KB, 1 MB and 256 MB files. The largest
+// file shrinks with the benchmark scale so that ctest doesn't write 256 MB.
+#include "vrtest.h"
+
+#include <vrcore/pathtools_public.h>
+
+#include <string>
+
+static const std::string k_sBenchFile = std::string( STUB_VRPATH_FILE ) + ".mapfilebench";
+
+// Reads one byte per page, which is what it takes to fault a mapped file in
+static uint64_t TouchPages( const uint8_t *pData, size_t unSize )
+{
+	uint64_t ulSum = 0;
+	for ( size_t i = 0; i < unSize; i += 4096 )
+	{
+		ulSum += pData[ i ];
+	}
+	return ulSum;
+}
+
+// Reads every byte, so that a copy and a mapping are compared doing the same work
+static uint64_t SumBytes( const uint8_t *pData, size_t unSize )
+{
+	uint64_t ulSum = 0;
+	for ( size_t i = 0; i < unSize; ++i )
+	{
+		ulSum += pData[ i ];
+	}
+	return ulSum;
+}
+
+static void BenchFileSize( size_t unSize, uint64_t unIterations )
+{
+	std::vector< uint8_t > vecContents( unSize );
+	for ( size_t i = 0; i < unSize; ++i )
+	{
+		vecContents[ i ] = (uint8_t)( i * 131 );
+	}
+	VRTEST_CHECK( Path_WriteBinaryFile( k_sBenchFile, &vecContents[ 0 ], (unsigned)unSize ) );
+	const uint64_t ulExpectedPages = TouchPages( &vecContents[ 0 ], unSize );
+	const uint64_t ulExpectedSum = SumBytes( &vecContents[ 0 ], unSize );
+	std::vector< uint8_t >().swap( vecContents );
+
+	std::string sSize = unSize >= 1024 * 1024 ? std::to_string( unSize / ( 1024 * 1024 ) ) + " MB" : std::to_string( unSize / 1024 ) + " KB";
+
+	// the file was just written, so all of these read from the page cache
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		std::vector< uint8_t > vecRead = Path_ReadBinaryFile( k_sBenchFile );
+		VRTEST_CHECK( vecRead.size() == unSize && TouchPages( &vecRead[ 0 ], unSize ) == ulExpectedPages );
+	}
+	VRTest_Report( ( "Path_ReadBinaryFile, touch pages, " + sSize ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CMappedFile mappedFile;
+		VRTEST_CHECK( Path_MapFile( k_sBenchFile, &mappedFile ) );
+		VRTEST_CHECK( mappedFile.GetSize() == unSize && TouchPages( mappedFile.GetData(), unSize ) == ulExpectedPages );
+	}
+	VRTest_Report( ( "Path_MapFile, touch pages, " + sSize ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		std::vector< uint8_t > vecRead = Path_ReadBinaryFile( k_sBenchFile );
+		VRTEST_CHECK( vecRead.size() == unSize && SumBytes( &vecRead[ 0 ], unSize ) == ulExpectedSum );
+	}
+	VRTest_Report( ( "Path_ReadBinaryFile, read all, " + sSize ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CMappedFile mappedFile;
+		VRTEST_CHECK( Path_MapFile( k_sBenchFile, &mappedFile, k_EPathMapFileHint_Sequential | k_EPathMapFileHint_WillNeed ) );
+		VRTEST_CHECK( mappedFile.GetSize() == unSize && SumBytes( mappedFile.GetData(), unSize ) == ulExpectedSum );
+	}
+	VRTest_Report( ( "Path_MapFile sequential, read all, " + sSize ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	Path_UnlinkFile( k_sBenchFile );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+
+	BenchFileSize( 4 * 1024, VRTest_Scaled( 20000, flScale ) );
+	BenchFileSize( 1024 * 1024, VRTest_Scaled( 500, flScale ) );
+	BenchFileSize( (size_t)VRTest_Scaled( 256 * 1024 * 1024, flScale ), VRTest_Scaled( 5, flScale ) );
+
+	return VRTest_Result( "mapfilebench" );
+}
@@ -0,0 +1,234 @@
+//========= Copyright Valve Corporation ============//
+// Tests the allocation-free path helpers (Path_StripFilenameLength, Path_RemoveTrailingSlashLength,
+// Path_FixSlashesInPlace, Path_CompactInPlace and Path_JoinToBuffer), and the std::string
+// versions now built on them, against copies of the std::string versions they replaced.
+#include "vrtest.h"
+
+#include <vrcore/pathtools_public.h>
+
+#include <string.h>
+#include <random>
+
+// The std::string implementations as they were before the allocation-free versions were added
+namespace reference
+{
+
+std::string Path_StripFilename( const std::string & sPath, char slash )
+{
+	std::string::size_type n = sPath.find_last_of( slash );
+	if( n == std::string::npos )
+		return sPath;
+	else
+		return std::string( sPath.begin(), sPath.begin() + n );
+}
+
+std::string Path_FixSlashes( const std::string & sPath, char slash )
+{
+	std::string sFixed = sPath;
+	for( std::string::iterator i = sFixed.begin(); i != sFixed.end(); i++ )
+	{
+		if( *i == '/' || *i == '\\' )
+			*i = slash;
+	}
+
+	return sFixed;
+}
+
+std::string Path_Join( const std::string & first, const std::string & second, char slash )
+{
+	std::string::size_type nLen = first.length();
+	if( !nLen )
+		return second;
+	char last_char = first[first.length()-1];
+	if (last_char == '\\' || last_char == '/')
+	    nLen--;
+
+	return first.substr( 0, nLen ) + std::string( 1, slash ) + second;
+}
+
+std::string Path_RemoveTrailingSlash( const std::string & sRawPath, char slash )
+{
+	std::string sPath = sRawPath;
+	std::string::size_type nCurrent = sRawPath.length();
+	if ( nCurrent == 0 )
+		return sPath;
+
+	int nLastFound = -1;
+	nCurrent--;
+	while( nCurrent != 0 )
+	{
+		if ( sRawPath[ nCurrent ] == slash )
+		{
+			nLastFound = (int)nCurrent;
+			nCurrent--;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if ( nLastFound >= 0 )
+	{
+		sPath.erase( nLastFound, std::string::npos );
+	}
+
+	return sPath;
+}
+
+std::string Path_Compact( const std::string & sRawPath, char slash )
+{
+	std::string sPath = Path_FixSlashes( sRawPath, slash );
+	std::string sSlashString( 1, slash );
+
+	for( std::string::size_type i = 0; (i + 3) < sPath.length();  )
+	{
+		if( sPath[ i ] == slash && sPath[ i+1 ] == '.' && sPath[ i+2 ] == slash )
+		{
+			sPath.replace( i, 3, sSlashString );
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	if( sPath.length() > 2 )
+	{
+		std::string::size_type len = sPath.length();
+		if( sPath[ len-1 ] == '.'  && sPath[ len-2 ] == slash )
+		{
+			sPath.pop_back();
+		}
+	}
+
+	if( sPath.length() > 2 )
+	{
+		if( sPath[ 0 ] == '.'  && sPath[ 1 ] == slash )
+		{
+			sPath.replace( 0, 2, "" );
+		}
+	}
+
+	std::string::size_type i = 0;
+	while( i < sPath.length() )
+	{
+		if( i > 0 && sPath.length() - i >= 2
+			&& sPath[i] == '.'
+			&& sPath[i+1] == '.'
+			&& ( i + 2 == sPath.length() || sPath[ i+2 ] == slash )
+			&& sPath[ i-1 ] == slash )
+		{
+			if( i == 1 )
+				return "";
+
+			std::string::size_type iDirStart = i-2;
+			while( iDirStart > 0 && sPath[ iDirStart - 1 ] != slash )
+				--iDirStart;
+
+			sPath.replace( iDirStart, (i - iDirStart) + 3, "" );
+
+			i = 0;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	return sPath;
+}
+
+} // namespace reference
+
+// Paths made of short names, dots and both kinds of separator, which is where the helpers differ
+static std::string RandomPath( std::mt19937 &rng )
+{
+	static const char *k_rgpchElements[] = { "a", "bc", "dir", ".", "..", "...", "", "C:", ".a", "a." };
+	std::string sPath;
+	if ( rng() % 4 == 0 )
+		sPath += ( rng() % 2 ) ? "/" : "\\";
+	int nElements = rng() % 7;
+	for ( int i = 0; i < nElements; ++i )
+	{
+		if ( i )
+			sPath += ( rng() % 3 ) ? "/" : "\\";
+		sPath += k_rgpchElements[ rng() % ( sizeof( k_rgpchElements ) / sizeof( k_rgpchElements[ 0 ] ) ) ];
+	}
+	for ( int nTrailing = rng() % 4 == 0 ? rng() % 3 + 1 : 0; nTrailing > 0; --nTrailing )
+		sPath += ( rng() % 2 ) ? "/" : "\\";
+	return sPath;
+}
+
+static void TestAgainstReference( char slash, std::mt19937 &rng )
+{
+	for ( int nIteration = 0; nIteration < 50000; ++nIteration )
+	{
+		std::string sPath = RandomPath( rng );
+		std::string sOther = RandomPath( rng );
+
+		std::string sExpected = reference::Path_StripFilename( sPath, slash );
+		VRTEST_CHECK( Path_StripFilename( sPath, slash ) == sExpected );
+		VRTEST_CHECK( sPath.compare( 0, Path_StripFilenameLength( sPath.c_str(), sPath.length(), slash ), sExpected ) == 0 );
+
+		sExpected = reference::Path_RemoveTrailingSlash( sPath, slash );
+		VRTEST_CHECK( Path_RemoveTrailingSlash( sPath, slash ) == sExpected );
+		VRTEST_CHECK( sPath.compare( 0, Path_RemoveTrailingSlashLength( sPath.c_str(), sPath.length(), slash ), sExpected ) == 0 );
+
+		sExpected = reference::Path_FixSlashes( sPath, slash );
+		VRTEST_CHECK( Path_FixSlashes( sPath, slash ) == sExpected );
+		std::string sInPlace = sPath;
+		Path_FixSlashesInPlace( &sInPlace[ 0 ], sInPlace.length(), slash );
+		VRTEST_CHECK( sInPlace == sExpected );
+
+		sExpected = reference::Path_Compact( sPath, slash );
+		VRTEST_CHECK( Path_Compact( sPath, slash ) == sExpected );
+		sInPlace = sPath;
+		sInPlace.resize( Path_CompactInPlace( &sInPlace[ 0 ], sInPlace.length(), slash ) );
+		VRTEST_CHECK( sInPlace == sExpected );
+
+		sExpected = reference::Path_Join( sPath, sOther, slash );
+		VRTEST_CHECK( Path_Join( sPath, sOther, slash ) == sExpected );
+
+		// exactly big enough, too small by one, and built up in place on top of the first path
+		char rchBuffer[ 128 ];
+		size_t unLength = Path_JoinToBuffer( rchBuffer, sExpected.length() + 1, sPath.c_str(), sPath.length(),
+			sOther.c_str(), sOther.length(), slash );
+		VRTEST_CHECK( unLength == sExpected.length() );
+		VRTEST_CHECK( strcmp( rchBuffer, sExpected.c_str() ) == 0 );
+
+		memset( rchBuffer, 'x', sizeof( rchBuffer ) );
+		VRTEST_CHECK( Path_JoinToBuffer( rchBuffer, sExpected.length(), sPath.c_str(), sPath.length(),
+			sOther.c_str(), sOther.length(), slash ) == sExpected.length() );
+		VRTEST_CHECK( rchBuffer[ 0 ] == 'x' );
+
+		memcpy( rchBuffer, sPath.c_str(), sPath.length() + 1 );
+		unLength = Path_JoinToBuffer( rchBuffer, sizeof( rchBuffer ), rchBuffer, sPath.length(),
+			sOther.c_str(), sOther.length(), slash );
+		VRTEST_CHECK( unLength == sExpected.length() && strcmp( rchBuffer, sExpected.c_str() ) == 0 );
+	}
+}
+
+// The default separator is the platform's
+static void TestDefaultSlash()
+{
+	const char slash = Path_GetSlash();
+	std::string sPath = "a/b\\..\\c/./d/";
+	VRTEST_CHECK( Path_Compact( sPath ) == reference::Path_Compact( sPath, slash ) );
+	VRTEST_CHECK( Path_FixSlashes( sPath ) == reference::Path_FixSlashes( sPath, slash ) );
+	VRTEST_CHECK( Path_Join( "a/", "b" ) == reference::Path_Join( "a/", "b", slash ) );
+
+	char rchPath[] = "a\\b/c";
+	Path_FixSlashesInPlace( rchPath, strlen( rchPath ) );
+	VRTEST_CHECK( rchPath[ 1 ] == slash && rchPath[ 3 ] == slash );
+}
+
+int main()
+{
+	std::mt19937 rng( 1 );
+	TestAgainstReference( '/', rng );
+	TestAgainstReference( '\\', rng );
+	TestDefaultSlash();
+
+	return VRTest_Result( "pathbuffers_test" );
+}
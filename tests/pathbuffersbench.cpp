@@ -0,0 +1,100 @@
+//========= Copyright Valve Corporation ============//
+// Times the std::string path helpers against the allocation-free versions on the same work, and
+// counts the heap allocations each makes.
+#include "vrtest.h"
+
+#include <vrcore/pathtools_public.h>
+
+#include <string.h>
+#include <new>
+
+// Every allocation in the program goes through here, so the benchmark can count them
+static std::atomic< uint64_t > g_unAllocations( 0 );
+
+void *operator new( size_t unSize )
+{
+	++g_unAllocations;
+	void *pMemory = malloc( unSize ? unSize : 1 );
+	if ( !pMemory )
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void *operator new[]( size_t unSize )
+{
+	return operator new( unSize );
+}
+
+void operator delete( void *pMemory ) noexcept
+{
+	free( pMemory );
+}
+
+void operator delete[]( void *pMemory ) noexcept
+{
+	free( pMemory );
+}
+
+void operator delete( void *pMemory, size_t ) noexcept
+{
+	free( pMemory );
+}
+
+void operator delete[]( void *pMemory, size_t ) noexcept
+{
+	free( pMemory );
+}
+
+// A driver path the way it comes out of a manifest, before it is cleaned up. Long enough that
+// std::string can't keep it in its small string buffer.
+static const char k_pchRawPath[] = "C:\\Program Files (x86)\\Steam\\steamapps\\common\\SteamVR\\bin\\..\\drivers\\.\\lighthouse\\bin\\win64\\";
+static const char k_pchFilename[] = "driver_lighthouse.dll";
+
+static void ReportAllocations( const char *pchName, uint64_t unIterations, double flSeconds, uint64_t unAllocations )
+{
+	VRTest_Report( pchName, unIterations, flSeconds );
+	printf( "%-48s %10.2f allocations/op\n", "", (double)unAllocations / unIterations );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	uint64_t unIterations = VRTest_Scaled( 1000000, flScale );
+
+	const std::string sRawPath = k_pchRawPath;
+	const std::string sFilename = k_pchFilename;
+	std::string sExpected;
+	size_t unTotalLength = 0;
+
+	uint64_t unAllocationsBefore = g_unAllocations;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		std::string sPath = Path_RemoveTrailingSlash( Path_Compact( sRawPath, '/' ), '/' );
+		std::string sFull = Path_Join( sPath, sFilename, '/' );
+		unTotalLength += Path_StripFilename( sFull, '/' ).length();
+		if ( i == 0 )
+			sExpected = sFull;
+	}
+	ReportAllocations( "std::string helpers", unIterations, VRTest_Seconds() - flStart, g_unAllocations - unAllocationsBefore );
+
+	unAllocationsBefore = g_unAllocations;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		char rchPath[ 260 ];
+		size_t unLength = sizeof( k_pchRawPath ) - 1;
+		memcpy( rchPath, k_pchRawPath, unLength );
+		unLength = Path_CompactInPlace( rchPath, unLength, '/' );
+		unLength = Path_RemoveTrailingSlashLength( rchPath, unLength, '/' );
+		unLength = Path_JoinToBuffer( rchPath, sizeof( rchPath ), rchPath, unLength, k_pchFilename, sizeof( k_pchFilename ) - 1, '/' );
+		unTotalLength += Path_StripFilenameLength( rchPath, unLength, '/' );
+		if ( i == 0 )
+			VRTEST_CHECK( sExpected == rchPath );
+	}
+	ReportAllocations( "allocation-free helpers", unIterations, VRTest_Seconds() - flStart, g_unAllocations - unAllocationsBefore );
+
+	VRTEST_CHECK( unTotalLength == 2 * unIterations * Path_StripFilename( sExpected, '/' ).length() );
+
+	return VRTest_Result( "pathbuffersbench" );
+}
@@ -0,0 +1,153 @@
+//========= Copyright Valve Corporation ============//
+// Measures the path registry lookups the loader makes on every VR_Init and VR_IsRuntimeInstalled.
+// Pass a scale for the iteration counts as the first argument.
+#include "openvr.h"
+#include "vrtest.h"
+
+#include <vrcore/vrpathregistry_public.h>
+#include <vrcore/pathtools_public.h>
+
+static void BenchGetPaths( double flScale )
+{
+	uint64_t unIterations = VRTest_Scaled( 100000, flScale );
+	std::string sRuntimePath, sConfigPath, sLogPath;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, nullptr, nullptr ) );
+	}
+	VRTest_Report( "GetPaths (cached)", unIterations, VRTest_Seconds() - flStart );
+}
+
+// What GetPaths did before it cached the parsed registry: read and parse the file every call
+static void BenchGetPathsUncached( double flScale )
+{
+	uint64_t unIterations = VRTest_Scaled( 100000, flScale );
+	std::string sRuntimePath, sConfigPath, sLogPath;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CVRPathRegistry_Public pathReg;
+		VRTEST_CHECK( pathReg.BLoadFromFile() );
+		sRuntimePath = pathReg.GetRuntimePath();
+		sConfigPath = pathReg.GetConfigPath();
+		sLogPath = pathReg.GetLogPath();
+	}
+	VRTest_Report( "GetPaths (uncached)", unIterations, VRTest_Seconds() - flStart );
+}
+
+// What GetPaths cost before the environment snapshot: every override is read from the environment
+static void BenchGetPathsRereadingEnvironment( double flScale )
+{
+	uint64_t unIterations = VRTest_Scaled( 100000, flScale );
+	std::string sRuntimePath, sConfigPath, sLogPath;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		InvalidateEnvironmentVariableCache();
+		VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, nullptr, nullptr ) );
+	}
+	VRTest_Report( "GetPaths (environment reread)", unIterations, VRTest_Seconds() - flStart );
+}
+
+static void BenchEnvironmentVariable( double flScale, const char *pchVarName, bool bCached )
+{
+	uint64_t unIterations = VRTest_Scaled( 1000000, flScale );
+	size_t unLength = 0;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		if ( bCached )
+		{
+			const char *pchValue = GetEnvironmentVariableCached( pchVarName );
+			unLength += pchValue ? 1 : 0;
+		}
+		else
+		{
+			unLength += GetEnvironmentVariable( pchVarName ).empty() ? 0 : 1;
+		}
+	}
+	std::string sName = std::string( bCached ? "GetEnvironmentVariableCached( " : "GetEnvironmentVariable( " ) + pchVarName + " )";
+	VRTest_Report( sName.c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unLength == 0 || unLength == unIterations );
+}
+
+// A registry with 10k external drivers, one in ten listed twice, the way long lived installs end up
+static void BenchExternalDrivers( double flScale )
+{
+	const uint32_t k_unDriverCount = 10000;
+	std::string sRegistryFile = std::string( STUB_VRPATH_FILE ) + ".drivers";
+	std::string sContents = "{\n\t\"external_drivers\" : [\n";
+	for ( uint32_t i = 0; i < k_unDriverCount + k_unDriverCount / 10; ++i )
+	{
+		sContents += "\t\t\"/vrtest/drivers/driver" + std::to_string( i % k_unDriverCount ) + "\",\n";
+	}
+	sContents += "\t\t\"/vrtest/drivers/last\"\n\t],\n\t\"jsonid\" : \"vrpathreg\",\n\t\"runtime\" : [ \"/vrtest/runtime\" ],\n\t\"version\" : 1\n}\n";
+	VRTEST_CHECK( Path_WriteStringToTextFile( sRegistryFile, sContents.c_str() ) );
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", sRegistryFile.c_str() );
+
+	uint64_t unIterations = VRTest_Scaled( 100, flScale );
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		CVRPathRegistry_Public pathReg;
+		VRTEST_CHECK( pathReg.BLoadFromFile() );
+	}
+	VRTest_Report( "BLoadFromFile, 10k drivers", unIterations, VRTest_Seconds() - flStart );
+
+	CVRPathRegistry_Public pathReg;
+	VRTEST_CHECK( pathReg.BLoadFromFile() );
+	unIterations = VRTest_Scaled( 1000000, flScale );
+	std::vector< std::string > vecLookups;
+	for ( uint32_t i = 0; i < 1024; ++i )
+	{
+		vecLookups.push_back( "/vrtest/drivers/driver" + std::to_string( i * 17 ) );
+	}
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( pathReg.HasExternalDriver( vecLookups[ i % vecLookups.size() ] ) == ( ( i % vecLookups.size() ) * 17 < k_unDriverCount ) );
+	}
+	VRTest_Report( "HasExternalDriver, 10k drivers", unIterations, VRTest_Seconds() - flStart );
+
+	unIterations = VRTest_Scaled( 1000, flScale );
+	std::vector< std::string > vecDrivers;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( CVRPathRegistry_Public::GetPaths( nullptr, nullptr, nullptr, nullptr, nullptr, &vecDrivers ) );
+	}
+	VRTest_Report( "GetPaths with driver list, 10k drivers", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( vecDrivers.size() == k_unDriverCount + 1 );
+
+	unIterations = VRTest_Scaled( 100, flScale );
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		VRTEST_CHECK( CVRPathRegistry_Public::AddExternalDriver( "/vrtest/drivers/new" ) );
+		VRTEST_CHECK( CVRPathRegistry_Public::RemoveExternalDriver( "/vrtest/drivers/new" ) );
+	}
+	VRTest_Report( "AddExternalDriver + RemoveExternalDriver, 10k", unIterations, VRTest_Seconds() - flStart );
+
+	Path_UnlinkFile( sRegistryFile );
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", STUB_VRPATH_FILE );
+}
+
+int main( int argc, char **argv )
+{
+	VRTest_UseStubRuntime();
+	double flScale = VRTest_BenchScale( argc, argv );
+
+	BenchGetPaths( flScale );
+	BenchGetPathsRereadingEnvironment( flScale );
+	BenchGetPathsUncached( flScale );
+
+	// VR_PATHREG_OVERRIDE is set and long enough to need an allocation; VR_OVERRIDE isn't set
+	BenchEnvironmentVariable( flScale, "VR_PATHREG_OVERRIDE", false );
+	BenchEnvironmentVariable( flScale, "VR_PATHREG_OVERRIDE", true );
+	BenchEnvironmentVariable( flScale, k_pchRuntimeOverrideVar, false );
+	BenchEnvironmentVariable( flScale, k_pchRuntimeOverrideVar, true );
+	BenchExternalDrivers( flScale );
+
+	return VRTest_Result( "pathregistrybench" );
+}
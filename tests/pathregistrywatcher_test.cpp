@@ -0,0 +1,156 @@
+//========= Copyright Valve Corporation ============//
+// Tests CVRPathRegistryWatcher_Public by rewriting a registry in a scratch directory and checking
+// that exactly one reload is published per change.
+#include "vrtest.h"
+
+#include <vrcore/vrpathregistry_public.h>
+#include <vrcore/pathtools_public.h>
+#include <vrcore/dirtools_public.h>
+
+#include <thread>
+
+#if defined( _WIN32 )
+#include <direct.h>
+#define rmdir _rmdir
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const std::string k_sScratchDir = Path_Join( Path_StripFilename( STUB_VRPATH_FILE ), "watcherscratch" );
+static const std::string k_sRegistryDir = Path_Join( k_sScratchDir, "config", "openvr" );
+static const std::string k_sRegistryFile = Path_Join( k_sRegistryDir, "openvrpaths.vrpath" );
+
+static std::string RegistryContents( const char *pchRuntimePath )
+{
+	return std::string( "{ \"jsonid\" : \"vrpathreg\", \"version\" : 1, \"runtime\" : [ \"" ) + pchRuntimePath + "\" ] }\n";
+}
+
+// Waits until the watcher has published unReloads snapshots, then a little longer to catch extras
+static bool BWaitForReloads( const CVRPathRegistryWatcher_Public & watcher, uint32_t unReloads )
+{
+	double flGiveUp = VRTest_Seconds() + 5.0;
+	while ( watcher.GetReloadCount() < unReloads && VRTest_Seconds() < flGiveUp )
+	{
+		std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+	}
+	std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+	if ( watcher.GetReloadCount() != unReloads )
+	{
+		fprintf( stderr, "expected %u reloads, got %u\n", unReloads, watcher.GetReloadCount() );
+		return false;
+	}
+	return true;
+}
+
+static std::string CurrentRuntimePath( const CVRPathRegistryWatcher_Public & watcher )
+{
+	std::shared_ptr< const VRPathRegistrySnapshot_t > pSnapshot = watcher.GetSnapshot();
+	return pSnapshot && pSnapshot->bLoaded ? pSnapshot->sRuntimePath : "";
+}
+
+static void RemoveScratchDir()
+{
+	Path_UnlinkFile( k_sRegistryFile );
+	rmdir( k_sRegistryDir.c_str() );
+	rmdir( Path_StripFilename( k_sRegistryDir ).c_str() );
+	rmdir( k_sScratchDir.c_str() );
+}
+
+static void TestReloads()
+{
+	RemoveScratchDir();
+	BCreateDirectoryRecursive( k_sScratchDir.c_str() );
+
+	// the registry directory doesn't exist yet
+	CVRPathRegistryWatcher_Public watcher;
+	std::atomic<uint32_t> unCallbacks( 0 );
+	watcher.Subscribe( [&unCallbacks]( const std::shared_ptr< const VRPathRegistrySnapshot_t > & ) { unCallbacks++; } );
+	VRTEST_CHECK( watcher.BStart() );
+	VRTEST_CHECK( !watcher.GetSnapshot()->bLoaded );
+
+	BCreateDirectoryRecursive( k_sRegistryDir.c_str() );
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/runtime1" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 1 ) );
+	VRTEST_CHECK( CurrentRuntimePath( watcher ) == "/vrtest/runtime1" );
+
+#if defined( POSIX )
+	// the same size, the same inode and the same modification time, as a rewrite within one tick
+	// of a coarse filesystem clock would be
+	struct stat statBefore;
+	VRTEST_CHECK( stat( k_sRegistryFile.c_str(), &statBefore ) == 0 );
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/runtime2" ).c_str() ) );
+	struct timespec rTimes[2] = { statBefore.st_atim, statBefore.st_mtim };
+	VRTEST_CHECK( utimensat( AT_FDCWD, k_sRegistryFile.c_str(), rTimes, 0 ) == 0 );
+	VRTEST_CHECK( BWaitForReloads( watcher, 2 ) );
+	VRTEST_CHECK( CurrentRuntimePath( watcher ) == "/vrtest/runtime2" );
+#else
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/runtime2" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 2 ) );
+#endif
+
+	// atomic replacement
+	VRTEST_CHECK( Path_WriteStringToTextFileAtomic( k_sRegistryFile, RegistryContents( "/vrtest/runtime3" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 3 ) );
+	VRTEST_CHECK( CurrentRuntimePath( watcher ) == "/vrtest/runtime3" );
+
+	// writing what is already there isn't a change
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/runtime3" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 3 ) );
+
+	VRTEST_CHECK( Path_UnlinkFile( k_sRegistryFile ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 4 ) );
+	VRTEST_CHECK( !watcher.GetSnapshot()->bLoaded );
+
+	// deleting the directory moves the watch up, and recreating it moves it back
+	rmdir( k_sRegistryDir.c_str() );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+	BCreateDirectoryRecursive( k_sRegistryDir.c_str() );
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/runtime5" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 5 ) );
+	VRTEST_CHECK( CurrentRuntimePath( watcher ) == "/vrtest/runtime5" );
+
+	VRTEST_CHECK( unCallbacks == watcher.GetReloadCount() );
+	watcher.Stop();
+}
+
+static void TestStopFromCallback()
+{
+	CVRPathRegistryWatcher_Public watcher;
+	std::atomic<bool> bStopped( false );
+	watcher.Subscribe( [&watcher, &bStopped]( const std::shared_ptr< const VRPathRegistrySnapshot_t > & )
+	{
+		watcher.Stop();
+		bStopped = true;
+	} );
+	VRTEST_CHECK( watcher.BStart() );
+
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/stop1" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 1 ) );
+	VRTEST_CHECK( bStopped );
+
+	// stopped, so this isn't seen
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/stop2" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 1 ) );
+
+	// restarting picks up the current file and watches again
+	bStopped = false;
+	VRTEST_CHECK( watcher.BStart() );
+	VRTEST_CHECK( CurrentRuntimePath( watcher ) == "/vrtest/stop2" );
+	VRTEST_CHECK( Path_WriteStringToTextFile( k_sRegistryFile, RegistryContents( "/vrtest/stop3" ).c_str() ) );
+	VRTEST_CHECK( BWaitForReloads( watcher, 1 ) );
+	VRTEST_CHECK( bStopped );
+}
+
+int main()
+{
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", k_sRegistryFile.c_str() );
+
+	TestReloads();
+	TestStopFromCallback();
+	RemoveScratchDir();
+
+	return VRTest_Result( "pathregistrywatcher_test" );
+}
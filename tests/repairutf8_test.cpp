@@ -0,0 +1,184 @@
+//========= Copyright Valve Corporation ============//
+// Tests RepairUTF8, RepairUTF8InPlace and IsValidUTF8 against the codecvt based RepairUTF8 they
+// replaced. The output and the return value must match exactly for any input, and valid input must
+// be left where it is by the in place version.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <codecvt>
+#include <locale>
+#include <random>
+
+// RepairUTF8 as it was before it looked for the valid prefix first
+namespace reference
+{
+
+bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	typedef std::codecvt_utf8<char32_t> facet_type;
+	facet_type myfacet;
+
+	std::mbstate_t mystate = std::mbstate_t();
+
+	sOutputUtf8.clear();
+	sOutputUtf8.reserve( pend - pbegin );
+	bool bSqueakyClean = true;
+
+	const char *pmid = pbegin;
+	while ( pmid != pend )
+	{
+		bool bHasError = false;
+		bool bHasValidData = false;
+
+		char32_t out = 0xdeadbeef, *pout;
+		pbegin = pmid;
+		switch ( myfacet.in( mystate, pbegin, pend, pmid, &out, &out + 1, pout ) )
+		{
+		case facet_type::ok:
+			bHasValidData = true;
+			break;
+
+		case facet_type::noconv:
+			// unexpected! always converting type
+			bSqueakyClean = false;
+			break;
+
+		case facet_type::partial:
+			bHasError = pbegin == pmid;
+			if ( bHasError )
+			{
+				bSqueakyClean = false;
+			}
+			else
+			{
+				bHasValidData = true;
+			}
+			break;
+
+		case facet_type::error:
+			bHasError = true;
+			bSqueakyClean = false;
+			break;
+		}
+
+		if ( bHasValidData )
+		{
+			// could convert back, but no need
+			for ( const char *p = pbegin; p != pmid; ++p )
+			{
+				sOutputUtf8 += *p;
+			}
+		}
+
+		if ( bHasError )
+		{
+			sOutputUtf8 += '?';
+		}
+
+		if ( pmid == pbegin )
+		{
+			pmid++;
+		}
+	}
+
+	return bSqueakyClean;
+}
+
+} // namespace reference
+
+static bool BIsEncodedSurrogate( const std::string & s )
+{
+	for ( size_t i = 0; i + 1 < s.length(); ++i )
+	{
+		if ( ( uint8_t )s[ i ] == 0xED && ( uint8_t )s[ i + 1 ] >= 0xA0 && ( uint8_t )s[ i + 1 ] <= 0xBF )
+			return true;
+	}
+	return false;
+}
+
+static void CheckRepair( const std::string & sIn )
+{
+	std::string sExpected;
+	bool bExpectedClean = reference::RepairUTF8( sIn.data(), sIn.data() + sIn.size(), sExpected );
+
+	std::string sRepaired = "leftovers";
+	bool bClean = RepairUTF8( sIn, sRepaired );
+
+	std::string sInPlace = sIn;
+	const char *pchBefore = sInPlace.data();
+	bool bInPlaceClean = RepairUTF8InPlace( sInPlace );
+
+	// The old repair let surrogates through as if they were valid, and so does the new one, but
+	// IsValidUTF8 is strict about them
+	bool bValid = IsValidUTF8( sIn.data(), sIn.data() + sIn.size() );
+	bool bExpectedValid = bExpectedClean && !BIsEncodedSurrogate( sIn );
+
+	if ( sRepaired != sExpected || bClean != bExpectedClean || sInPlace != sExpected || bInPlaceClean != bExpectedClean
+		|| bValid != bExpectedValid )
+	{
+		fprintf( stderr, "RepairUTF8 disagrees on:" );
+		for ( char ch : sIn )
+			fprintf( stderr, " %02x", ( uint8_t )ch );
+		fprintf( stderr, "\n" );
+		VRTEST_CHECK( false );
+	}
+
+	// valid input is left where it was
+	if ( bValid )
+		VRTEST_CHECK( sInPlace.data() == pchBefore );
+}
+
+// Random bytes biased towards the ones that matter to a decoder, with ASCII runs long enough for
+// the 16 byte fast path
+static void TestFuzzAgainstReference()
+{
+	static const uint8_t k_rgBytes[] = { 'a', 'z', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF,
+		0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF };
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < 300000; ++nIteration )
+	{
+		std::string sIn;
+		for ( int nBytes = rng() % 24; nBytes > 0; --nBytes )
+			sIn.push_back( ( char )k_rgBytes[ rng() % sizeof( k_rgBytes ) ] );
+		if ( rng() % 2 == 0 )
+			sIn.insert( rng() % ( sIn.length() + 1 ), std::string( rng() % 40, 'x' ) );
+		CheckRepair( sIn );
+	}
+}
+
+// Valid sequences of every length, each broken in every way at every position around the 16 byte block
+static void TestSequencesAtEveryPosition()
+{
+	static const char *k_rgpchSequences[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+		"\xF4\x8F\xBF\xBF", "\xED\xA0\x80", "\xC0\x80", "\xE0\x80\x80", "\xF4\x90\x80\x80", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xFF" };
+	for ( const char *pchSequence : k_rgpchSequences )
+	{
+		for ( size_t unPosition = 0; unPosition <= 34; ++unPosition )
+		{
+			std::string sIn( 34, 'x' );
+			sIn.insert( unPosition, pchSequence );
+			CheckRepair( sIn );
+			CheckRepair( sIn.substr( 0, unPosition + strlen( pchSequence ) ) );
+		}
+	}
+	CheckRepair( "" );
+}
+
+static void TestSurrogates()
+{
+	std::string sIn = "a\xED\xA0\x80" "b";
+	std::string sRepaired;
+	VRTEST_CHECK( RepairUTF8( sIn, sRepaired ) && sRepaired == sIn );
+	VRTEST_CHECK( RepairUTF8InPlace( sIn ) && sIn == "a\xED\xA0\x80" "b" );
+	VRTEST_CHECK( !IsValidUTF8( sIn.data(), sIn.data() + sIn.size() ) );
+}
+
+int main()
+{
+	TestFuzzAgainstReference();
+	TestSequencesAtEveryPosition();
+	TestSurrogates();
+
+	return VRTest_Result( "repairutf8_test" );
+}
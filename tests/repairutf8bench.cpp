@@ -0,0 +1,146 @@
+//========= Copyright Valve Corporation ============//
+// Times RepairUTF8, RepairUTF8InPlace and IsValidUTF8 against the codecvt based RepairUTF8 they
+// replaced, on 4 KB of ASCII, of text mixing ASCII and CJK, and on two adversarial inputs: valid
+// text with one bad byte near the start, and text where every few bytes are invalid.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <codecvt>
+#include <locale>
+
+// RepairUTF8 as it was before it looked for the valid prefix first
+static bool ReferenceRepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	typedef std::codecvt_utf8<char32_t> facet_type;
+	facet_type myfacet;
+
+	std::mbstate_t mystate = std::mbstate_t();
+
+	sOutputUtf8.clear();
+	sOutputUtf8.reserve( pend - pbegin );
+	bool bSqueakyClean = true;
+
+	const char *pmid = pbegin;
+	while ( pmid != pend )
+	{
+		bool bHasError = false;
+		bool bHasValidData = false;
+
+		char32_t out = 0xdeadbeef, *pout;
+		pbegin = pmid;
+		switch ( myfacet.in( mystate, pbegin, pend, pmid, &out, &out + 1, pout ) )
+		{
+		case facet_type::ok:
+			bHasValidData = true;
+			break;
+
+		case facet_type::noconv:
+			bSqueakyClean = false;
+			break;
+
+		case facet_type::partial:
+			bHasError = pbegin == pmid;
+			if ( bHasError )
+				bSqueakyClean = false;
+			else
+				bHasValidData = true;
+			break;
+
+		case facet_type::error:
+			bHasError = true;
+			bSqueakyClean = false;
+			break;
+		}
+
+		if ( bHasValidData )
+		{
+			for ( const char *p = pbegin; p != pmid; ++p )
+				sOutputUtf8 += *p;
+		}
+
+		if ( bHasError )
+			sOutputUtf8 += '?';
+
+		if ( pmid == pbegin )
+			pmid++;
+	}
+
+	return bSqueakyClean;
+}
+
+static std::string RepeatTo( const char *pchUnit, size_t unLength )
+{
+	std::string s;
+	while ( s.length() < unLength )
+		s += pchUnit;
+	return s;
+}
+
+static void BenchText( const char *pchName, const std::string & sText, uint64_t unIterations )
+{
+	std::string sExpected;
+	const bool bExpectedClean = ReferenceRepairUTF8( sText.data(), sText.data() + sText.size(), sExpected );
+	std::string sName = pchName;
+
+	std::string sRepaired;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( ReferenceRepairUTF8( sText.data(), sText.data() + sText.size(), sRepaired ) == bExpectedClean );
+	VRTest_Report( ( "codecvt RepairUTF8, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		VRTEST_CHECK( RepairUTF8( sText, sRepaired ) == bExpectedClean );
+	VRTest_Report( ( "RepairUTF8, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( sRepaired == sExpected );
+
+	// a fresh copy each time, since a repair only happens once; the copy is timed on its own below
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		std::string sInPlace = sText;
+		VRTEST_CHECK( RepairUTF8InPlace( sInPlace ) == bExpectedClean );
+	}
+	VRTest_Report( ( "copy + RepairUTF8InPlace, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	size_t unTotal = 0;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		std::string sCopy = sText;
+		unTotal += sCopy.length();
+	}
+	VRTest_Report( ( "copy only, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == unIterations * sText.length() );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += IsValidUTF8( sText.data(), sText.data() + sText.size() ) ? 1 : 0;
+	VRTest_Report( ( "IsValidUTF8, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == unIterations * ( sText.length() + ( bExpectedClean ? 1 : 0 ) ) );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 20000, flScale );
+	const size_t k_unTextLength = 4096;
+
+	const std::string sAscii = RepeatTo( "/settings/steamvr/mirrorViewGeometry = \"0 0 1080 600\";\n", k_unTextLength );
+	const std::string sCJK = RepeatTo( "driver \xE8\xA8\xAD\xE5\xAE\x9A\xE3\x82\x92\xE9\x96\x8B\xE3\x81\x8F lighthouse ", k_unTextLength );
+
+	// one stray Latin-1 byte early on sends the rest down the slow path
+	std::string sBadEarly = sCJK;
+	sBadEarly[ 32 ] = ( char )0xE9;
+
+	// a truncated sequence every 8 bytes
+	const std::string sBadEverywhere = RepeatTo( "abcd\xE8\xA8" "ef", k_unTextLength );
+
+	BenchText( "ASCII", sAscii, unIterations );
+	BenchText( "mixed CJK", sCJK, unIterations );
+	BenchText( "one bad byte early", sBadEarly, unIterations );
+	BenchText( "bad every 8 bytes", sBadEverywhere, unIterations );
+
+	return VRTest_Result( "repairutf8bench" );
+}
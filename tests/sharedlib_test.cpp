@@ -0,0 +1,105 @@
+//========= Copyright Valve Corporation ============//
+// Tests SharedLib_GetFunctions and the binding modes of SharedLib_Load against the libraries
+// built from sharedlibtest/sharedlibtest.cpp.
+#include "vrtest.h"
+
+#include <string.h>
+
+typedef int ( *SharedLibTestBinaryFn )( int a, int b );
+
+static SharedLibTestBinaryFn s_pfnAdd;
+static SharedLibTestBinaryFn s_pfnMultiply;
+static SharedLibTestBinaryFn s_pfnMissing;
+
+static void TestGetFunctions()
+{
+	std::string sError;
+	SharedLibHandle lib = SharedLib_Load( SHAREDLIBTEST_PATH, &sError );
+	VRTEST_CHECK( lib != nullptr );
+	if ( !lib )
+	{
+		fprintf( stderr, "%s\n", sError.c_str() );
+		return;
+	}
+
+	static const SharedLibSymbol_t k_rgSymbols[] =
+	{
+		SharedLibSymbol( "SharedLibTest_Add", &s_pfnAdd ),
+		SharedLibSymbol( "SharedLibTest_Multiply", &s_pfnMultiply ),
+		SharedLibSymbol( "SharedLibTest_Missing", &s_pfnMissing, true ),
+	};
+	const size_t k_unSymbolCount = sizeof( k_rgSymbols ) / sizeof( k_rgSymbols[0] );
+
+	sError = "stale";
+	VRTEST_CHECK( SharedLib_GetFunctions( lib, k_rgSymbols, k_unSymbolCount, &sError ) );
+	VRTEST_CHECK( sError.empty() );
+	VRTEST_CHECK( s_pfnAdd && s_pfnAdd( 2, 3 ) == 5 );
+	VRTEST_CHECK( s_pfnMultiply && s_pfnMultiply( 2, 3 ) == 6 );
+	VRTEST_CHECK( s_pfnMissing == nullptr );
+
+	// again from the cache
+	s_pfnAdd = s_pfnMultiply = nullptr;
+	VRTEST_CHECK( SharedLib_GetFunctions( lib, k_rgSymbols, k_unSymbolCount, &sError ) );
+	VRTEST_CHECK( s_pfnAdd && s_pfnAdd( 2, 3 ) == 5 );
+	VRTEST_CHECK( s_pfnMultiply && s_pfnMultiply( 2, 3 ) == 6 );
+
+	// a required symbol that is missing fails the batch and is named in the error
+	SharedLibSymbol_t rgRequired[] =
+	{
+		SharedLibSymbol( "SharedLibTest_Add", &s_pfnAdd ),
+		SharedLibSymbol( "SharedLibTest_Missing", &s_pfnMissing, true ),
+	};
+	VRTEST_CHECK( SharedLib_GetFunctions( lib, rgRequired, 2, &sError ) );
+	rgRequired[1].bOptional = false;
+	VRTEST_CHECK( !SharedLib_GetFunctions( lib, rgRequired, 2, &sError ) );
+	VRTEST_CHECK( sError.find( "SharedLibTest_Missing" ) != std::string::npos );
+	VRTEST_CHECK( sError.find( "SharedLibTest_Add" ) == std::string::npos );
+	VRTEST_CHECK( s_pfnAdd != nullptr );
+	rgRequired[1].bOptional = true;
+	VRTEST_CHECK( SharedLib_GetFunctions( lib, rgRequired, 2, &sError ) );
+	VRTEST_CHECK( sError.empty() );
+
+	// tables on the stack come and go; every one must still resolve correctly
+	for ( int i = 0; i < 1000; i++ )
+	{
+		SharedLibTestBinaryFn pfnFunction = nullptr;
+		SharedLibSymbol_t rgStackSymbols[] = { SharedLibSymbol( i % 2 ? "SharedLibTest_Add" : "SharedLibTest_Multiply", &pfnFunction ) };
+		VRTEST_CHECK( SharedLib_GetFunctions( lib, rgStackSymbols, 1 ) );
+		VRTEST_CHECK( pfnFunction && pfnFunction( 4, 4 ) == ( i % 2 ? 8 : 16 ) );
+	}
+
+	// unloading forgets the cached results, and a new load resolves them again
+	SharedLib_Unload( lib );
+	lib = SharedLib_Load( SHAREDLIBTEST_PATH );
+	s_pfnAdd = nullptr;
+	VRTEST_CHECK( SharedLib_GetFunctions( lib, k_rgSymbols, k_unSymbolCount ) );
+	VRTEST_CHECK( s_pfnAdd && s_pfnAdd( 20, 22 ) == 42 );
+	SharedLib_Unload( lib );
+}
+
+#if defined( SHAREDLIBTEST_UNRESOLVED_PATH )
+static void TestBinding()
+{
+	std::string sError;
+	SharedLibHandle lib = SharedLib_Load( SHAREDLIBTEST_UNRESOLVED_PATH, &sError, k_ESharedLibBinding_Now );
+	VRTEST_CHECK( lib == nullptr );
+	VRTEST_CHECK( sError.find( "SharedLibTest_Undefined" ) != std::string::npos );
+	SharedLib_Unload( lib );
+
+	lib = SharedLib_Load( SHAREDLIBTEST_UNRESOLVED_PATH, &sError, k_ESharedLibBinding_Lazy );
+	VRTEST_CHECK( lib != nullptr );
+	SharedLibTestBinaryFn pfnAdd = ( SharedLibTestBinaryFn )SharedLib_GetFunction( lib, "SharedLibTest_Add" );
+	VRTEST_CHECK( pfnAdd && pfnAdd( 1, 1 ) == 2 );
+	SharedLib_Unload( lib );
+}
+#endif
+
+int main()
+{
+	TestGetFunctions();
+#if defined( SHAREDLIBTEST_UNRESOLVED_PATH )
+	TestBinding();
+#endif
+
+	return VRTest_Result( "sharedlib_test" );
+}
@@ -0,0 +1,37 @@
+//========= Copyright Valve Corporation ============//
+// One of the generated libraries for loadmultiplebench. Each copy is built with its own
+// LOADBENCHLIB_ID and exports a few thousand functions that call each other through the PLT,
+// so that loading it has a realistic amount of symbol binding and relocation to do.
+
+#if defined( _WIN32 )
+#define LOADBENCHLIB_EXPORT extern "C" __declspec( dllexport )
+#else
+#define LOADBENCHLIB_EXPORT extern "C" __attribute__( ( visibility( "default" ) ) )
+#endif
+
+#define LOADBENCHLIB_CONCAT2( a, b ) a##b
+#define LOADBENCHLIB_CONCAT( a, b ) LOADBENCHLIB_CONCAT2( a, b )
+
+#define LOADBENCHLIB_REP4( m, n ) m( n##0 ) m( n##1 ) m( n##2 ) m( n##3 )
+#define LOADBENCHLIB_REP16( m, n ) LOADBENCHLIB_REP4( m, n##0 ) LOADBENCHLIB_REP4( m, n##1 ) LOADBENCHLIB_REP4( m, n##2 ) LOADBENCHLIB_REP4( m, n##3 )
+#define LOADBENCHLIB_REP64( m, n ) LOADBENCHLIB_REP16( m, n##0 ) LOADBENCHLIB_REP16( m, n##1 ) LOADBENCHLIB_REP16( m, n##2 ) LOADBENCHLIB_REP16( m, n##3 )
+#define LOADBENCHLIB_REP256( m, n ) LOADBENCHLIB_REP64( m, n##0 ) LOADBENCHLIB_REP64( m, n##1 ) LOADBENCHLIB_REP64( m, n##2 ) LOADBENCHLIB_REP64( m, n##3 )
+#define LOADBENCHLIB_REP1024( m ) LOADBENCHLIB_REP256( m, 0 ) LOADBENCHLIB_REP256( m, 1 ) LOADBENCHLIB_REP256( m, 2 ) LOADBENCHLIB_REP256( m, 3 )
+
+// n is a string of base 4 digits with a leading 0, which C++ reads as octal; it only has to be unique
+#define LOADBENCHLIB_DEFINE( n ) LOADBENCHLIB_EXPORT int LOADBENCHLIB_CONCAT( LoadBenchLib_Function, n )() { return n + LOADBENCHLIB_ID; }
+#define LOADBENCHLIB_CALL( n ) nSum += LOADBENCHLIB_CONCAT( LoadBenchLib_Function, n )();
+
+LOADBENCHLIB_REP1024( LOADBENCHLIB_DEFINE )
+
+LOADBENCHLIB_EXPORT int LoadBenchLib_Sum()
+{
+	int nSum = 0;
+	LOADBENCHLIB_REP1024( LOADBENCHLIB_CALL )
+	return nSum;
+}
+
+LOADBENCHLIB_EXPORT int LoadBenchLib_Id()
+{
+	return LOADBENCHLIB_ID;
+}
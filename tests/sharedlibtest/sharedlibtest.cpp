@@ -0,0 +1,30 @@
+//========= Copyright Valve Corporation ============//
+// A small library for sharedlib_test to load and resolve symbols from. Built a second time with
+// SHAREDLIBTEST_UNRESOLVED, which leaves one of its own imports undefined so that only lazy
+// binding can load it.
+
+#if defined( _WIN32 )
+#define SHAREDLIBTEST_EXPORT extern "C" __declspec( dllexport )
+#else
+#define SHAREDLIBTEST_EXPORT extern "C" __attribute__( ( visibility( "default" ) ) )
+#endif
+
+SHAREDLIBTEST_EXPORT int SharedLibTest_Add( int a, int b )
+{
+	return a + b;
+}
+
+SHAREDLIBTEST_EXPORT int SharedLibTest_Multiply( int a, int b )
+{
+	return a * b;
+}
+
+#if defined( SHAREDLIBTEST_UNRESOLVED )
+// not defined anywhere
+extern "C" int SharedLibTest_Undefined();
+
+SHAREDLIBTEST_EXPORT int SharedLibTest_CallUndefined()
+{
+	return SharedLibTest_Undefined();
+}
+#endif
@@ -0,0 +1,108 @@
+//========= Copyright Valve Corporation ============//
+// Tests StringToUpper and StringToLower against the per-character toupper/tolower versions they
+// replaced, at every length from 0 to 33 so that the 16 byte SSE2 blocks, the tail after them and
+// the fallback for blocks holding bytes >= 0x80 are all exercised. Run in the C and C.UTF-8 locales
+// where they exist.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <ctype.h>
+#include <locale.h>
+#include <random>
+
+namespace reference
+{
+
+std::string StringToUpper( const std::string & sString )
+{
+	std::string sOut;
+	sOut.reserve( sString.size() + 1 );
+	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
+	{
+		sOut.push_back( (char)toupper( *i ) );
+	}
+
+	return sOut;
+}
+
+std::string StringToLower( const std::string & sString )
+{
+	std::string sOut;
+	sOut.reserve( sString.size() + 1 );
+	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
+	{
+		sOut.push_back( (char)tolower( *i ) );
+	}
+
+	return sOut;
+}
+
+} // namespace reference
+
+static void CheckCase( const std::string & s )
+{
+	if ( StringToUpper( s ) != reference::StringToUpper( s ) || StringToLower( s ) != reference::StringToLower( s ) )
+	{
+		fprintf( stderr, "case change disagrees on:" );
+		for ( char ch : s )
+			fprintf( stderr, " %02x", ( uint8_t )ch );
+		fprintf( stderr, "\n" );
+		VRTEST_CHECK( false );
+	}
+}
+
+// Every byte value at every position of strings of each length, in an otherwise all ASCII string,
+// so that one block at a time falls back
+static void TestEveryByteAtEveryPosition()
+{
+	for ( size_t unLength = 0; unLength <= 33; ++unLength )
+	{
+		std::string s;
+		for ( size_t i = 0; i < unLength; ++i )
+			s.push_back( "aZ@[`{09_."[ i % 10 ] );
+		CheckCase( s );
+
+		for ( size_t unPosition = 0; unPosition < unLength; ++unPosition )
+		{
+			for ( int nByte = 0; nByte < 256; ++nByte )
+			{
+				std::string sWith = s;
+				sWith[ unPosition ] = ( char )nByte;
+				CheckCase( sWith );
+			}
+		}
+	}
+}
+
+// Random strings of every length up to 33, biased towards the bytes either side of the letter
+// ranges and towards high bytes
+static void TestFuzz()
+{
+	static const uint8_t k_rgBytes[] = { 'a', 'z', 'A', 'Z', '@', '[', '`', '{', '0', '_', 0x00, 0x7F, 0x80, 0xC0, 0xE0, 0xFF };
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < 100000; ++nIteration )
+	{
+		std::string s;
+		for ( size_t unLength = rng() % 34; unLength > 0; --unLength )
+			s.push_back( ( char )k_rgBytes[ rng() % sizeof( k_rgBytes ) ] );
+		CheckCase( s );
+	}
+}
+
+int main()
+{
+	for ( const char *pchLocale : { "C", "C.UTF-8" } )
+	{
+		if ( !setlocale( LC_CTYPE, pchLocale ) )
+			continue;
+		TestEveryByteAtEveryPosition();
+		TestFuzz();
+	}
+	setlocale( LC_CTYPE, "C" );
+
+	VRTEST_CHECK( StringToUpper( "/devices/htc/vr_tracker_vive_3_0" ) == "/DEVICES/HTC/VR_TRACKER_VIVE_3_0" );
+	VRTEST_CHECK( StringToLower( "{Lighthouse}VR_Controller_Vive_1_5" ) == "{lighthouse}vr_controller_vive_1_5" );
+
+	return VRTest_Result( "stringcase_test" );
+}
@@ -0,0 +1,103 @@
+//========= Copyright Valve Corporation ============//
+// Times StringToLower, StringToUpper and StringHasSuffix against the versions they replaced on
+// render model and device identifiers of the lengths they come in, from a short driver name to a
+// full input profile path.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <ctype.h>
+
+static std::string ReferenceStringToLower( const std::string & sString )
+{
+	std::string sOut;
+	sOut.reserve( sString.size() + 1 );
+	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
+	{
+		sOut.push_back( (char)tolower( *i ) );
+	}
+
+	return sOut;
+}
+
+static std::string ReferenceStringToUpper( const std::string & sString )
+{
+	std::string sOut;
+	sOut.reserve( sString.size() + 1 );
+	for( std::string::const_iterator i = sString.begin(); i != sString.end(); i++ )
+	{
+		sOut.push_back( (char)toupper( *i ) );
+	}
+
+	return sOut;
+}
+
+// StringHasSuffix copied the end of the string out before comparing
+static bool ReferenceStringHasSuffix( const std::string &sString, const std::string &sSuffix )
+{
+	size_t cStrLen = sString.length();
+	size_t cSuffixLen = sSuffix.length();
+
+	if ( cSuffixLen > cStrLen )
+		return false;
+
+	std::string sStringSuffix = sString.substr( cStrLen - cSuffixLen, cSuffixLen );
+
+	return 0 == stricmp( sStringSuffix.c_str(), sSuffix.c_str() );
+}
+
+static void BenchIdentifier( const std::string & sIdentifier, uint64_t unIterations )
+{
+	VRTEST_CHECK( StringToLower( sIdentifier ) == ReferenceStringToLower( sIdentifier ) );
+	VRTEST_CHECK( StringToUpper( sIdentifier ) == ReferenceStringToUpper( sIdentifier ) );
+	std::string sLength = std::to_string( sIdentifier.length() ) + " chars";
+	const std::string sSuffix = StringToUpper( sIdentifier.substr( sIdentifier.length() / 2 ) );
+
+	size_t unTotal = 0;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceStringToLower( sIdentifier ).length();
+	VRTest_Report( ( "old StringToLower, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += StringToLower( sIdentifier ).length();
+	VRTest_Report( ( "StringToLower, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceStringToUpper( sIdentifier ).length();
+	VRTest_Report( ( "old StringToUpper, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += StringToUpper( sIdentifier ).length();
+	VRTest_Report( ( "StringToUpper, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == 4 * unIterations * sIdentifier.length() );
+
+	unTotal = 0;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceStringHasSuffix( sIdentifier, sSuffix ) ? 1 : 0;
+	VRTest_Report( ( "old StringHasSuffix, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += StringHasSuffix( sIdentifier, sSuffix ) ? 1 : 0;
+	VRTest_Report( ( "StringHasSuffix, " + sLength ).c_str(), unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == 2 * unIterations );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 1000000, flScale );
+
+	for ( const char *pchIdentifier : { "Lighthouse", "generic_HMD", "vr_controller_vive_1_5", "{Lighthouse}VR_Tracker_Vive_3_0",
+		"/Devices/Lighthouse/Knuckles/Input/Trigger/Click", "/user/hand/right/input/{indexcontroller}/Thumbstick/Touch/Value/History" } )
+	{
+		BenchIdentifier( pchIdentifier, unIterations );
+	}
+
+	return VRTest_Result( "stringcasebench" );
+}
@@ -0,0 +1,162 @@
+//========= Copyright Valve Corporation ============//
+// A minimal stand-in for the runtime's vrclient, so the loader in openvr_api can be run and
+// measured without SteamVR installed. See stubvrclient.h for the knobs.
+#include "openvr.h"
+#include "ivrclientcore.h"
+#include "stubvrclient.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#if defined( _WIN32 )
+#define STUBVRCLIENT_EXPORT extern "C" __declspec( dllexport )
+#else
+#define STUBVRCLIENT_EXPORT extern "C" __attribute__( ( visibility( "default" ) ) )
+#endif
+
+using namespace vr;
+
+static uint32_t GetEnvAsUint( const char *pchVarName, uint32_t unDefault )
+{
+	const char *pchValue = getenv( pchVarName );
+	if ( !pchValue || !*pchValue )
+		return unDefault;
+	return (uint32_t)strtoul( pchValue, nullptr, 10 );
+}
+
+static void SpinMicroseconds( uint32_t unMicroseconds )
+{
+	if ( !unMicroseconds )
+		return;
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds( unMicroseconds );
+	while ( std::chrono::steady_clock::now() < end )
+	{
+	}
+}
+
+static std::atomic<uint32_t> s_unInitCalls( 0 );
+static std::atomic<uint32_t> s_unCleanupCalls( 0 );
+static std::atomic<uint32_t> s_unIsInterfaceVersionValidCalls( 0 );
+static std::atomic<uint32_t> s_unGetGenericInterfaceCalls( 0 );
+static std::atomic<uint32_t> s_unIsHmdPresentCalls( 0 );
+
+
+// Stands in for the work the real vrclient does in its static initializers
+static struct CStubLoadDelay
+{
+	CStubLoadDelay()
+	{
+		std::this_thread::sleep_for( std::chrono::milliseconds( GetEnvAsUint( STUBVRCLIENT_LOAD_DELAY_MS, 0 ) ) );
+	}
+} s_loadDelay;
+
+
+class CStubVRClientCore : public IVRClientCore
+{
+public:
+	CStubVRClientCore() : m_unInterfaceDelayMicroseconds( 0 ) {}
+
+	virtual EVRInitError Init( EVRApplicationType eApplicationType, const char *pStartupInfo ) override
+	{
+		(void)eApplicationType;
+		(void)pStartupInfo;
+		++s_unInitCalls;
+		m_unInterfaceDelayMicroseconds = GetEnvAsUint( STUBVRCLIENT_INTERFACE_DELAY_US, 0 );
+		std::this_thread::sleep_for( std::chrono::milliseconds( GetEnvAsUint( STUBVRCLIENT_INIT_DELAY_MS, 0 ) ) );
+		return (EVRInitError)GetEnvAsUint( STUBVRCLIENT_INIT_ERROR, VRInitError_None );
+	}
+
+	virtual void Cleanup() override
+	{
+		++s_unCleanupCalls;
+	}
+
+	virtual EVRInitError IsInterfaceVersionValid( const char *pchInterfaceVersion ) override
+	{
+		++s_unIsInterfaceVersionValidCalls;
+		SpinMicroseconds( m_unInterfaceDelayMicroseconds );
+		return BIsKnownInterface( pchInterfaceVersion ) ? VRInitError_None : VRInitError_Init_InvalidInterface;
+	}
+
+	// Hands out a distinct, stable pointer for each interface version. Nothing should call
+	// through it.
+	virtual void *GetGenericInterface( const char *pchNameAndVersion, EVRInitError *peError ) override
+	{
+		++s_unGetGenericInterfaceCalls;
+		SpinMicroseconds( m_unInterfaceDelayMicroseconds );
+		if ( !BIsKnownInterface( pchNameAndVersion ) )
+		{
+			if ( peError )
+				*peError = VRInitError_Init_InterfaceNotFound;
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock( m_mutexInterfaces );
+		const std::string &sInterface = *m_setInterfaces.insert( pchNameAndVersion ).first;
+		if ( peError )
+			*peError = VRInitError_None;
+		return const_cast< std::string * >( &sInterface );
+	}
+
+	virtual bool BIsHmdPresent() override
+	{
+		++s_unIsHmdPresentCalls;
+		return GetEnvAsUint( STUBVRCLIENT_HMD_PRESENT, 1 ) != 0;
+	}
+
+	virtual const char *GetEnglishStringForHmdError( EVRInitError eError ) override
+	{
+		(void)eError;
+		return "Stub vrclient error";
+	}
+
+	virtual const char *GetIDForVRInitError( EVRInitError eError ) override
+	{
+		(void)eError;
+		return "StubVRClientError";
+	}
+
+private:
+	static bool BIsKnownInterface( const char *pchInterfaceVersion )
+	{
+		return pchInterfaceVersion && strncmp( pchInterfaceVersion, "IVR", 3 ) == 0;
+	}
+
+	std::atomic<uint32_t> m_unInterfaceDelayMicroseconds;
+	std::mutex m_mutexInterfaces;
+	std::set< std::string > m_setInterfaces;
+};
+
+static CStubVRClientCore s_clientCore;
+
+
+STUBVRCLIENT_EXPORT void *VRClientCoreFactory( const char *pInterfaceName, int *pReturnCode )
+{
+	if ( pInterfaceName && strcmp( pInterfaceName, IVRClientCore_Version ) == 0 )
+	{
+		if ( pReturnCode )
+			*pReturnCode = VRInitError_None;
+		return &s_clientCore;
+	}
+
+	if ( pReturnCode )
+		*pReturnCode = VRInitError_Init_InterfaceNotFound;
+	return nullptr;
+}
+
+
+STUBVRCLIENT_EXPORT void StubVRClient_GetStats( StubVRClientStats_t *pStats )
+{
+	pStats->unInitCalls = s_unInitCalls;
+	pStats->unCleanupCalls = s_unCleanupCalls;
+	pStats->unIsInterfaceVersionValidCalls = s_unIsInterfaceVersionValidCalls;
+	pStats->unGetGenericInterfaceCalls = s_unGetGenericInterfaceCalls;
+	pStats->unIsHmdPresentCalls = s_unIsHmdPresentCalls;
+}
@@ -0,0 +1,25 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+#include <stdint.h>
+
+// Environment variables that configure the stub vrclient. Each one is read when the call it
+// affects is made, except STUBVRCLIENT_INTERFACE_DELAY_US, which is read in Init.
+#define STUBVRCLIENT_LOAD_DELAY_MS		"STUBVRCLIENT_LOAD_DELAY_MS"		// sleep while the module is being loaded
+#define STUBVRCLIENT_INIT_DELAY_MS		"STUBVRCLIENT_INIT_DELAY_MS"		// sleep in IVRClientCore::Init
+#define STUBVRCLIENT_INTERFACE_DELAY_US	"STUBVRCLIENT_INTERFACE_DELAY_US"	// spin in GetGenericInterface and IsInterfaceVersionValid
+#define STUBVRCLIENT_INIT_ERROR			"STUBVRCLIENT_INIT_ERROR"			// EVRInitError for Init to return
+#define STUBVRCLIENT_HMD_PRESENT		"STUBVRCLIENT_HMD_PRESENT"			// "0" makes BIsHmdPresent return false
+
+/** Calls made into the stub since it was loaded */
+struct StubVRClientStats_t
+{
+	uint32_t unInitCalls;
+	uint32_t unCleanupCalls;
+	uint32_t unIsInterfaceVersionValidCalls;
+	uint32_t unGetGenericInterfaceCalls;
+	uint32_t unIsHmdPresentCalls;
+};
+
+/** Exported by the stub as "StubVRClient_GetStats" */
+typedef void ( *StubVRClient_GetStatsFn )( StubVRClientStats_t *pStats );
@@ -0,0 +1,190 @@
+//========= Copyright Valve Corporation ============//
+// Tests TokenizeString against the istringstream version it replaced, and CStringTokenizer's
+// multi-character and any-of modes against std::string::find and find_first_of. Any-of sets of up
+// to four characters are searched 16 bytes at a time where SSE2 is available, so delimiters are put
+// at every position around those blocks.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <random>
+#include <sstream>
+
+// TokenizeString as it was before it used CStringTokenizer
+namespace reference
+{
+
+std::vector<std::string> TokenizeString( const std::string & sString, char cToken )
+{
+	std::vector<std::string> vecStrings;
+	std::istringstream stream( sString );
+	std::string s;
+	while ( std::getline( stream, s, cToken ) )
+	{
+		vecStrings.push_back( s );
+	}
+
+	if ( !sString.empty() && sString.back() == cToken )
+	{
+		vecStrings.push_back( "" );
+	}
+
+	return vecStrings;
+}
+
+} // namespace reference
+
+static std::vector<std::string> Tokenize( const std::string & sString, const std::string & sDelimiter, ETokenDelimiter eDelimiter )
+{
+	std::vector<std::string> vecTokens;
+	CStringTokenizer tokenizer( sString, sDelimiter.c_str(), eDelimiter );
+	const char *pchToken;
+	size_t unTokenLength;
+	while ( tokenizer.BNextToken( &pchToken, &unTokenLength ) )
+	{
+		// tokens point into the original string
+		VRTEST_CHECK( pchToken >= sString.data() && pchToken + unTokenLength <= sString.data() + sString.length() );
+		vecTokens.push_back( std::string( pchToken, unTokenLength ) );
+	}
+	return vecTokens;
+}
+
+// The same rules as TokenizeString: nothing for an empty string, an empty token between adjacent
+// delimiters and after a trailing one, and no splitting at all on an empty delimiter
+static std::vector<std::string> ExpectedTokens( const std::string & sString, const std::string & sDelimiter, ETokenDelimiter eDelimiter )
+{
+	std::vector<std::string> vecTokens;
+	if ( sString.empty() )
+		return vecTokens;
+
+	size_t unStart = 0;
+	for ( ;; )
+	{
+		size_t unFound = std::string::npos;
+		if ( !sDelimiter.empty() )
+			unFound = eDelimiter == k_ETokenDelimiter_String ? sString.find( sDelimiter, unStart ) : sString.find_first_of( sDelimiter, unStart );
+		if ( unFound == std::string::npos )
+		{
+			vecTokens.push_back( sString.substr( unStart ) );
+			return vecTokens;
+		}
+		vecTokens.push_back( sString.substr( unStart, unFound - unStart ) );
+		unStart = unFound + ( eDelimiter == k_ETokenDelimiter_String ? sDelimiter.length() : 1 );
+	}
+}
+
+static void CheckTokenize( const std::string & sString, const std::string & sDelimiter, ETokenDelimiter eDelimiter )
+{
+	if ( Tokenize( sString, sDelimiter, eDelimiter ) != ExpectedTokens( sString, sDelimiter, eDelimiter ) )
+	{
+		fprintf( stderr, "CStringTokenizer( \"%s\", \"%s\", %s ) disagrees\n", sString.c_str(), sDelimiter.c_str(),
+			eDelimiter == k_ETokenDelimiter_String ? "String" : "AnyOf" );
+		VRTEST_CHECK( false );
+	}
+}
+
+static void TestTokenizeString()
+{
+	static const char *k_rgpchStrings[] = { "", "/", "//", "a", "a/", "/a", "a//b", "/user/hand/left/input/trigger/click",
+		"C:\\Program Files\\Steam\\", "no delimiters here at all, and long enough for a few blocks" };
+	for ( const char *pchString : k_rgpchStrings )
+	{
+		VRTEST_CHECK( TokenizeString( pchString, '/' ) == reference::TokenizeString( pchString, '/' ) );
+		VRTEST_CHECK( TokenizeString( pchString, '\\' ) == reference::TokenizeString( pchString, '\\' ) );
+	}
+
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < 50000; ++nIteration )
+	{
+		std::string s;
+		for ( int nChars = rng() % 48; nChars > 0; --nChars )
+			s.push_back( "ab/\\ \xE9"[ rng() % 6 ] );
+		VRTEST_CHECK( TokenizeString( s, '/' ) == reference::TokenizeString( s, '/' ) );
+		VRTEST_CHECK( TokenizeString( s, '\xE9' ) == reference::TokenizeString( s, '\xE9' ) );
+	}
+}
+
+// One delimiter, and a pair of them, at every position around the 16 byte blocks, for any-of sets
+// of each size the SSE2 path handles and one it doesn't
+static void TestAnyOfAtEveryPosition()
+{
+	static const char *k_rgpchSets[] = { "/\\", "/\\:", "/\\:.", "/\\:.;", "\xE9\xFF", ",\xE9,", "ab" };
+	for ( const char *pchSet : k_rgpchSets )
+	{
+		for ( const char *pchDelimiter = pchSet; *pchDelimiter; ++pchDelimiter )
+		{
+			for ( size_t unPosition = 0; unPosition <= 40; ++unPosition )
+			{
+				std::string s( 40, 'x' );
+				s.insert( unPosition, 1, *pchDelimiter );
+				CheckTokenize( s, pchSet, k_ETokenDelimiter_AnyOf );
+
+				s.insert( ( unPosition * 7 ) % s.length(), 1, pchSet[ 0 ] );
+				CheckTokenize( s, pchSet, k_ETokenDelimiter_AnyOf );
+				CheckTokenize( s.substr( 0, unPosition + 1 ), pchSet, k_ETokenDelimiter_AnyOf );
+			}
+		}
+	}
+}
+
+// Multi-character delimiters, including ones whose first character is common in the string and
+// ones that overlap themselves
+static void TestStringDelimiters()
+{
+	static const char *k_rgpchDelimiters[] = { "::", "->", "aa", "aba", "/input/", "x" };
+	for ( const char *pchDelimiter : k_rgpchDelimiters )
+	{
+		CheckTokenize( "", pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( pchDelimiter, pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( std::string( pchDelimiter ) + pchDelimiter, pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( "aaaaa", pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( "ababababa", pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( "/user/hand/left/input/trigger/input/click", pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( "vr::IVRSystem::GetTrackedDeviceClass->x", pchDelimiter, k_ETokenDelimiter_String );
+	}
+
+	// a delimiter cut off by the end of the string isn't one
+	CheckTokenize( "a::b:", "::", k_ETokenDelimiter_String );
+	VRTEST_CHECK( Tokenize( "a::b:", "::", k_ETokenDelimiter_String ) == std::vector<std::string>( { "a", "b:" } ) );
+	VRTEST_CHECK( Tokenize( "aaa", "aa", k_ETokenDelimiter_String ) == std::vector<std::string>( { "", "a" } ) );
+}
+
+static void TestFuzz()
+{
+	static const char *k_rgpchDelimiters[] = { "", "/", "//", "/\\", "ab", "a/b", "/\\:", "/\\:.", "/\\:.;", "ab/\\ " };
+	std::mt19937 rng( 2 );
+	for ( int nIteration = 0; nIteration < 100000; ++nIteration )
+	{
+		std::string s;
+		for ( int nChars = rng() % 64; nChars > 0; --nChars )
+			s.push_back( "ab/\\:.; x"[ rng() % 9 ] );
+		const char *pchDelimiter = k_rgpchDelimiters[ rng() % ( sizeof( k_rgpchDelimiters ) / sizeof( k_rgpchDelimiters[ 0 ] ) ) ];
+		CheckTokenize( s, pchDelimiter, k_ETokenDelimiter_String );
+		CheckTokenize( s, pchDelimiter, k_ETokenDelimiter_AnyOf );
+	}
+}
+
+// The pointer and length constructors don't stop at a null
+static void TestEmbeddedNull()
+{
+	const char rgchString[] = "a/b\0c/d";
+	CStringTokenizer tokenizer( rgchString, sizeof( rgchString ) - 1, '/' );
+	const char *pchToken;
+	size_t unTokenLength;
+	VRTEST_CHECK( tokenizer.BNextToken( &pchToken, &unTokenLength ) && unTokenLength == 1 && pchToken == rgchString );
+	VRTEST_CHECK( tokenizer.BNextToken( &pchToken, &unTokenLength ) && std::string( pchToken, unTokenLength ) == std::string( "b\0c", 3 ) );
+	VRTEST_CHECK( tokenizer.BNextToken( &pchToken, &unTokenLength ) && std::string( pchToken, unTokenLength ) == "d" );
+	VRTEST_CHECK( !tokenizer.BNextToken( &pchToken, &unTokenLength ) );
+	VRTEST_CHECK( !tokenizer.BNextToken( &pchToken, &unTokenLength ) );
+}
+
+int main()
+{
+	TestTokenizeString();
+	TestAnyOfAtEveryPosition();
+	TestStringDelimiters();
+	TestFuzz();
+	TestEmbeddedNull();
+
+	return VRTest_Result( "tokenizer_test" );
+}
@@ -0,0 +1,96 @@
+//========= Copyright Valve Corporation ============//
+// Times TokenizeString against the istringstream version it replaced, and CStringTokenizer on its
+// own, splitting long paths: a deep install path on '/', the same path with mixed separators split
+// on any of "/\", and an action path split on a multi-character delimiter.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <algorithm>
+#include <sstream>
+
+static std::vector<std::string> ReferenceTokenizeString( const std::string & sString, char cToken )
+{
+	std::vector<std::string> vecStrings;
+	std::istringstream stream( sString );
+	std::string s;
+	while ( std::getline( stream, s, cToken ) )
+	{
+		vecStrings.push_back( s );
+	}
+
+	if ( !sString.empty() && sString.back() == cToken )
+	{
+		vecStrings.push_back( "" );
+	}
+
+	return vecStrings;
+}
+
+static size_t CountTokens( const std::string & sString, const char *pchDelimiter, ETokenDelimiter eDelimiter )
+{
+	CStringTokenizer tokenizer( sString, pchDelimiter, eDelimiter );
+	const char *pchToken;
+	size_t unTokenLength;
+	size_t unTokens = 0;
+	while ( tokenizer.BNextToken( &pchToken, &unTokenLength ) )
+		unTokens++;
+	return unTokens;
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 200000, flScale );
+
+	const std::string sPath = "/home/user/.local/share/Steam/steamapps/common/SteamVR/drivers/lighthouse/resources/input/"
+		"bindings/legacy/knuckles/profiles/default/actions/main/in/left_hand/grip/click/value/history/2026";
+	const std::string sMixedPath = "C:\\Program Files (x86)\\Steam/steamapps\\common/SteamVR\\drivers/lighthouse\\resources/input"
+		"\\bindings/legacy\\knuckles/profiles\\default/actions\\main/in\\left_hand/grip\\click/value\\history/2026";
+	const std::string sActionPath = "/actions/main/in/left_hand::/actions/main/in/right_hand::/actions/main/in/head::"
+		"/actions/main/out/haptic_left::/actions/main/out/haptic_right::/actions/legacy/in/system";
+	const size_t unPathTokens = ReferenceTokenizeString( sPath, '/' ).size();
+	VRTEST_CHECK( TokenizeString( sPath, '/' ) == ReferenceTokenizeString( sPath, '/' ) );
+	const size_t unMixedPathTokens = std::count( sMixedPath.begin(), sMixedPath.end(), '/' ) + std::count( sMixedPath.begin(), sMixedPath.end(), '\\' ) + 1;
+	VRTEST_CHECK( CountTokens( sMixedPath, "/\\", k_ETokenDelimiter_AnyOf ) == unMixedPathTokens );
+	VRTEST_CHECK( CountTokens( sActionPath, "::", k_ETokenDelimiter_String ) == 6 );
+
+	size_t unTotal = 0;
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceTokenizeString( sPath, '/' ).size();
+	VRTest_Report( "istringstream TokenizeString, '/'", unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += TokenizeString( sPath, '/' ).size();
+	VRTest_Report( "TokenizeString, '/'", unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += CountTokens( sPath, "/", k_ETokenDelimiter_String );
+	VRTest_Report( "CStringTokenizer, '/'", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == 3 * unIterations * unPathTokens );
+
+	unTotal = 0;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += CountTokens( sMixedPath, "/\\", k_ETokenDelimiter_AnyOf );
+	VRTest_Report( "CStringTokenizer, any of \"/\\\"", unIterations, VRTest_Seconds() - flStart );
+
+	// five characters is past what the SSE2 path handles, so this is the bitmap path
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += CountTokens( sMixedPath, "/\\;|,", k_ETokenDelimiter_AnyOf );
+	VRTest_Report( "CStringTokenizer, any of \"/\\;|,\"", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == 2 * unIterations * unMixedPathTokens );
+
+	unTotal = 0;
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += CountTokens( sActionPath, "::", k_ETokenDelimiter_String );
+	VRTest_Report( "CStringTokenizer, \"::\"", unIterations, VRTest_Seconds() - flStart );
+	VRTEST_CHECK( unTotal == 6 * unIterations );
+
+	return VRTest_Result( "tokenizerbench" );
+}
@@ -0,0 +1,164 @@
+//========= Copyright Valve Corporation ============//
+// Tests the std::string versions of V_URLEncode and V_URLDecode, which skip 16 bytes at a time where
+// SSE2 is available, against the buffer versions built on V_URLEncodeInternal and
+// V_URLDecodeInternal. The output must match exactly for any input, including bytes >= 0x80, %00,
+// '+' and a '%' too close to the end to have two digits after it.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <random>
+#include <vector>
+
+enum EURLEncoder
+{
+	k_EURLEncoder_PlusForSpace,
+	k_EURLEncoder_NoPlusForSpace,
+	k_EURLEncoder_FullPath,
+};
+
+static std::string ReferenceEncode( const std::string & sSource, EURLEncoder eEncoder )
+{
+	std::vector< char > vecDest( sSource.length() * 3 + 1 );
+	switch ( eEncoder )
+	{
+	case k_EURLEncoder_PlusForSpace:
+		V_URLEncode( vecDest.data(), ( int )vecDest.size(), sSource.data(), ( int )sSource.length() );
+		break;
+	case k_EURLEncoder_NoPlusForSpace:
+		V_URLEncodeNoPlusForSpace( vecDest.data(), ( int )vecDest.size(), sSource.data(), ( int )sSource.length() );
+		break;
+	case k_EURLEncoder_FullPath:
+		V_URLEncodeFullPath( vecDest.data(), ( int )vecDest.size(), sSource.data(), ( int )sSource.length() );
+		break;
+	}
+	// the encoded form never contains a null, %00 is escaped
+	return std::string( vecDest.data() );
+}
+
+static std::string Encode( const std::string & sSource, EURLEncoder eEncoder )
+{
+	switch ( eEncoder )
+	{
+	case k_EURLEncoder_PlusForSpace:
+		return V_URLEncode( sSource );
+	case k_EURLEncoder_NoPlusForSpace:
+		return V_URLEncodeNoPlusForSpace( sSource );
+	case k_EURLEncoder_FullPath:
+		return V_URLEncodeFullPath( sSource );
+	}
+	return std::string();
+}
+
+static std::string ReferenceDecode( const std::string & sEncoded, bool bUsePlusForSpace )
+{
+	std::vector< char > vecDest( sEncoded.length() + 1 );
+	size_t unLength = bUsePlusForSpace
+		? V_URLDecode( vecDest.data(), ( int )vecDest.size(), sEncoded.data(), ( int )sEncoded.length() )
+		: V_URLDecodeNoPlusForSpace( vecDest.data(), ( int )vecDest.size(), sEncoded.data(), ( int )sEncoded.length() );
+	return std::string( vecDest.data(), unLength );
+}
+
+static void PrintBytes( const char *pchWhat, const std::string & s )
+{
+	fprintf( stderr, "%s disagrees on:", pchWhat );
+	for ( char ch : s )
+		fprintf( stderr, " %02x", ( uint8_t )ch );
+	fprintf( stderr, "\n" );
+}
+
+static void CheckEncode( const std::string & sSource )
+{
+	for ( EURLEncoder eEncoder : { k_EURLEncoder_PlusForSpace, k_EURLEncoder_NoPlusForSpace, k_EURLEncoder_FullPath } )
+	{
+		std::string sEncoded = Encode( sSource, eEncoder );
+		if ( sEncoded != ReferenceEncode( sSource, eEncoder ) )
+		{
+			PrintBytes( "URL encode", sSource );
+			VRTEST_CHECK( false );
+		}
+
+		// and it comes back
+		bool bUsePlusForSpace = eEncoder == k_EURLEncoder_PlusForSpace;
+		std::string sDecoded = bUsePlusForSpace ? V_URLDecode( sEncoded ) : V_URLDecodeNoPlusForSpace( sEncoded );
+		VRTEST_CHECK( sDecoded == sSource );
+	}
+}
+
+static void CheckDecode( const std::string & sEncoded )
+{
+	if ( V_URLDecode( sEncoded ) != ReferenceDecode( sEncoded, true )
+		|| V_URLDecodeNoPlusForSpace( sEncoded ) != ReferenceDecode( sEncoded, false ) )
+	{
+		PrintBytes( "URL decode", sEncoded );
+		VRTEST_CHECK( false );
+	}
+}
+
+// Every byte at every position around the 16 byte blocks, in a run that needs no escaping
+static void TestEveryByteAtEveryPosition()
+{
+	for ( int nByte = 0; nByte < 256; ++nByte )
+	{
+		for ( size_t unPosition = 0; unPosition <= 34; ++unPosition )
+		{
+			std::string s( 34, 'x' );
+			s.insert( s.begin() + unPosition, ( char )nByte );
+			CheckEncode( s );
+			CheckDecode( s );
+		}
+	}
+}
+
+// '%' with zero, one and two characters after it, good and bad digits, either side of each block
+static void TestPercentAtEveryPosition()
+{
+	static const char *k_rgpchEscapes[] = { "%", "%4", "%41", "%00", "%ff", "%FF", "%8a", "%g1", "%1g", "%%", "%%41", "%+", "+", "+%2B" };
+	for ( const char *pchEscape : k_rgpchEscapes )
+	{
+		for ( size_t unPosition = 0; unPosition <= 34; ++unPosition )
+		{
+			std::string s( 34, 'x' );
+			s.insert( unPosition, pchEscape );
+			CheckDecode( s );
+			// the same escape right at the end
+			CheckDecode( s.substr( 0, unPosition + strlen( pchEscape ) ) );
+		}
+	}
+
+	VRTEST_CHECK( V_URLDecode( std::string( "a%00b" ) ) == std::string( "a\0b", 3 ) );
+	VRTEST_CHECK( V_URLDecode( std::string( "a+b" ) ) == "a b" );
+	VRTEST_CHECK( V_URLDecodeNoPlusForSpace( std::string( "a+b" ) ) == "a+b" );
+	VRTEST_CHECK( V_URLEncode( std::string( "a\0b", 3 ) ) == "a%00b" );
+	VRTEST_CHECK( V_URLEncode( std::string( "\x80\xff" ) ) == "%80%FF" );
+}
+
+// Random strings biased towards the bytes each side treats specially, with runs long enough for the
+// 16 byte paths
+static void TestFuzzAgainstReference()
+{
+	static const uint8_t k_rgBytes[] = { 'a', 'Z', '0', '9', 'f', 'G', '-', '.', '_', '/', ':', '~', ' ', '+', '%', '%', '%',
+		0x00, 0x1F, 0x7F, 0x80, 0xC3, 0xFF };
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < 200000; ++nIteration )
+	{
+		std::string s;
+		for ( int nBytes = rng() % 40; nBytes > 0; --nBytes )
+			s.push_back( ( char )k_rgBytes[ rng() % sizeof( k_rgBytes ) ] );
+		if ( rng() % 2 == 0 )
+			s.insert( rng() % ( s.length() + 1 ), std::string( rng() % 40, 'x' ) );
+		CheckEncode( s );
+		CheckDecode( s );
+	}
+}
+
+int main()
+{
+	TestEveryByteAtEveryPosition();
+	TestPercentAtEveryPosition();
+	TestFuzzAgainstReference();
+	CheckEncode( "" );
+	CheckDecode( "" );
+
+	return VRTest_Result( "urlencode_test" );
+}
@@ -0,0 +1,80 @@
+//========= Copyright Valve Corporation ============//
+// Times the std::string versions of V_URLEncode and V_URLDecode against the buffer versions callers
+// had to wrap before, each on about 4 KB before encoding: a query string of safe characters, one with
+// a space every few words, and UTF-8 text where most bytes need escaping.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <vector>
+
+// what a caller had to write before the std::string versions existed
+static std::string ReferenceEncode( const std::string & sSource )
+{
+	std::vector< char > vecDest( sSource.length() * 3 + 1 );
+	V_URLEncode( vecDest.data(), ( int )vecDest.size(), sSource.data(), ( int )sSource.length() );
+	return std::string( vecDest.data() );
+}
+
+static std::string ReferenceDecode( const std::string & sEncoded )
+{
+	std::vector< char > vecDest( sEncoded.length() + 1 );
+	size_t unLength = V_URLDecode( vecDest.data(), ( int )vecDest.size(), sEncoded.data(), ( int )sEncoded.length() );
+	return std::string( vecDest.data(), unLength );
+}
+
+static std::string RepeatTo( const char *pchUnit, size_t unLength )
+{
+	std::string s;
+	while ( s.length() < unLength )
+		s += pchUnit;
+	return s;
+}
+
+static void BenchText( const char *pchName, const std::string & sSource, uint64_t unIterations )
+{
+	const std::string sEncoded = ReferenceEncode( sSource );
+	VRTEST_CHECK( V_URLEncode( sSource ) == sEncoded && V_URLDecode( sEncoded ) == sSource );
+	std::string sName = pchName;
+	size_t unTotal = 0;
+
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceEncode( sSource ).length();
+	VRTest_Report( ( "V_URLEncodeInternal, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += V_URLEncode( sSource ).length();
+	VRTest_Report( ( "V_URLEncode( std::string ), " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceDecode( sEncoded ).length();
+	VRTest_Report( ( "V_URLDecodeInternal, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += V_URLDecode( sEncoded ).length();
+	VRTest_Report( ( "V_URLDecode( std::string ), " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	VRTEST_CHECK( unTotal == unIterations * 2 * ( sSource.length() + sEncoded.length() ) );
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 20000, flScale );
+	const size_t k_unTextLength = 4096;
+
+	const std::string sQuery = RepeatTo( "driver_lighthouse.serial_number=LHR-1A2B3C4D&app_key=system.generated.vrmonitor&", k_unTextLength );
+	const std::string sUtf8 = RepeatTo( "Param\xC3\xA8tres \xE8\xA8\xAD\xE5\xAE\x9A \xE3\x82\x92\xE9\x96\x8B\xE3\x81\x8F / ", k_unTextLength );
+
+	const std::string sSpaces = RepeatTo( "/settings/steamvr/mirror view geometry=0 0 1080 600&driver=lighthouse&", k_unTextLength );
+
+	BenchText( "query", sQuery, unIterations );
+	BenchText( "query with spaces", sSpaces, unIterations );
+	BenchText( "UTF-8 text", sUtf8, unIterations );
+
+	return VRTest_Result( "urlencodebench" );
+}
@@ -0,0 +1,298 @@
+//========= Copyright Valve Corporation ============//
+// Tests UTF8to16 and UTF16to8, and the buffer versions under them, against the
+// std::wstring_convert they replaced. The two differ on purpose in a few places, all of which
+// the old converter let through and the new one rejects: surrogates encoded as UTF-8, a truncated
+// sequence at the end of UTF-8, and an unpaired high surrogate at the end of UTF-16.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <codecvt>
+#include <locale>
+#include <random>
+#include <thread>
+#include <vector>
+
+// The conversions as they were before the buffer versions, returning an empty string on failure
+namespace reference
+{
+
+static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert;
+
+std::string UTF16to8( const std::wstring &in )
+{
+	try
+	{
+		return s_convert.to_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::string();
+	}
+}
+
+std::wstring UTF8to16( const std::string &in )
+{
+	try
+	{
+		return s_convert.from_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::wstring();
+	}
+}
+
+} // namespace reference
+
+static void AppendUTF8( std::string *psOut, uint32_t unCodePoint )
+{
+	if ( unCodePoint < 0x80 )
+	{
+		psOut->push_back( ( char )unCodePoint );
+	}
+	else if ( unCodePoint < 0x800 )
+	{
+		psOut->push_back( ( char )( 0xC0 | ( unCodePoint >> 6 ) ) );
+		psOut->push_back( ( char )( 0x80 | ( unCodePoint & 0x3F ) ) );
+	}
+	else if ( unCodePoint < 0x10000 )
+	{
+		psOut->push_back( ( char )( 0xE0 | ( unCodePoint >> 12 ) ) );
+		psOut->push_back( ( char )( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) ) );
+		psOut->push_back( ( char )( 0x80 | ( unCodePoint & 0x3F ) ) );
+	}
+	else
+	{
+		psOut->push_back( ( char )( 0xF0 | ( unCodePoint >> 18 ) ) );
+		psOut->push_back( ( char )( 0x80 | ( ( unCodePoint >> 12 ) & 0x3F ) ) );
+		psOut->push_back( ( char )( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) ) );
+		psOut->push_back( ( char )( 0x80 | ( unCodePoint & 0x3F ) ) );
+	}
+}
+
+// Mostly ASCII, with runs long enough for the 16 byte fast path, and every other length of sequence
+static uint32_t RandomCodePoint( std::mt19937 &rng )
+{
+	switch ( rng() % 8 )
+	{
+	case 0: return 0x80 + rng() % ( 0x800 - 0x80 );
+	case 1: return 0x800 + rng() % ( 0xD800 - 0x800 );
+	case 2: return 0xE000 + rng() % ( 0x10000 - 0xE000 );
+	case 3: return 0x10000 + rng() % ( 0x110000 - 0x10000 );
+	default: return 0x20 + rng() % 0x5F;
+	}
+}
+
+static bool BIsEncodedSurrogate( const std::string & s )
+{
+	for ( size_t i = 0; i + 1 < s.length(); ++i )
+	{
+		if ( ( uint8_t )s[ i ] == 0xED && ( uint8_t )s[ i + 1 ] >= 0xA0 && ( uint8_t )s[ i + 1 ] <= 0xBF )
+			return true;
+	}
+	return false;
+}
+
+// The old converter stopped quietly when the last lead byte promised more bytes than were left
+static bool BOldDroppedTruncatedTail( const std::string & s, const std::wstring & wsOld )
+{
+	for ( size_t unTail = 1; unTail <= 3 && unTail <= s.length(); ++unTail )
+	{
+		if ( ( uint8_t )s[ s.length() - unTail ] >= 0xC0 && reference::UTF8to16( s.substr( 0, s.length() - unTail ) ) == wsOld )
+			return true;
+	}
+	return false;
+}
+
+// Valid text must convert exactly as before, both ways
+static void TestValidAgainstReference( std::mt19937 &rng )
+{
+	for ( int nIteration = 0; nIteration < 20000; ++nIteration )
+	{
+		std::string sUtf8;
+		for ( int nCodePoints = rng() % 80; nCodePoints > 0; --nCodePoints )
+			AppendUTF8( &sUtf8, RandomCodePoint( rng ) );
+
+		std::wstring wsExpected = reference::UTF8to16( sUtf8 );
+		VRTEST_CHECK( UTF8to16( sUtf8 ) == wsExpected );
+		VRTEST_CHECK( UTF8to16( sUtf8.c_str() ) == wsExpected );
+		VRTEST_CHECK( UTF16to8( wsExpected ) == sUtf8 );
+		VRTEST_CHECK( UTF16to8( wsExpected.c_str() ) == sUtf8 );
+		VRTEST_CHECK( reference::UTF16to8( wsExpected ) == sUtf8 );
+	}
+}
+
+// Random bytes biased towards the ones that matter to a decoder. Where the two disagree, the new
+// result must be a rejection for one of the reasons above.
+static void TestUTF8FuzzAgainstReference( std::mt19937 &rng )
+{
+	static const uint8_t k_rgBytes[] = { 'a', 'z', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF,
+		0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF };
+	uint32_t unDisagreements = 0;
+	for ( int nIteration = 0; nIteration < 300000; ++nIteration )
+	{
+		std::string sIn;
+		for ( int nBytes = rng() % 24; nBytes > 0; --nBytes )
+			sIn.push_back( ( char )k_rgBytes[ rng() % sizeof( k_rgBytes ) ] );
+		if ( rng() % 4 == 0 )
+			sIn.insert( rng() % ( sIn.length() + 1 ), "0123456789abcdefghij" );
+
+		std::wstring wsOld = reference::UTF8to16( sIn );
+		std::wstring wsNew = UTF8to16( sIn );
+		if ( wsOld == wsNew )
+			continue;
+
+		++unDisagreements;
+		if ( !wsNew.empty() || !( BIsEncodedSurrogate( sIn ) || BOldDroppedTruncatedTail( sIn, wsOld ) ) )
+		{
+			fprintf( stderr, "UTF8to16 disagrees on:" );
+			for ( char ch : sIn )
+				fprintf( stderr, " %02x", ( uint8_t )ch );
+			fprintf( stderr, "\n" );
+			VRTEST_CHECK( false );
+		}
+	}
+	VRTEST_CHECK( unDisagreements > 0 );
+}
+
+static void TestUTF16FuzzAgainstReference( std::mt19937 &rng )
+{
+	static const uint32_t k_rgUnits[] = { 'a', 0x7F, 0x80, 0x7FF, 0x800, 0xD7FF, 0xD800, 0xDBFF, 0xDC00, 0xDFFF, 0xE000,
+		0xFFFF, 0x10000, 0x10FFFF, 0x110000, 0x1F600 };
+	for ( int nIteration = 0; nIteration < 300000; ++nIteration )
+	{
+		std::wstring wsIn;
+		for ( int nUnits = rng() % 12; nUnits > 0; --nUnits )
+		{
+			uint32_t unUnit = k_rgUnits[ rng() % ( sizeof( k_rgUnits ) / sizeof( k_rgUnits[ 0 ] ) ) ];
+			if ( sizeof( wchar_t ) == 2 && unUnit > 0xFFFF )
+				unUnit = 'b';
+			wsIn.push_back( ( wchar_t )unUnit );
+		}
+		if ( rng() % 4 == 0 )
+			wsIn.insert( rng() % ( wsIn.length() + 1 ), L"0123456789abcdefghij" );
+
+		std::string sOld = reference::UTF16to8( wsIn );
+		std::string sNew = UTF16to8( wsIn );
+		if ( sOld == sNew )
+			continue;
+
+		// the only difference is a high surrogate at the very end, which the old one dropped
+		bool bTrailingHigh = !wsIn.empty() && wsIn.back() >= 0xD800 && wsIn.back() <= 0xDBFF;
+		if ( !sNew.empty() || !bTrailingHigh || reference::UTF16to8( wsIn.substr( 0, wsIn.length() - 1 ) ) != sOld )
+		{
+			fprintf( stderr, "UTF16to8 disagrees on:" );
+			for ( wchar_t wch : wsIn )
+				fprintf( stderr, " %x", ( uint32_t )wch );
+			fprintf( stderr, "\n" );
+			VRTEST_CHECK( false );
+		}
+	}
+}
+
+// The deliberate differences, one at a time
+static void TestRejections()
+{
+	// surrogates encoded in UTF-8
+	VRTEST_CHECK( !reference::UTF8to16( "\xED\xA0\x80" ).empty() );
+	VRTEST_CHECK( UTF8to16( "\xED\xA0\x80" ).empty() );
+	VRTEST_CHECK( UTF8to16( "abc\xED\xBF\xBF" ).empty() );
+	VRTEST_CHECK( UTF8to16( "\xED\x9F\xBF" ) == std::wstring( 1, ( wchar_t )0xD7FF ) );
+
+	// a sequence cut off at the end
+	VRTEST_CHECK( reference::UTF8to16( "a\xE4\xB8" ) == L"a" );
+	VRTEST_CHECK( UTF8to16( "a\xE4\xB8" ).empty() );
+	VRTEST_CHECK( UTF8to16( "a\xF0\x9F\x98" ).empty() );
+	VRTEST_CHECK( UTF8to16( "a\xC3" ).empty() );
+
+	// an unpaired high surrogate at the end
+	std::wstring wsHigh = L"a";
+	wsHigh.push_back( ( wchar_t )0xD83D );
+	VRTEST_CHECK( reference::UTF16to8( wsHigh ) == "a" );
+	VRTEST_CHECK( UTF16to8( wsHigh ).empty() );
+
+	// rejected by both
+	std::wstring wsLow( 1, ( wchar_t )0xDC00 );
+	VRTEST_CHECK( UTF16to8( wsLow ).empty() );
+	VRTEST_CHECK( UTF8to16( "\xC0\x80" ).empty() );
+	VRTEST_CHECK( UTF8to16( "\xE0\x80\x80" ).empty() );
+	VRTEST_CHECK( UTF8to16( "\xF4\x90\x80\x80" ).empty() );
+	VRTEST_CHECK( UTF8to16( "\x80" ).empty() );
+
+	VRTEST_CHECK( UTF8to16( ( const char * )nullptr ).empty() );
+	VRTEST_CHECK( UTF16to8( ( const wchar_t * )nullptr ).empty() );
+
+	// a whole code point in one wchar_t is accepted where it fits
+	if ( sizeof( wchar_t ) == 4 )
+	{
+		VRTEST_CHECK( UTF16to8( std::wstring( 1, ( wchar_t )0x1F600 ) ) == "\xF0\x9F\x98\x80" );
+		VRTEST_CHECK( UTF16to8( std::wstring( 1, ( wchar_t )0x110000 ) ).empty() );
+	}
+}
+
+// Non-ASCII at every position around the 16 unit fast path, and outputs that are exactly the right
+// size or one short
+static void TestBuffers()
+{
+	for ( size_t unLength = 0; unLength <= 40; ++unLength )
+	{
+		for ( size_t unPosition = 0; unPosition <= unLength; ++unPosition )
+		{
+			std::string sUtf8( unLength, 'x' );
+			if ( unPosition < unLength )
+				sUtf8.replace( unPosition, 1, "\xE2\x82\xAC" );
+			std::wstring wsExpected = reference::UTF8to16( sUtf8 );
+
+			std::vector< wchar_t > vecWide( sUtf8.length() + 1, L'#' );
+			size_t unOutLength = 0;
+			VRTEST_CHECK( UTF8to16Buffer( sUtf8.data(), sUtf8.length(), vecWide.data(), wsExpected.length(), &unOutLength ) );
+			VRTEST_CHECK( std::wstring( vecWide.data(), unOutLength ) == wsExpected );
+			VRTEST_CHECK( vecWide[ wsExpected.length() ] == L'#' );
+			if ( !wsExpected.empty() )
+				VRTEST_CHECK( !UTF8to16Buffer( sUtf8.data(), sUtf8.length(), vecWide.data(), wsExpected.length() - 1, &unOutLength ) );
+
+			std::vector< char > vecNarrow( sUtf8.length() + 1, '#' );
+			VRTEST_CHECK( UTF16to8Buffer( wsExpected.data(), wsExpected.length(), vecNarrow.data(), sUtf8.length(), &unOutLength ) );
+			VRTEST_CHECK( std::string( vecNarrow.data(), unOutLength ) == sUtf8 );
+			VRTEST_CHECK( vecNarrow[ sUtf8.length() ] == '#' );
+			if ( !sUtf8.empty() )
+				VRTEST_CHECK( !UTF16to8Buffer( wsExpected.data(), wsExpected.length(), vecNarrow.data(), sUtf8.length() - 1, nullptr ) );
+		}
+	}
+}
+
+// The old converter was one shared object; these have no state to share
+static void TestConcurrentUse()
+{
+	std::vector< std::thread > vecThreads;
+	for ( int nThread = 0; nThread < 4; ++nThread )
+	{
+		vecThreads.push_back( std::thread( [nThread]()
+		{
+			std::mt19937 rng( 100 + nThread );
+			for ( int nIteration = 0; nIteration < 5000; ++nIteration )
+			{
+				std::string sUtf8;
+				for ( int nCodePoints = rng() % 40; nCodePoints > 0; --nCodePoints )
+					AppendUTF8( &sUtf8, RandomCodePoint( rng ) );
+				VRTEST_CHECK( UTF16to8( UTF8to16( sUtf8 ) ) == sUtf8 );
+			}
+		} ) );
+	}
+	for ( std::thread & thread : vecThreads )
+		thread.join();
+}
+
+int main()
+{
+	std::mt19937 rng( 1 );
+	TestValidAgainstReference( rng );
+	TestUTF8FuzzAgainstReference( rng );
+	TestUTF16FuzzAgainstReference( rng );
+	TestRejections();
+	TestBuffers();
+	TestConcurrentUse();
+
+	return VRTest_Result( "utf_test" );
+}
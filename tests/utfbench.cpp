@@ -0,0 +1,138 @@
+//========= Copyright Valve Corporation ============//
+// Times UTF8to16 and UTF16to8 against the std::wstring_convert they replaced, on ASCII, on mostly
+// ASCII with scattered accented letters, and on CJK text, each 4 KB of UTF-8. Then times a round
+// trip on several threads at once.
+#include "vrtest.h"
+
+#include <vrcore/strtools_public.h>
+
+#include <algorithm>
+#include <codecvt>
+#include <locale>
+#include <thread>
+#include <vector>
+
+static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert;
+
+static std::wstring ReferenceUTF8to16( const std::string &in )
+{
+	try
+	{
+		return s_convert.from_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::wstring();
+	}
+}
+
+static std::string ReferenceUTF16to8( const std::wstring &in )
+{
+	try
+	{
+		return s_convert.to_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::string();
+	}
+}
+
+static std::string RepeatTo( const char *pchUnit, size_t unLength )
+{
+	std::string s;
+	while ( s.length() < unLength )
+		s += pchUnit;
+	return s;
+}
+
+static void BenchText( const char *pchName, const std::string & sUtf8, uint64_t unIterations )
+{
+	const std::wstring wsUtf16 = ReferenceUTF8to16( sUtf8 );
+	VRTEST_CHECK( !wsUtf16.empty() && UTF8to16( sUtf8 ) == wsUtf16 && UTF16to8( wsUtf16 ) == sUtf8 );
+	std::string sName = pchName;
+	size_t unTotal = 0;
+
+	double flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceUTF8to16( sUtf8 ).length();
+	VRTest_Report( ( "wstring_convert from_bytes, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += UTF8to16( sUtf8 ).length();
+	VRTest_Report( ( "UTF8to16, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	// the buffer version without the std::wstring around it
+	std::vector< wchar_t > vecWide( sUtf8.length() );
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+	{
+		size_t unOutLength = 0;
+		VRTEST_CHECK( UTF8to16Buffer( sUtf8.data(), sUtf8.length(), vecWide.data(), vecWide.size(), &unOutLength ) );
+		unTotal += unOutLength;
+	}
+	VRTest_Report( ( "UTF8to16Buffer, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += ReferenceUTF16to8( wsUtf16 ).length();
+	VRTest_Report( ( "wstring_convert to_bytes, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	flStart = VRTest_Seconds();
+	for ( uint64_t i = 0; i < unIterations; ++i )
+		unTotal += UTF16to8( wsUtf16 ).length();
+	VRTest_Report( ( "UTF16to8, " + sName ).c_str(), unIterations, VRTest_Seconds() - flStart );
+
+	VRTEST_CHECK( unTotal == unIterations * ( 3 * wsUtf16.length() + 2 * sUtf8.length() ) );
+}
+
+// The old converter isn't safe to share between threads, so each thread gets its own here,
+// which is what callers would have needed
+static void BenchThreads( const std::string & sUtf8, uint64_t unIterations )
+{
+	const uint32_t unThreads = std::max( 4u, std::thread::hardware_concurrency() );
+	std::string sThreads = std::to_string( unThreads ) + " threads";
+
+	for ( int nOld = 1; nOld >= 0; --nOld )
+	{
+		std::vector< std::thread > vecThreads;
+		double flStart = VRTest_Seconds();
+		for ( uint32_t unThread = 0; unThread < unThreads; ++unThread )
+		{
+			vecThreads.push_back( std::thread( [&sUtf8, unIterations, nOld]()
+			{
+				std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > convert;
+				for ( uint64_t i = 0; i < unIterations; ++i )
+				{
+					if ( nOld )
+						VRTEST_CHECK( convert.to_bytes( convert.from_bytes( sUtf8 ) ).length() == sUtf8.length() );
+					else
+						VRTEST_CHECK( UTF16to8( UTF8to16( sUtf8 ) ).length() == sUtf8.length() );
+				}
+			} ) );
+		}
+		for ( std::thread & thread : vecThreads )
+			thread.join();
+		VRTest_Report( ( std::string( nOld ? "wstring_convert round trip, " : "UTF8to16 + UTF16to8, " ) + sThreads ).c_str(),
+			unIterations * unThreads, VRTest_Seconds() - flStart );
+	}
+}
+
+int main( int argc, char **argv )
+{
+	double flScale = VRTest_BenchScale( argc, argv );
+	const uint64_t unIterations = VRTest_Scaled( 20000, flScale );
+	const size_t k_unTextLength = 4096;
+
+	const std::string sAscii = RepeatTo( "C:/Program Files (x86)/Steam/steamapps/common/SteamVR/drivers/lighthouse/", k_unTextLength );
+	const std::string sAccented = RepeatTo( "Paramètres de la caméra, sélectionnez le périphérique. ", k_unTextLength );
+	const std::string sCJK = RepeatTo( "\xE8\xA8\xAD\xE5\xAE\x9A\xE3\x82\x92\xE9\x96\x8B\xE3\x81\x8F", k_unTextLength );
+
+	BenchText( "ASCII", sAscii, unIterations );
+	BenchText( "accented", sAccented, unIterations );
+	BenchText( "CJK", sCJK, unIterations );
+	BenchThreads( sAccented, unIterations / 4 + 1 );
+
+	return VRTest_Result( "utfbench" );
+}
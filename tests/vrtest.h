@@ -0,0 +1,90 @@
+//========= Copyright Valve Corporation ============//
+// Shared helpers for the tests and benchmarks in this directory. Each test is its own
+// program so that the global state in openvr_api starts fresh, and it returns nonzero if
+// any check failed.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <vrcore/envvartools_public.h>
+#include <vrcore/sharedlibtools_public.h>
+#include "stubvrclient/stubvrclient.h"
+
+// atomic so that checks can be made from worker threads
+static std::atomic<int> g_nVRTestFailures( 0 );
+
+#define VRTEST_CHECK( expr ) \
+	do \
+	{ \
+		if ( !( expr ) ) \
+		{ \
+			fprintf( stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #expr ); \
+			++g_nVRTestFailures; \
+		} \
+	} while ( 0 )
+
+/** Returns the exit code for a test program and reports the result */
+inline int VRTest_Result( const char *pchTestName )
+{
+	if ( g_nVRTestFailures )
+		fprintf( stderr, "%s: %d check(s) failed\n", pchTestName, g_nVRTestFailures.load() );
+	else
+		printf( "%s: passed\n", pchTestName );
+	return g_nVRTestFailures ? 1 : 0;
+}
+
+/** Points the client library at the stub runtime built next to the tests */
+inline void VRTest_UseStubRuntime()
+{
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", STUB_VRPATH_FILE );
+}
+
+/** Returns the stub vrclient's call counters. The first call loads the stub so that it stays
+* loaded, and its counters keep counting, for the rest of the test. */
+inline StubVRClientStats_t VRTest_GetStubStats()
+{
+	static StubVRClient_GetStatsFn s_pfnGetStats = nullptr;
+	if ( !s_pfnGetStats )
+	{
+		SharedLibHandle hStub = SharedLib_Load( STUB_VRCLIENT_PATH );
+		if ( hStub )
+			s_pfnGetStats = reinterpret_cast< StubVRClient_GetStatsFn >( SharedLib_GetFunction( hStub, "StubVRClient_GetStats" ) );
+	}
+
+	StubVRClientStats_t stats = {};
+	if ( s_pfnGetStats )
+		s_pfnGetStats( &stats );
+	return stats;
+}
+
+inline double VRTest_Seconds()
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/** Benchmarks take an optional scale for their iteration counts; ctest runs them at a
+* small scale so they don't rot. */
+inline double VRTest_BenchScale( int argc, char **argv )
+{
+	double flScale = argc > 1 ? atof( argv[1] ) : 1.0;
+	return flScale > 0 ? flScale : 1.0;
+}
+
+inline uint64_t VRTest_Scaled( uint64_t unIterations, double flScale )
+{
+	uint64_t unScaled = (uint64_t)( unIterations * flScale );
+	return unScaled ? unScaled : 1;
+}
+
+/** Prints one benchmark result line */
+inline void VRTest_Report( const char *pchName, uint64_t unIterations, double flSeconds )
+{
+	printf( "%-48s %10llu ops %10.1f ms %12.3f us/op\n", pchName, (unsigned long long)unIterations,
+		flSeconds * 1000.0, unIterations ? flSeconds * 1e6 / unIterations : 0.0 );
+	fflush( stdout );
+}